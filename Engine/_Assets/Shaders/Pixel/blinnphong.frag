@@ -2,6 +2,7 @@
 #include "Shaders/Uniforms/material.glsl" //! #include "../Uniforms/material.glsl"
 #include "Shaders/Uniforms/light.glsl" //! #include "../Uniforms/light.glsl"
 #include "Shaders/Uniforms/camera.glsl" //! #include "../Uniforms/camera.glsl"
+#include "Shaders/Uniforms/clusters.glsl" //! #include "../Uniforms/clusters.glsl"
 
 out vec4 FragColor;
 
@@ -11,7 +12,18 @@ uniform sampler2D albedoSampler0;
 uniform sampler2D depthSampler0;
 uniform sampler2DArray shadowArraySampler0;
 
-// TODO: Consider SSBOs for a varying number of lights
+void ShadeLight(Light l, vec3 norm, vec3 viewDir, vec3 albedo, inout vec3 diffuse, inout vec3 specular) {
+  vec3 lightDir;
+  float attenuation = LightAttenuation(l, vout.FragWorldPos.xyz, lightDir);
+  if (attenuation <= 0.0) return;
+
+  vec3 halfVector = normalize(lightDir + viewDir);
+  float diff = max(0.0, dot(norm, lightDir));
+  float spec = pow(max(0.0, dot(norm, halfVector)), material.shininess);
+
+  diffuse += l.color.rgb * material.diffuse * albedo * diff * attenuation;
+  specular += l.color.rgb * material.specular * spec * attenuation;
+}
 
 void main() {
   vec3 diffuse = vec3(0.0);
@@ -35,37 +47,27 @@ void main() {
   int cascadeIndex = GetCascadeIndex(vout.FragViewPos.xyz, shadowFarPlanes);
   float shadow = 0.0;
 
+  // The main light is the only one with shadows
   if (light.isEnabled) {
-      vec3 lightDir = light.lightType == LIGHT_TYPE_DIRECTIONAL ? normalize(light.direction.xyz) : normalize(light.position.xyz - vout.FragWorldPos.xyz);
-      vec3 halfVector = normalize(lightDir + viewDir);
-      float attenunation = 1.0;
-
-      if (light.lightType != LIGHT_TYPE_DIRECTIONAL) {
-          float lightDistance = length(lightDir);
-          lightDir = lightDir / lightDistance;
-
-          attenunation = 1.0 / (light.constantAttenuation
-                              + light.linearAttenuation * lightDistance
-                              + light.quadraticAttenuation * lightDistance * lightDistance);
-
-          if (light.lightType == LIGHT_TYPE_SPOT) {
-            float spotCos = dot(lightDir, -light.coneDirection.xyz);
-            if (spotCos < light.spotCutoff) attenunation = 0.0;
-            else attenunation *= pow(spotCos, light.spotExponent);
-          }
-      }
-
-      float diff = max(0.0, dot(norm, lightDir));
-      float spec = pow(max(0.0, dot(norm, halfVector)), material.shininess);
-
+      vec3 lightDir;
+      LightAttenuation(light, vout.FragWorldPos.xyz, lightDir);
       shadow += PCFShadow(vout, cascadeIndex, lightDir, shadowArraySampler0);
 
       ambient += material.ambient * albd.rgb;
-      diffuse += light.color.rgb * material.diffuse * albd.rgb * diff * attenunation;
-      specular += light.color.rgb * material.specular * spec * attenunation;
+      ShadeLight(light, norm, viewDir, albd.rgb, diffuse, specular);
+  }
+
+  vec3 localDiffuse = vec3(0.0);
+  vec3 localSpecular = vec3(0.0);
+  for (uint i = 0; i < GlobalLightCount(); i++) {
+      ShadeLight(lights[i], norm, viewDir, albd.rgb, localDiffuse, localSpecular);
+  }
+  uvec2 cluster = LightCluster(vout.FragViewPos.xyz);
+  for (uint i = 0; i < cluster.y; i++) {
+      ShadeLight(lights[lightIndices[cluster.x + i]], norm, viewDir, albd.rgb, localDiffuse, localSpecular);
   }
 
-  vec3 color = (ambient + (1.0 - shadow) * (diffuse + specular)) + material.emission;
+  vec3 color = (ambient + (1.0 - shadow) * (diffuse + specular)) + localDiffuse + localSpecular + material.emission;
 
   FragColor = vec4(color, albd.a);
 }
@@ -1,8 +1,9 @@
 #version 450 core
-#include "Shaders/Uniforms/ui.glsl" //! #include "../Uniforms/ui.glsl"
+
+in vec4 lineColor;
 
 out vec4 FragColor;
 
 void main() {
-  FragColor = color;
+  FragColor = lineColor;
 }
@@ -0,0 +1,23 @@
+#version 450 core
+
+uniform sampler2D depthSampler0;
+uniform vec2 targetSize;
+
+out float farthest;
+
+void main()
+{
+    // Take the farthest depth of every source texel this cell overlaps. Cells that share a texel
+    // along their edges both include it, which keeps the result conservative for any size ratio.
+    vec2 sourceSize = vec2(textureSize(depthSampler0, 0));
+    vec2 cell = floor(gl_FragCoord.xy);
+    ivec2 begin = ivec2(floor(cell * sourceSize / targetSize));
+    ivec2 end = min(ivec2(ceil((cell + 1.0) * sourceSize / targetSize)), ivec2(sourceSize));
+
+    farthest = 0.0;
+    for (int y = begin.y; y < end.y; y++) {
+        for (int x = begin.x; x < end.x; x++) {
+            farthest = max(farthest, texelFetch(depthSampler0, ivec2(x, y), 0).r);
+        }
+    }
+}
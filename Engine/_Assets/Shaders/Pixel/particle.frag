@@ -0,0 +1,23 @@
+#include "Shaders/common.glsl" //! #include "../common.glsl"
+#include "Shaders/Uniforms/material.glsl" //! #include "../Uniforms/material.glsl"
+
+out vec4 FragColor;
+
+in VertexOutput vout;
+in vec4 ParticleColor;
+
+uniform sampler2D albedoSampler0;
+
+void main() {
+  vec4 albd = material.albedo * ParticleColor;
+  if (isTextured)
+  {
+    albd *= texture(albedoSampler0, vout.FragUV);
+  }
+  if (albd.a < 0.01)
+  {
+    discard;
+  }
+
+  FragColor = albd;
+}
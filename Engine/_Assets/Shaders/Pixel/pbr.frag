@@ -2,6 +2,7 @@
 #include "Shaders/Uniforms/material.glsl" //! #include "../Uniforms/material.glsl"
 #include "Shaders/Uniforms/light.glsl" //! #include "../Uniforms/light.glsl"
 #include "Shaders/Uniforms/camera.glsl" //! #include "../Uniforms/camera.glsl"
+#include "Shaders/Uniforms/clusters.glsl" //! #include "../Uniforms/clusters.glsl"
 
 layout (location = 0) out vec4 FragColor;
 layout (location = 1) out vec4 FragDepth;
@@ -22,7 +23,33 @@ uniform sampler2D aoSampler0;
 uniform sampler2D heightSampler0;
 uniform float heightScale = 1.0;
 
-// TODO: Consider SSBOs for a varying number of lights
+vec3 ShadeLight(Light l, vec3 N, vec3 V, vec3 F0, vec3 albedo, float metallic, float roughness) {
+  vec3 L = l.lightType != LIGHT_TYPE_DIRECTIONAL ? normalize(l.position.xyz - vout.FragWorldPos.xyz) : normalize(l.direction.xyz);
+  vec3 H = normalize(V + L);
+  vec3 radiance = l.color.rgb;
+
+  if (l.lightType != LIGHT_TYPE_DIRECTIONAL) {
+    float dist = length(l.position.xyz - vout.FragWorldPos.xyz);
+    float attenuation = 1.0 / max(dist * dist, 0.001);
+    radiance = l.color.rgb * attenuation;
+  }
+
+  float NDF = DistributionGGX(N, H, roughness);
+  float G = GeometrySmith(N, V, L, roughness);
+  vec3 F = FresnelSchlick(max(dot(H, V), 0.0), F0);
+
+  vec3 numerator = NDF * G * F;
+  float denominator = 4.0 * max(dot(N, -V), 0.0) * max(dot(N, L), 0.0) + 0.001;
+  vec3 specular = numerator / denominator;
+
+  vec3 kS = F;
+  vec3 kD = vec3(1.0) - kS;
+  kD *= 1.0 - metallic;
+
+  float NdotL = max(dot(N, L), 0.0);
+
+  return (kD * albedo / PI + specular) * radiance * NdotL;
+}
 
 void main() {
   PBRMaterial mat = pbrMaterial;
@@ -49,35 +76,19 @@ void main() {
   vec3 F0 = vec3(0.04);
   F0 = mix(F0, vec3(fragAlbedo), fragMetallic);
 
-  vec3 Lo = vec3(0.0); int contributingLights = 0;
+  // The main light is the only one with shadows
+  vec3 Lo = vec3(0.0);
   if (light.isEnabled) {
-    ++contributingLights;
-
-    vec3 L = light.lightType != LIGHT_TYPE_DIRECTIONAL ? normalize(light.position.xyz - vout.FragWorldPos.xyz) : normalize(light.direction.xyz);
-    vec3 H = normalize(V + L);
-    vec3 radiance = light.color.rgb;
-
-    if (light.lightType != LIGHT_TYPE_DIRECTIONAL) {
-    float dist = length(light.position.xyz - vout.FragWorldPos.xyz);
-    float attenuation = 1.0 / max(dist * dist, 0.001);
-    radiance = light.color.rgb * attenuation;
-    }
-
-    float NDF = DistributionGGX(N, H, fragRoughness);
-    float G = GeometrySmith(N, V, L, fragRoughness);
-    vec3 F = FresnelSchlick(max(dot(H, V), 0.0), F0);
-
-    vec3 numerator = NDF * G * F;
-    float denominator = 4.0 * max(dot(N, -V), 0.0) * max(dot(N, L), 0.0) + 0.001;
-    vec3 specular = numerator / denominator;
-
-    vec3 kS = F;
-    vec3 kD = vec3(1.0) - kS;
-    kD *= 1.0 - fragMetallic;
-
-    float NdotL = max(dot(N, L), 0.0);
+    Lo += ShadeLight(light, N, V, F0, vec3(fragAlbedo), fragMetallic, fragRoughness);
+  }
 
-    Lo += (kD * vec3(fragAlbedo) / PI + specular) * radiance * NdotL;
+  vec3 localLo = vec3(0.0);
+  for (uint i = 0; i < GlobalLightCount(); i++) {
+    localLo += ShadeLight(lights[i], N, V, F0, vec3(fragAlbedo), fragMetallic, fragRoughness);
+  }
+  uvec2 cluster = LightCluster(vout.FragViewPos.xyz);
+  for (uint i = 0; i < cluster.y; i++) {
+    localLo += ShadeLight(lights[lightIndices[cluster.x + i]], N, V, F0, vec3(fragAlbedo), fragMetallic, fragRoughness);
   }
 
   vec3 F = FresnelSchlickRoughness(max(dot(N, V), 0.0), F0, fragRoughness);
@@ -96,7 +107,7 @@ void main() {
 
   vec3 ambient = (kD * diffuse + specular) * fragAO;
 
-  vec3 color = ambient + (1.0 - shadow) * Lo;
+  vec3 color = ambient + (1.0 - shadow) * Lo + localLo;
 
   color = color / (color + vec3(1.0));
   color = pow(color, vec3(1.0/2.2));
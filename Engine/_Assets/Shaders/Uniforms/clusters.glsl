@@ -0,0 +1,56 @@
+//? #version 450 core
+//? #include "light.glsl"
+//? #include "camera.glsl"
+
+layout (std430, binding = 1) readonly buffer LightList
+{
+    Light lights[];
+};
+
+layout (std430, binding = 2) readonly buffer LightClusters
+{
+    vec4 sliceScale;
+    uvec4 clusterDimensions;
+    uvec2 clusters[];
+};
+
+layout (std430, binding = 3) readonly buffer LightIndices
+{
+    uint lightIndices[];
+};
+
+// The lights at the front of the list have no finite range and reach every fragment
+uint GlobalLightCount() {
+    return clusterDimensions.w;
+}
+
+// Returns the offset into lightIndices and the number of lights of the cluster containing a view space position
+uvec2 LightCluster(vec3 viewPos) {
+    vec4 clip = P * vec4(viewPos, 1.0);
+    vec2 ndc = clip.xy / clip.w;
+    vec2 tiles = vec2(clusterDimensions.xy);
+    uvec2 tile = uvec2(clamp(floor((ndc * 0.5 + 0.5) * tiles), vec2(0.0), tiles - 1.0));
+    uint slice = uint(clamp(floor(log(max(-viewPos.z, 0.0001)) * sliceScale.x + sliceScale.y), 0.0, float(clusterDimensions.z) - 1.0));
+    return clusters[tile.x + clusterDimensions.x * (tile.y + clusterDimensions.y * slice)];
+}
+
+// Returns the attenuation of a light at a world position along with the direction towards it
+float LightAttenuation(Light l, vec3 worldPos, out vec3 lightDir) {
+    if (l.lightType == LIGHT_TYPE_DIRECTIONAL) {
+        lightDir = normalize(l.direction.xyz);
+        return 1.0;
+    }
+
+    vec3 toLight = l.position.xyz - worldPos;
+    float lightDistance = length(toLight);
+    lightDir = toLight / max(lightDistance, 0.0001);
+
+    float falloff = l.constantAttenuation + l.linearAttenuation * lightDistance + l.quadraticAttenuation * lightDistance * lightDistance;
+    float attenuation = falloff > 0.0 ? 1.0 / falloff : 1.0;
+
+    if (l.lightType == LIGHT_TYPE_SPOT) {
+        float spotCos = dot(lightDir, -l.coneDirection.xyz);
+        attenuation = spotCos < l.spotCutoff ? 0.0 : attenuation * pow(spotCos, l.spotExponent);
+    }
+    return attenuation;
+}
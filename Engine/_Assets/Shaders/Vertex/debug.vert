@@ -2,8 +2,12 @@
 #include "Shaders/Uniforms/camera.glsl" //! #include "../Uniforms/camera.glsl"
 
 layout (location = 0) in vec3 position;
+layout (location = 1) in vec4 color;
+
+out vec4 lineColor;
 
 void main()
 {
+    lineColor = color;
     gl_Position = ViewProjection * vec4(position, 1.0);
 }
@@ -0,0 +1,8 @@
+#version 450 core
+
+void main()
+{
+    // A single triangle that covers the whole viewport, so no vertex data is needed
+    vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
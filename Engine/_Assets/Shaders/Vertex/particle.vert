@@ -0,0 +1,26 @@
+#include "Shaders/common.glsl" //! #include "../common.glsl"
+#include "Shaders/Uniforms/camera.glsl" //! #include "../Uniforms/camera.glsl"
+
+layout (location = 0) in vec3 position;
+layout (location = 2) in vec2 texCoords;
+layout (location = 7) in mat4 instanceM;
+
+out VertexOutput vout;
+out vec4 ParticleColor;
+
+void main()
+{
+    // Particles pack their center and size into the first column of the
+    // instance matrix and their color into the second
+    vec3 center = instanceM[0].xyz;
+    float size = instanceM[0].w;
+    vec3 cameraRight = vec3(V[0][0], V[1][0], V[2][0]);
+    vec3 cameraUp = vec3(V[0][1], V[1][1], V[2][1]);
+
+    vout.FragLocalPos = vec4(position, 1.0);
+    vout.FragWorldPos = vec4(center + (cameraRight * position.x - cameraUp * position.z) * size, 1.0);
+    vout.FragViewPos = V * vout.FragWorldPos;
+    vout.FragUV = texCoords;
+    ParticleColor = instanceM[1];
+    gl_Position = ViewProjection * vout.FragWorldPos;
+}
@@ -1,4 +1,4 @@
-const int MAX_LOCAL_LIGHTS = 6;
+const int MAX_LOCAL_LIGHTS = 1024;
 const int MAX_BONES_PER_MODEL = 50;
 const int MAX_BONES_PER_VERTEX = 4;
 const int NUM_SHADOW_CASCADES = 4;	// TODO: This is fixed but it might be worthwhile to make it adaptable to the scene
@@ -33,6 +33,8 @@
 #include "ZEditorTool.hpp"
 
 // Forward Declarations
+class ZUIText;
+class ZUIButton;
 
 // Definitions
 class ZPerformanceTool : public ZEditorTool {
@@ -42,6 +44,18 @@ public:
 	ZPerformanceTool(const ZUITheme& theme = ZUITheme())
         : ZEditorTool("Performance", theme) {}
 
+	void Initialize(const std::shared_ptr<ZScene>& scene) override;
+
 	void Update() override;
 
+protected:
+
+	std::shared_ptr<ZUIText> gpuFrameTimeText_ = nullptr;
+	std::shared_ptr<ZUIButton> captureButton_ = nullptr;
+	std::shared_ptr<ZUIText> captureText_ = nullptr;
+	std::string tracePath_;
+	std::unordered_map<std::string, std::shared_ptr<ZUIText>> gpuTimingTexts_;
+
+	std::shared_ptr<ZUIText> CreateTimingField(const std::string& label);
+
 };
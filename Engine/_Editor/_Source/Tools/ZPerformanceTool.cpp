@@ -28,7 +28,91 @@
  */
 
 #include "ZPerformanceTool.hpp"
+#include "ZUIPanel.hpp"
+#include "ZUIVerticalLayout.hpp"
+#include "ZUILabeledElement.hpp"
+#include "ZUIText.hpp"
+#include "ZUIButton.hpp"
+#include "ZScene.hpp"
+#include <iomanip>
+
+static std::string FormatMilliseconds(double milliseconds)
+{
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(3) << milliseconds << " ms";
+	return stream.str();
+}
+
+void ZPerformanceTool::Initialize(const std::shared_ptr<ZScene>& scene) {
+	ZEditorTool::Initialize(scene);
+
+	ZUILayoutOptions layoutOptions;
+	layoutOptions.itemSpacing = 5.f;
+	layoutOptions.dimensions = container_->CalculatedRect();
+	container_->SetLayout(std::make_shared<ZUIVerticalLayout>(layoutOptions));
+
+	tracePath_ = scene->GameConfig().profiler.tracePath;
+
+	// Records profiler zones on every thread until clicked again, then exports them as a Chrome trace
+	ZUIElementOptions buttonOptions;
+	buttonOptions.positioning = ZPositioning::Relative;
+	buttonOptions.scaling = ZPositioning::Relative;
+	buttonOptions.rect = ZRect(0.f, 0.f, 1.f, 1.f);
+	buttonOptions.maxSize = glm::vec2(0.f, 25.f);
+	buttonOptions.color = theme_.buttonColor;
+	captureButton_ = ZUIButton::Create(buttonOptions, scene);
+
+	ZUIElementOptions textOptions;
+	textOptions.positioning = ZPositioning::Relative;
+	textOptions.scaling = ZPositioning::Relative;
+	textOptions.rect = ZRect(0.f, 0.f, 1.f, 1.f);
+	textOptions.color = glm::vec4(1.f);
+	captureText_ = ZUIText::Create(textOptions, scene);
+	captureText_->SetFontScale(14.f);
+	captureText_->SetText("Start Trace Capture");
+	captureButton_->AddChild(captureText_);
+	container_->AddChild(captureButton_);
+
+	gpuFrameTimeText_ = CreateTimingField("GPU Frame: ");
+}
 
 void ZPerformanceTool::Update() {
+	if (container_->Hidden()) return;
+
+	if (captureButton_->Clicked()) {
+		if (ZFrameProfiler::CaptureEnabled()) {
+			ZPR_CAPTURE_END(tracePath_)
+			captureText_->SetText("Start Trace Capture");
+		}
+		else {
+			ZPR_CAPTURE_BEGIN()
+			captureText_->SetText(ZFrameProfiler::CaptureEnabled() ? "Stop Trace Capture" : "Tracing needs a profiling build");
+		}
+	}
+
+	// GPU timings arrive a few frames late, one entry per render pass plus nested scopes such as shadow cascades
+	auto timings = ZFrameProfiler::GPUTimings();
+	for (const auto& timing : timings) {
+		std::string key = std::string(timing.depth * 4, ' ') + timing.name;
+		auto it = gpuTimingTexts_.find(key);
+		if (it == gpuTimingTexts_.end()) {
+			it = gpuTimingTexts_.emplace(key, CreateTimingField(key + ": ")).first;
+		}
+		it->second->SetText(FormatMilliseconds(timing.milliseconds));
+	}
+	gpuFrameTimeText_->SetText(FormatMilliseconds(ZFrameProfiler::GPUFrameTime()));
+}
+
+std::shared_ptr<ZUIText> ZPerformanceTool::CreateTimingField(const std::string& label) {
+	ZUIElementOptions textOptions;
+	textOptions.positioning = ZPositioning::Relative;
+	textOptions.scaling = ZPositioning::Relative;
+	textOptions.rect = ZRect(0.f, 0.f, 1.f, 1.f);
+	textOptions.maxSize = glm::vec2(0.f, 25.f);
+	textOptions.color = glm::vec4(1.f);
 
+	auto text = ZUIText::Create(textOptions, container_->Scene());
+	text->SetFontScale(14.f);
+	container_->AddChild(ZUILabeledElement::Create(label, text));
+	return text;
 }
@@ -50,6 +50,7 @@
 #include "ZInspectorTool.hpp"
 #include "ZHierarchyTool.hpp"
 #include "ZFrameStatsDisplay.hpp"
+#include "ZPerformanceTool.hpp"
 
 void ZEditorScene::Initialize() {
     ZServices::EventAgent()->Subscribe(this, &ZEditorScene::HandleResourceLoaded);
@@ -221,6 +222,7 @@ void ZEditorScene::SetupInitialTools() {
     AddTool(std::make_shared<ZFrameStatsDisplay>(config_.theme), centerPanel_);
     AddTool(std::make_shared<ZProjectTool>(config_.theme), bottomPanel_);
     AddTool(std::make_shared<ZConsoleTool>(config_.theme), bottomPanel_);
+    AddTool(std::make_shared<ZPerformanceTool>(config_.theme), bottomPanel_);
     AddTool(std::make_shared<ZInspectorTool>(config_.theme), leftPanel_);
     AddTool(std::make_shared<ZHierarchyTool>(config_.theme), rightPanel_);
 }
@@ -298,6 +300,8 @@ void ZEditorScene::LoadObjectTemplates(std::shared_ptr<ZOFTree> objectTree) {
 }
 
 void ZEditorScene::HandleResourceLoaded(const std::shared_ptr<ZResourceLoadedEvent>& event) {
+    if (!event->Handle()) return;
+
     ZResource& resource = event->Handle()->Resource();
 
     if (resource.type == ZResourceType::ZOF && resource.name == EDITOR_CONFIG_PATH) {
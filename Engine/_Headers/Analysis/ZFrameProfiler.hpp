@@ -37,6 +37,70 @@ struct ZFrameStats
     double frameTime = 0;
 };
 
+struct ZGPUTiming
+{
+    std::string name;
+    double milliseconds = 0.0;
+    unsigned int depth = 0;
+};
+
+// A completed profile zone. Zone names are not copied, so they must outlive the profiler (string literals
+// or function names).
+struct ZProfileEvent
+{
+    const char* name = nullptr;
+    int64_t start = 0;
+    int64_t end = 0;
+    uint32_t depth = 0;
+};
+
+// Ring of completed zones owned by a single thread. Only the owning thread pushes and only the exporter
+// drains, so neither side needs a lock. Zones that don't fit are dropped and counted.
+class ZProfileThreadBuffer
+{
+
+public:
+
+    static constexpr unsigned int capacity = 1 << 15;
+
+    ZProfileThreadBuffer(uint32_t id) : threadId(id) { }
+
+    void Push(const ZProfileEvent& event)
+    {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) >= capacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        events_[head & (capacity - 1)] = event;
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    template<typename Visitor>
+    void Drain(Visitor&& visitor)
+    {
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        uint64_t head = head_.load(std::memory_order_acquire);
+        for (; tail < head; tail++) {
+            visitor(events_[tail & (capacity - 1)]);
+        }
+        tail_.store(tail, std::memory_order_release);
+    }
+
+    uint64_t Dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    const uint32_t threadId;
+    uint32_t depth = 0;
+
+private:
+
+    std::array<ZProfileEvent, capacity> events_;
+    std::atomic<uint64_t> head_{ 0 };
+    std::atomic<uint64_t> tail_{ 0 };
+    std::atomic<uint64_t> dropped_{ 0 };
+
+};
+
 struct ZFrameProfileSession
 {
     std::string name;
@@ -67,6 +131,27 @@ public:
 
     static void EndSession();
 
+    static void EnableCapture(bool enabled = true);
+
+    static bool CaptureEnabled() { return captureEnabled_.load(std::memory_order_relaxed); }
+
+    static void SetThreadName(const std::string& name);
+
+    static ZProfileThreadBuffer* ThreadBuffer();
+
+    static int64_t Timestamp()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static bool ExportChromeTrace(const std::string& path);
+
+    static void CollectGPUTimings(const std::vector<ZGPUTiming>& timings);
+
+    static std::vector<ZGPUTiming> GPUTimings();
+
+    static double GPUFrameTime();
+
 private:
 
     static std::array<ZFrameProfileSession, maxProfileSessionsBucketSize> sessions_;
@@ -74,4 +159,46 @@ private:
     static std::unordered_map<std::string, unsigned int> sessionIndices_;
     static std::atomic_uint currentBucketIndex_;
 
+    static std::atomic_bool captureEnabled_;
+    static std::mutex threadBuffersMutex_;
+    static std::vector<std::unique_ptr<ZProfileThreadBuffer>> threadBuffers_;
+    static std::unordered_map<uint32_t, std::string> threadNames_;
+
+    static std::mutex gpuTimingsMutex_;
+    static std::vector<ZGPUTiming> gpuTimings_;
+
+};
+
+// Records the lifetime of a scope as a nested zone on the calling thread. When capture is disabled
+// a zone costs a single relaxed atomic load.
+class ZProfileZone
+{
+
+public:
+
+    ZProfileZone(const char* name) : name_(name)
+    {
+        if (!ZFrameProfiler::CaptureEnabled()) return;
+        buffer_ = ZFrameProfiler::ThreadBuffer();
+        depth_ = buffer_->depth++;
+        start_ = ZFrameProfiler::Timestamp();
+    }
+
+    ~ZProfileZone()
+    {
+        if (!buffer_) return;
+        buffer_->Push({ name_, start_, ZFrameProfiler::Timestamp(), depth_ });
+        buffer_->depth = depth_;
+    }
+
+    ZProfileZone(const ZProfileZone&) = delete;
+    ZProfileZone& operator=(const ZProfileZone&) = delete;
+
+private:
+
+    const char* name_;
+    ZProfileThreadBuffer* buffer_ = nullptr;
+    int64_t start_ = 0;
+    uint32_t depth_ = 0;
+
 };
\ No newline at end of file
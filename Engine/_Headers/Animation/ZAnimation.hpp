@@ -58,6 +58,30 @@ struct ZAnimation
     std::vector<std::shared_ptr<ZJointAnimation>> channels;
 };
 
+struct ZCompiledAnimation
+{
+    double ticksPerSecond;
+    double duration;
+    // Indexed by flattened joint index; null where the animation does not drive the joint
+    std::vector<std::shared_ptr<ZJointAnimation>> channels;
+};
+
+struct ZAnimationCursor
+{
+    unsigned int scaling = 0;
+    unsigned int rotation = 0;
+    unsigned int position = 0;
+};
+
+// Playback state for one animator. Models are shared between game objects, so the keyframe cursors
+// and joint scratch live with whoever is playing the clip rather than on the model.
+struct ZAnimationClipState
+{
+    std::string animation;
+    std::vector<ZAnimationCursor> cursors;
+    std::vector<glm::mat4> jointTransforms;
+};
+
 struct ZAnimationClip
 {
     std::string name;
@@ -66,5 +90,6 @@ struct ZAnimationClip
     double currentTime;
     std::shared_ptr<ZModel> model;
     ZAnimationState state;
+    ZAnimationClipState clipState;
 };
 
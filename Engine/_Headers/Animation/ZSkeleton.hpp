@@ -61,6 +61,21 @@ struct ZBone
     }
 };
 
+// A joint in a skeleton flattened so that every parent precedes its children
+struct ZSkeletonJoint
+{
+    int parent = -1;
+    int bone = -1;
+    glm::mat4 transform;
+    glm::mat4 offset;
+
+    ZSkeletonJoint()
+    {
+        transform = glm::mat4(1.f);
+        offset = glm::mat4(1.f);
+    }
+};
+
 struct ZSkeleton
 {
     std::shared_ptr<ZJoint> rootJoint;
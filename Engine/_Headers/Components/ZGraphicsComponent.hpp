@@ -54,19 +54,28 @@ public:
     void EnableAABB() { hasAABB_ = true; }
     void DisableAABB() { hasAABB_ = false; }
 
+    bool IsShadowCaster() const { return isShadowCaster_; }
     void EnableShadowCasting() { isShadowCaster_ = true; }
     void DisableShadowCasting() { isShadowCaster_ = false; }
 
     void EnableDepthInfo() { hasDepthInfo_ = true; }
     void DisableDepthInfo() { hasDepthInfo_ = false; }
 
+    bool BVHTraversable() const { return isBoundsTraversable_; }
     void EnableBVHTraversal() { isBoundsTraversable_ = true; }
     void DisableBVHTraversal() { isBoundsTraversable_ = false; }
 
     void EnableLightingInfo() { hasLightingInfo_ = true; }
     void DisableLightingInfo() { hasLightingInfo_ = false; }
 
-    bool IsVisible(ZFrustum frustrum);
+    bool IsVisible(const ZFrustum& frustum) const;
+
+    // Results of the scene culling stage for the current frame
+    bool InView() const { return inView_; }
+    uint8_t ShadowCascades() const { return shadowCascades_; }
+    void SetInView(bool inView) { inView_ = inView; }
+    void SetShadowCascades(uint8_t cascades) { shadowCascades_ = cascades; }
+    void AddShadowCascade(unsigned int cascade) { shadowCascades_ |= static_cast<uint8_t>(1 << cascade); }
 
     void Transform(const glm::mat4& mat);
 
@@ -95,6 +104,8 @@ protected:
     bool isShadowCaster_ = true;
     bool hasDepthInfo_ = true;
     bool hasLightingInfo_ = true;
+    bool inView_ = true;
+    uint8_t shadowCascades_ = 0xff;
 
     ZAABBox bounds_;
 
@@ -74,5 +74,6 @@ protected:
 
     std::shared_ptr<ZRigidBody> body_;
     bool inUniverse_ = false;
+    glm::mat4 lastTriggerMatrix_{ 0.f };
 
 };
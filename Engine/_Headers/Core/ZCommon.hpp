@@ -45,6 +45,8 @@
 #include <array>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <variant>
 #include <map>
 #include <unordered_map>
 #include <list>
@@ -60,6 +62,11 @@
 #include <thread>
 #include <mutex>
 #include <filesystem>
+#include <future>
+#include <atomic>
+#include <deque>
+#include <condition_variable>
+#include <random>
 #include "ZIDSequence.hpp"
 #include "ZStringHelpers.hpp"
 #include "ZFrameProfiler.hpp"
@@ -67,7 +74,7 @@
 constexpr unsigned int BONES_PER_VERTEX = 4;
 constexpr unsigned int BONES_PER_MODEL = 50;
 constexpr unsigned int MAX_MATERIALS_PER_OBJECT = 6;
-constexpr unsigned int MAX_LOCAL_LIGHTS = 4;
+constexpr unsigned int MAX_LOCAL_LIGHTS = 1024;
 constexpr unsigned int NUM_SHADOW_CASCADES = 4;
 constexpr unsigned int MAX_TEXTURE_SLOTS = 16;
 constexpr unsigned int MAX_UBO_SLOTS = 16;
@@ -447,6 +454,7 @@ class ZTexture;
 struct ZCursor;
 struct ZVertex3D;
 struct ZVertex2D;
+struct ZDebugVertex;
 class ZColliderComponent;
 class ZScriptComponent;
 class ZUniformBuffer;
@@ -472,6 +480,7 @@ using ZUIElementList = std::vector<std::shared_ptr<ZUIElement>>;
 using ZProcessList = std::list<std::shared_ptr<ZProcess>>;
 using ZCollisionPair = std::pair<ZGameObject*, ZGameObject*>;
 using ZCollisionPairs = std::set<ZCollisionPair>;
+using ZCollisionPairList = std::vector<ZCollisionPair>;
 using ZAnimationMap = std::map<std::string, std::shared_ptr<ZAnimation>>;
 using ZBoneMap = std::map<std::string, unsigned int>;
 using ZIDMap = std::unordered_map<std::string, unsigned int>;
@@ -483,6 +492,7 @@ using ZTimedUpdateCallback = std::function<void(float)>;
 using ZTypeIdentifier = unsigned long;
 using ZVertex3DList = std::vector<ZVertex3D>;
 using ZVertex2DList = std::vector<ZVertex2D>;
+using ZDebugVertexList = std::vector<ZDebugVertex>;
 
 enum ZPriority
 {
@@ -755,6 +765,16 @@ struct ZVertex2D
     }
 };
 
+struct ZDebugVertex
+{
+    glm::vec3 position;
+    glm::vec4 color;
+
+    ZDebugVertex(const glm::vec3& position = glm::vec3(0.f), const glm::vec4& color = glm::vec4(1.f))
+        : position(position), color(color)
+    {}
+};
+
 struct ZCharacter
 {
     glm::vec2 advance;
@@ -804,12 +824,38 @@ struct ZGraphicsOptions
     bool drawCameraDebug{ false };
     bool drawAABBDebug{ false };
     bool drawGrid{ false };
+    // Directory where linked program binaries are persisted between runs. Leave empty to always compile from source.
+    std::string shaderCachePath{ ENGINE_ROOT "/_ShaderCache" };
+    // Skips objects hidden behind the depth of a previous frame. Results lag the camera by a few frames.
+    bool occlusionCulling{ true };
+};
+
+struct ZPhysicsOptions
+{
+    // Steps the world with Bullet's multithreaded world and solver pool on the job system. Requires Bullet
+    // libraries built with BT_THREADSAFE and the BULLET_THREADSAFE build option; ignored with a warning otherwise.
+    bool multithreaded{ false };
+    // Upper bound on the threads a physics step can occupy. Zero uses every job system worker.
+    unsigned int maxThreads{ 0 };
+    // Draws bodies blended between the last two fixed steps rather than extrapolated past the latest one.
+    // Motion is smooth at any frame rate, at the cost of one fixed step of latency.
+    bool interpolate{ false };
+};
+
+struct ZProfilerOptions
+{
+    // Number of frames to record profiler zones for from the start of the game loop, after which they are
+    // exported to tracePath as a Chrome trace. Zero leaves capture off. Only has an effect in builds with zones.
+    unsigned int captureFrames{ 0 };
+    std::string tracePath{ ENGINE_ROOT "/zenith_trace.json" };
 };
 
 struct ZGameOptions
 {
     ZDomainOptions domain;
     ZGraphicsOptions graphics;
+    ZPhysicsOptions physics;
+    ZProfilerOptions profiler;
 };
 
 struct ZInstancedDataOptions
@@ -832,6 +878,11 @@ struct ZVertex2DDataOptions
     ZInstancedDataOptions instanced;
 };
 
+struct ZDebugVertexDataOptions
+{
+    ZDebugVertexList vertices;
+};
+
 struct ZGameSystems
 {
     std::shared_ptr<ZDomain> domain{ nullptr };
@@ -996,7 +1047,7 @@ struct is_multiple_components_supported<ZScriptComponent> {
 #define ZPR_SESSION_STATS(name) ZFrameProfiler::GetSessionStats(name)
 #define ZPR_CURRENT_SESSION ZFrameProfiler::CurrentSession()
 #else
-#define ZPR_SESSION_BEGIN() ((void)0);
+#define ZPR_SESSION_BEGIN(name) ((void)0);
 #define ZPR_SESSION_END() ((void)0);
 #define ZPR_SESSION_COLLECT_VERTICES(vertices) ((void)0);
 #define ZPR_SESSION_COLLECT_DRAWS(draws) ((void)0);
@@ -1004,4 +1055,22 @@ struct is_multiple_components_supported<ZScriptComponent> {
 #define ZPR_SESSION(name) ((void)0)
 #define ZPR_SESSION_STATS(name) ((void)0)
 #define ZPR_CURRENT_SESSION ((void)0)
+#endif
+
+// Scoped zones are available in development builds and in release builds configured with PROFILE_BUILD,
+// and compile away entirely otherwise
+#if defined DEV_BUILD || defined PROFILE_BUILD
+#define ZPR_CONCAT_IMPL(a, b) a##b
+#define ZPR_CONCAT(a, b) ZPR_CONCAT_IMPL(a, b)
+#define ZPR_ZONE(name) ZProfileZone ZPR_CONCAT(profileZone, __LINE__)(name);
+#define ZPR_FUNCTION_ZONE() ZPR_ZONE(__FUNCTION__)
+#define ZPR_THREAD_NAME(name) ZFrameProfiler::SetThreadName(name);
+#define ZPR_CAPTURE_BEGIN() ZFrameProfiler::EnableCapture(true);
+#define ZPR_CAPTURE_END(path) ZFrameProfiler::EnableCapture(false); ZFrameProfiler::ExportChromeTrace(path);
+#else
+#define ZPR_ZONE(name) ((void)0);
+#define ZPR_FUNCTION_ZONE() ((void)0);
+#define ZPR_THREAD_NAME(name) ((void)0);
+#define ZPR_CAPTURE_BEGIN() ((void)0);
+#define ZPR_CAPTURE_END(path) ((void)0);
 #endif
\ No newline at end of file
@@ -79,6 +79,7 @@ protected:
     double deltaTime_ = 0.0;
     std::function<void()> onUpdateTickCallback_;
     bool isTopLevel_ = true;
+    unsigned int capturedFrames_ = 0;
 
     virtual void Setup() override;
 
@@ -33,6 +33,9 @@
 #include "ZProcess.hpp"
 #include "ZOFTree.hpp"
 #include "ZBVH.hpp"
+#include "ZFrustumCuller.hpp"
+#include "ZOcclusionCuller.hpp"
+#include "ZLightGrid.hpp"
 
 // Forward Declarations
 class ZGame;
@@ -53,6 +56,7 @@ class ZModelReadyEvent;
 class ZSkyboxReadyEvent;
 class ZRay;
 class ZBVH;
+class ZGraphicsComponent;
 
 // Class and Data Structure Definitions
 class ZScene : public ZProcess, public std::enable_shared_from_this<ZScene>
@@ -84,6 +88,8 @@ public:
     std::string& Name() { return name_; }
     ZPlayState& PlayState() { return playState_; }
     std::shared_ptr<ZTexture> TargetTexture();
+    std::shared_ptr<ZRenderer> Renderer() const { return renderer_; }
+    ZLightGrid& LightGrid() { return lightGrid_; }
     std::shared_ptr<ZPhysicsUniverse> PhysicsUniverse() const { return gameSystems_.physics; }
     std::shared_ptr<ZDomain> Domain() const { return gameSystems_.domain; }
     std::shared_ptr<ZAudio> Audio() const { return gameSystems_.audio; }
@@ -119,6 +125,17 @@ public:
 
     void UpdateLightspaceMatrices();
 
+    void CullObjects();
+    // Objects that have to be prepared this frame: those in view or in a shadow cascade, and those that are
+    // always visible. Resolved by CullObjects, so preparing the scene doesn't have to walk every object.
+    const std::vector<ZGameObject*>& PreparedObjects() const { return preparedObjects_; }
+
+    // Summarizes the cascade matrix and the shadow casters inside a cascade, so the shadow pass can tell
+    // whether its cached contents are still valid. Dynamic cascades hold animated or unbounded casters
+    // and must be rendered every frame.
+    uint64_t ShadowCascadeSignature(unsigned int cascade) const { return shadowCascadeSignatures_[cascade]; }
+    uint8_t DynamicShadowCascades() const { return dynamicShadowCascades_; }
+
     template <class T, typename... Args>
     static std::shared_ptr<T> Load(Args&&... args)
     {
@@ -169,6 +186,20 @@ protected:
     std::shared_ptr<ZCamera> primaryCamera_ = nullptr;
     std::shared_ptr<ZBVH> bvh_ = nullptr;
 
+    ZFrustumCuller culler_;
+    std::vector<ZGraphicsComponent*> cullables_;
+    std::vector<ZGameObject*> cullableObjects_;
+    std::vector<ZGameObject*> preparedObjects_;
+    std::vector<uint32_t> visibleObjects_;
+    std::vector<uint32_t> cascadeObjects_;
+    std::vector<uint64_t> casterSignatures_;
+    std::vector<bool> animatedCasters_;
+    std::array<uint64_t, NUM_SHADOW_CASCADES> shadowCascadeSignatures_{};
+    uint8_t dynamicShadowCascades_ = 0xff;
+    ZOcclusionCuller occlusionCuller_;
+    std::vector<float> occlusionDepth_;
+    ZLightGrid lightGrid_;
+
     ZIDMap gameLightIDMap_;
     ZLightList gameLights_;
     ZIDMap gameObjectIDMap_;
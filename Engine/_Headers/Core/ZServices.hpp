@@ -31,6 +31,7 @@
 
 // Includes
 #include "ZProcessRunner.hpp"
+#include "ZJobSystem.hpp"
 #include "ZResourceCache.hpp"
 #include "ZEventAgent.hpp"
 #include "ZScriptManager.hpp"
@@ -51,6 +52,7 @@ public:
     static std::shared_ptr<ZInput> Input() { return input_; }
     static std::shared_ptr<ZEventAgent> EventAgent() { return eventAgent_; }
     static std::shared_ptr<ZResourceCache> ResourceCache() { return resourceCache_; }
+    static std::shared_ptr<ZJobSystem> JobSystem() { return jobSystem_; }
     static std::shared_ptr<ZScriptManager> ScriptManager() { return scriptManager_; }
     static std::shared_ptr<ZProcessRunner> ProcessRunner(const std::string& runner = "Default");
     static std::shared_ptr<ZLogger> Logger(const std::string& logger = "Default");
@@ -59,6 +61,7 @@ public:
     static void Provide(const std::shared_ptr<ZGraphics>& graphics);
     static void Provide(const std::shared_ptr<ZInput>& input);
     static void Provide(const std::shared_ptr<ZResourceCache>& resourceCache);
+    static void Provide(const std::shared_ptr<ZJobSystem>& jobSystem);
     static void Provide(const std::shared_ptr<ZEventAgent>& eventAgent);
     static void Provide(const std::shared_ptr<ZScriptManager>& scriptManager);
     static void Provide(const std::shared_ptr<ZAssetStore>& assetStore);
@@ -71,6 +74,7 @@ private:
     static std::shared_ptr<ZInput> input_;
     static std::shared_ptr<ZEventAgent> eventAgent_;
     static std::shared_ptr<ZResourceCache> resourceCache_;
+    static std::shared_ptr<ZJobSystem> jobSystem_;
     static std::shared_ptr<ZScriptManager> scriptManager_;
     static std::shared_ptr<ZAssetStore> assetStore_;
     static std::unordered_map<std::string, std::shared_ptr<ZProcessRunner>> processRunners_;
@@ -6,9 +6,9 @@
    /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
    \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
 
-   ZCollisionEvent.hpp
+   ZCollisionBatchEvent.hpp
 
-   Created by Adrian Sanchez on 13/03/2019.
+   Created by Adrian Sanchez on 10/18/2026.
    Copyright © 2019 Pervasive Sense. All rights reserved.
 
  This file is part of Zenith.
@@ -35,22 +35,27 @@
 // Forward Declarations
 
 // Class and Data Structure Definitions
-class ZCollisionEvent : public ZEvent
+
+// Carries every body pair that started or stopped touching during a physics tick
+class ZCollisionBatchEvent : public ZEvent
 {
 
 private:
 
-    ZCollisionPair collisionPair_;
+    ZCollisionPairList began_;
+    ZCollisionPairList ended_;
 
 public:
 
     static const ZTypeIdentifier Type;
 
-    explicit ZCollisionEvent(const ZCollisionPair& collisionPair) : collisionPair_(collisionPair) {}
+    ZCollisionBatchEvent(const ZCollisionPairList& began, const ZCollisionPairList& ended) : began_(began), ended_(ended) {}
 
     const ZTypeIdentifier& EventType() const override { return Type; };
-    std::shared_ptr<ZEvent> Copy() const override { return std::shared_ptr<ZCollisionEvent>(new ZCollisionEvent(collisionPair_)); }
-    std::string Name() const override { return "ZCollisionEvent"; }
+    std::shared_ptr<ZEvent> Copy() const override { return std::shared_ptr<ZCollisionBatchEvent>(new ZCollisionBatchEvent(began_, ended_)); }
+    std::string Name() const override { return "ZCollisionBatchEvent"; }
 
-};
+    const ZCollisionPairList& Began() const { return began_; }
+    const ZCollisionPairList& Ended() const { return ended_; }
 
+};
@@ -36,6 +36,10 @@
 //class SomeClass;
 
 // Class and Data Structure Definitions
+
+// Delegates are always invoked with events of the type they were subscribed to, so they can static cast the
+// event instead of paying for RTTI. Each delegate class identifies itself through the address of a function
+// local static, which lets IsEqualTo compare delegates without a dynamic_cast.
 class ZEventDelegate {
 
 public:
@@ -50,6 +54,8 @@ public:
         return !IsEqualTo(other);
     }
 
+    virtual const void* Kind() const = 0;
+
 protected:
 
     virtual void Call(const std::shared_ptr<ZEvent>& event) const = 0;
@@ -69,14 +75,18 @@ public:
     { }
 
     void Call(const std::shared_ptr<ZEvent>& event) const override {
-        (instance_->*func_)(std::dynamic_pointer_cast<EventType>(event));
+        (instance_->*func_)(std::static_pointer_cast<EventType>(event));
     }
 
     bool IsEqualTo(const ZEventDelegate& other) const  override {
-        if (ZMemberEventDelegate const* otherMemberDelegate = dynamic_cast<ZMemberEventDelegate const*>(&other)) {
-            return otherMemberDelegate->instance_ == instance_ && otherMemberDelegate->func_ == func_;
-        }
-        return false;
+        if (other.Kind() != Kind()) return false;
+        auto otherMemberDelegate = static_cast<ZMemberEventDelegate const*>(&other);
+        return otherMemberDelegate->instance_ == instance_ && otherMemberDelegate->func_ == func_;
+    }
+
+    const void* Kind() const override {
+        static const char kind = 0;
+        return &kind;
     }
 
 protected:
@@ -97,14 +107,18 @@ public:
     { }
 
     void Call(const std::shared_ptr<ZEvent>& event) const override {
-        (*func_)(std::dynamic_pointer_cast<EventType>(event));
+        (*func_)(std::static_pointer_cast<EventType>(event));
     }
 
     bool IsEqualTo(const ZEventDelegate& other) const  override {
-        if (ZGlobalEventDelegate const* otherMemberDelegate = dynamic_cast<ZGlobalEventDelegate const*>(&other)) {
-            return otherMemberDelegate->func_ == func_;
-        }
-        return false;
+        if (other.Kind() != Kind()) return false;
+        auto otherGlobalDelegate = static_cast<ZGlobalEventDelegate const*>(&other);
+        return otherGlobalDelegate->func_ == func_;
+    }
+
+    const void* Kind() const override {
+        static const char kind = 0;
+        return &kind;
     }
 
 protected:
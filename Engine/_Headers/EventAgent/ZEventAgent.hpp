@@ -32,24 +32,27 @@
 // Includes
 #include "ZEvent.hpp"
 #include "ZProcess.hpp"
+#include "ZRingBuffer.hpp"
 
 // Forward Declarations
 //class SomeClass;
 
 // Class and Data Structure Definitions
-const unsigned int NUM_EVENT_QUEUES = 2;
-const unsigned int NUM_LISTENER_QUEUES = 2;
+const unsigned int EVENT_QUEUE_CAPACITY = 4096;
 
+// Listeners are kept in immutable per-type arrays that are swapped out whole on Subscribe and Unsubscribe, so
+// dispatch only needs to grab the current snapshot. Queued events go through a lock-free ring buffer and only
+// spill over into a locked list if a burst fills the ring between updates.
 class ZEventAgent : public ZProcess
 {
 
-    typedef std::list<std::shared_ptr<ZEventDelegate>> EventListenerList;
-    typedef std::map<ZTypeIdentifier, EventListenerList> EventListenerMap;
+    typedef std::vector<std::shared_ptr<ZEventDelegate>> EventListenerList;
+    typedef std::unordered_map<ZTypeIdentifier, std::shared_ptr<const EventListenerList>> EventListenerMap;
     typedef std::list<std::shared_ptr<ZEvent>> EventQueue;
 
 public:
 
-    ZEventAgent() : activeQueue_(0), activeListeners_(0), updateTimeoutMax_(UPDATE_STEP_SIZE * 2.f) {}
+    ZEventAgent() : eventRing_(EVENT_QUEUE_CAPACITY), updateTimeoutMax_(UPDATE_STEP_SIZE * 2.f) {}
     ~ZEventAgent() {}
 
     void Initialize() override;
@@ -96,7 +99,7 @@ public:
         if (!std::is_base_of<ZEvent, EventType>::value)
             return false;
         return Unsubscribe(
-            std::make_shared<ZGlobalEventDelegate<EventType>>(instance, func),
+            std::make_shared<ZGlobalEventDelegate<EventType>>(func),
             EventType::Type
         );
     }
@@ -105,13 +108,22 @@ public:
 
 private:
 
-    EventListenerMap eventListeners_[NUM_LISTENER_QUEUES];
-    EventQueue eventQueues_[NUM_EVENT_QUEUES];
-    int activeQueue_, activeListeners_;
+    std::shared_ptr<const EventListenerMap> eventListeners_ = std::make_shared<EventListenerMap>();
+    ZRingBuffer<std::shared_ptr<ZEvent>> eventRing_;
+    EventQueue overflowQueue_;
+    EventQueue pendingQueue_;
+    std::atomic_bool overflowing_{ false };
     float updateTimeoutMax_;
 
     struct {
         std::mutex listeners;
+        std::mutex overflow;
+        std::mutex pending;
     } mutexes_;
 
+    std::shared_ptr<const EventListenerMap> Listeners() const;
+    std::shared_ptr<const EventListenerList> Listeners(const ZTypeIdentifier& type) const;
+    void PublishListeners(const ZTypeIdentifier& type, const std::shared_ptr<const EventListenerList>& listeners);
+    void DrainQueue();
+
 };
@@ -68,7 +68,7 @@ public:
     float Sensitivity() const { return lookSensitivity_; }
     float NearField() const { return nearClippingPlane_; }
     float FarField() const { return farClippingPlane_; }
-    ZFrustum Frustum() const { return frustum_; }
+    const ZFrustum& Frustum() const { return frustum_; }
     bool IsPrimary() const { return isPrimary_; }
     bool Moving() const { return moving_; }
     glm::mat4 ProjectionMatrix() { return projection_; }
@@ -216,6 +216,8 @@ protected:
 
     std::shared_ptr<ZRenderStateGroup> renderState_;
     std::shared_ptr<ZUniformBuffer> uniformBuffer_;
+    // Set when the model matrix changes, the render state picks up the new instance transform in Prepare
+    std::atomic_bool instanceTransformDirty_{ false };
 
     struct
     {
@@ -59,7 +59,7 @@ public:
 
     std::shared_ptr<ZGameObject> Clone() override;
 
-    std::vector<glm::mat4> LightSpaceMatrices() const { return lightspaceMatrices_; }
+    const std::vector<glm::mat4>& LightSpaceMatrices() const { return lightspaceMatrices_; }
     const ZAABBox& LightSpaceRegion() const { return lightspaceRegion_; }
     const glm::vec4 ShadowFarPlaneSplits() const { return shadowFarPlaneSplits_; }
     const std::shared_ptr<ZRenderStateGroup> RenderState() const { return renderState_; }
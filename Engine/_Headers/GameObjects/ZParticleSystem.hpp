@@ -33,7 +33,9 @@
 #include "ZGameObject.hpp"
 
 // Forward Declarations
-class ZParticle;
+class ZGraphicsComponent;
+class ZModel;
+class ZTextureReadyEvent;
 
 // Class and Data Structure Definitions
 struct ZParticleRule
@@ -43,14 +45,45 @@ struct ZParticleRule
     float minVelocity = 5.f;
     float maxVelocity = 100.f;
     float damping = 0.1f;
+    float minSize = 0.05f;
+    float maxSize = 0.2f;
+    float endSizeScale = 1.f;
+    float spread = 0.25f;
+    glm::vec3 direction = glm::vec3(0.f, 1.f, 0.f);
+    glm::vec4 startColor = glm::vec4(1.f);
+    glm::vec4 endColor = glm::vec4(1.f, 1.f, 1.f, 0.f);
 };
 
-class ZParticleSystem : public ZGameObject
+struct ZParticleEmitter
 {
-private:
+    ZParticleRule rule;
+    float rate = 100.f;
+    glm::vec3 offset = glm::vec3(0.f);
+    glm::vec3 extents = glm::vec3(0.f);
+    float accumulator = 0.f;
+};
 
-    std::vector<ZParticle*> particles_;
-    bool isAlive_ = false;
+// Particle state stored as parallel arrays so that the update kernels stream through contiguous
+// floats. Color and size are advanced by per particle rates fixed at emission time, which keeps
+// every kernel free of branches and lookups.
+struct ZParticleBuffer
+{
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> velocityX, velocityY, velocityZ;
+    std::vector<float> colorR, colorG, colorB, colorA;
+    std::vector<float> colorRateR, colorRateG, colorRateB, colorRateA;
+    std::vector<float> size, sizeRate;
+    std::vector<float> age, lifetime, damping;
+    unsigned int count = 0;
+
+    unsigned int Capacity() const { return static_cast<unsigned int>(age.size()); }
+
+    void Resize(unsigned int capacity);
+    void Move(unsigned int from, unsigned int to);
+};
+
+class ZParticleSystem : public ZGameObject
+{
 
 public:
 
@@ -59,10 +92,24 @@ public:
     ZParticleSystem(std::initializer_list<ZParticleRule> rules);
     ~ZParticleSystem() {}
 
+    void Initialize() override;
+    void Initialize(std::shared_ptr<ZOFNode> root) override;
+    void Prepare(double deltaTime) override;
+    bool IsVisible() override { return true; }
+
     void Start() { isAlive_ = true; }
     void Stop() { isAlive_ = false; }
+    void Clear() { particles_.count = 0; }
 
     bool Alive() { return isAlive_; }
+    unsigned int Count() const { return particles_.count; }
+    unsigned int MaxParticles() const { return maxParticles_; }
+    const ZParticleBuffer& Particles() const { return particles_; }
+    const std::vector<ZParticleEmitter>& Emitters() const { return emitters_; }
+
+    void SetMaxParticles(unsigned int maxParticles);
+    void SetGravity(const glm::vec3& gravity) { gravity_ = gravity; }
+    void AddEmitter(const ZParticleEmitter& emitter) { emitters_.push_back(emitter); }
 
     void Update(double deltaTime) override;
 
@@ -70,5 +117,25 @@ public:
 
 protected:
 
+    static constexpr unsigned int cDefaultMaxParticles = 10000;
+    static constexpr unsigned int cParallelBatchSize = 16384;
+
+    ZParticleBuffer particles_;
+    std::vector<ZParticleEmitter> emitters_;
+    std::vector<glm::mat4> instances_;
+    unsigned int maxParticles_ = cDefaultMaxParticles;
+    glm::vec3 gravity_ = glm::vec3(0.f);
+    bool isAlive_ = false;
+    std::mt19937 random_;
+
+    std::shared_ptr<ZGraphicsComponent> graphicsComp_;
+    std::shared_ptr<ZModel> quad_;
+    std::string textureId_;
+
+    void Emit(ZParticleEmitter& emitter, unsigned int count);
+    void Simulate(float deltaTime);
+    void Compact();
+    void PackInstances();
+    void HandleTextureReady(const std::shared_ptr<ZTextureReadyEvent>& event);
 
 };
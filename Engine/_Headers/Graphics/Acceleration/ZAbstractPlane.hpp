@@ -47,7 +47,7 @@ public:
     ZAbstractPlane(const glm::vec3& c, const glm::vec3& n) : center(c), normal(n) {}
     ZAbstractPlane(const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3);
 
-    float Distance(const glm::vec3& point);
+    float Distance(const glm::vec3& point) const;
     glm::vec3 Intersection(const ZAbstractPlane& a, const ZAbstractPlane& b);
 
 };
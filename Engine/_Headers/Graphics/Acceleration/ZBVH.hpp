@@ -39,6 +39,11 @@ enum class ZBVHSplitMethod
     SAH, Middle, EqualCounts
 };
 
+enum class ZBVHBuildMode
+{
+    Recursive, Parallel
+};
+
 struct ZBVHPrimitive
 {
     std::string objectId;
@@ -81,11 +86,32 @@ struct ZBVHBuildNode
     }
 };
 
+struct ZBVHArenaNode
+{
+    ZAABBox bounds;
+    int children[2];
+    int splitAxis, firstPrimitiveOffset, primitivesCount;
+};
+
+struct ZBVHBucketInfo
+{
+    int count = 0;
+    ZAABBox bounds;
+};
+
 struct ZIntersectHitResult
 {
     std::string objectId;
 };
 
+// Compact query result. The primitive handle indexes the primitives of the last
+// build and stays valid until the next full rebuild of the tree.
+struct ZBVHHit
+{
+    int primitive = -1;
+    float distance = std::numeric_limits<float>::max();
+};
+
 struct ZLinearBVHNode
 {
     ZAABBox bounds;
@@ -104,14 +130,32 @@ class ZBVH
 
 public:
 
-    ZBVH::ZBVH(int maxNodePrimitives, ZBVHSplitMethod splitMethod)
-        : maxNodePrimitives_(std::min(255, maxNodePrimitives)), splitMethod_(splitMethod)
+    ZBVH::ZBVH(int maxNodePrimitives, ZBVHSplitMethod splitMethod, ZBVHBuildMode buildMode = ZBVHBuildMode::Recursive)
+        : maxNodePrimitives_(std::min(255, maxNodePrimitives)), splitMethod_(splitMethod), buildMode_(buildMode)
     { }
     ~ZBVH() { }
 
+    float Cost() const;
+    bool RefitEnabled() const { return refitEnabled_; }
+    float RefitThreshold() const { return refitThreshold_; }
+
+    ZBVHBuildMode BuildMode() const { return buildMode_; }
+
+    void SetBuildMode(ZBVHBuildMode mode) { buildMode_ = mode; }
+    void SetRefitEnabled(bool enabled) { refitEnabled_ = enabled; }
+    void SetRefitThreshold(float threshold) { refitThreshold_ = std::max(1.f, threshold); }
+
     void Build();
+    void Rebuild();
+    bool Refit();
     void AddPrimitive(const ZBVHPrimitive& primitive);
     bool Intersect(ZRay& ray, ZIntersectHitResult& hitResult);
+    bool Intersect(const ZRay& ray, ZBVHHit& hit) const;
+    int IntersectMany(const ZRay* rays, int count, ZBVHHit* hits) const;
+    int IntersectMany(const std::vector<ZRay>& rays, std::vector<ZBVHHit>& hits) const;
+
+    const std::string& PrimitiveID(int handle) const { return primitives_[handle].objectId; }
+    const ZAABBox& PrimitiveBounds(int handle) const { return primitives_[handle].bounds; }
 
 protected:
 
@@ -119,10 +163,46 @@ protected:
     std::vector<ZBVHPrimitive> primitives_;
     unsigned int maxNodePrimitives_;
     ZBVHSplitMethod splitMethod_;
+    ZBVHBuildMode buildMode_;
     std::vector<ZLinearBVHNode> nodes_;
 
+    // Parallel build storage. These are kept around between builds so that rebuilding a tree
+    // of similar size doesn't touch the heap at all.
+    std::vector<ZBVHArenaNode> arena_;
+    std::vector<ZBVHPrimitiveInfo> primitiveInfo_;
+    std::vector<ZBVHPrimitive> orderedPrimitives_;
+    std::atomic_int arenaSize_ = 0;
+
+    // Per task partial results for the parallel bounds and binning passes. Every level of the build
+    // that splits its passes across tasks has its own row, so sibling subtrees never share slots.
+    int buildThreads_ = 1;
+    int buildTaskDepth_ = 0;
+    std::vector<std::pair<ZAABBox, ZAABBox>> boundsPartials_;
+    std::vector<ZBVHBucketInfo> bucketPartials_;
+
+    // Refit bookkeeping. Primitives are matched to their leaves by the position they were submitted at
+    // in the last rebuild, so that only the leaves of moving primitives and their ancestors need new bounds.
+    bool refitEnabled_ = true;
+    float refitThreshold_ = 1.5f;
+    float builtArea_ = 0.f;
+    float interiorArea_ = 0.f;
+    float leafArea_ = 0.f;
+    std::vector<int> primitiveSlots_;
+    std::vector<int> primitiveLeaves_;
+    std::vector<int> nodeParents_;
+    std::vector<int> dirtyLeaves_;
+
     std::shared_ptr<ZBVHBuildNode> RecursiveBuild(std::vector<ZBVHPrimitiveInfo>& primitiveInfo, int start, int end, int* totalNodes, std::vector<ZBVHPrimitive>& orderedPrimitives);
     std::shared_ptr<ZBVHBuildNode> CreateLeafNode(std::vector<ZBVHPrimitive>& orderedPrimitives, int start, int end, std::vector<ZBVHPrimitiveInfo>& primitiveInfo, int primitiveCount, ZAABBox bounds);
     int FlattenBVHTree(const std::shared_ptr<ZBVHBuildNode>& node, int* offset);
+    void ParallelBuild();
+    int ArenaBuild(int start, int end, int depth, int slot);
+    int CreateArenaLeaf(int start, int end, const ZAABBox& bounds);
+    void ComputeBounds(int start, int end, ZAABBox& bounds, ZAABBox& centroidBounds, int depth, int slot);
+    void BinPrimitives(int start, int end, int axis, const ZAABBox& centroidBounds, ZBVHBucketInfo* buckets, int depth, int slot);
+    int FlattenArena(int nodeIndex, int* offset);
+    void IntersectPacket(const ZRay* rays, int count, ZBVHHit* hits) const;
+    void IndexPrimitives();
+    void RefitNode(int nodeIndex);
 
 };
\ No newline at end of file
@@ -58,10 +58,10 @@ public:
 
     void Recalculate();
 
-    bool Contains(const glm::vec3& point);
-    bool Contains(const glm::vec3& center, float radius);
-    bool Contains(const ZAABBox& box);
-    bool Contains(const ZFrustum& frustum);
+    bool Contains(const glm::vec3& point) const;
+    bool Contains(const glm::vec3& center, float radius) const;
+    bool Contains(const ZAABBox& box) const;
+    bool Contains(const ZFrustum& frustum) const;
 
 };
 
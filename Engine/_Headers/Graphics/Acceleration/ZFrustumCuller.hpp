@@ -0,0 +1,66 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZFrustumCuller.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZFrustum.hpp"
+
+// Forward Declarations
+
+// Class and Data Structure Definitions
+
+// Planes are stored as (normal, distance) with normals facing into the frustum, in ZFrustum plane order
+using ZFrustumPlanes = std::array<glm::vec4, ZFrustum::NUMPLANES>;
+
+// Culls a set of bounding boxes against one or more views. Bounds are kept as a structure of arrays so that
+// four boxes can be tested against a plane at once, and each view produces a compact list of visible indices.
+class ZFrustumCuller
+{
+
+public:
+
+    ZFrustumCuller() = default;
+    ~ZFrustumCuller() = default;
+
+    size_t Size() const { return minX_.size(); }
+
+    void Clear();
+    uint32_t Add(const ZAABBox& bounds);
+
+    void Cull(const ZFrustumPlanes& planes, std::vector<uint32_t>& outVisible, bool cullNear = true) const;
+
+    static ZFrustumPlanes Planes(const glm::mat4& viewProjection);
+
+private:
+
+    std::vector<float> minX_, minY_, minZ_;
+    std::vector<float> maxX_, maxY_, maxZ_;
+
+};
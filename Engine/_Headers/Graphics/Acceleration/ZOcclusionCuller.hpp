@@ -0,0 +1,62 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZOcclusionCuller.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZAABBox.hpp"
+
+// Forward Declarations
+
+// Class and Data Structure Definitions
+
+// Tests bounding boxes against a hierarchical depth buffer. Each level halves the one before it and keeps the
+// farthest depth of the texels it covers, so any box can be tested by reading at most four texels.
+class ZOcclusionCuller
+{
+
+public:
+
+    ZOcclusionCuller() = default;
+    ~ZOcclusionCuller() = default;
+
+    bool Valid() const { return !levels_.empty(); }
+
+    void Clear() { levels_.clear(); }
+    void Build(const std::vector<float>& depth, unsigned int size, const glm::mat4& viewProjection);
+
+    bool Occluded(const ZAABBox& bounds) const;
+
+private:
+
+    std::vector<std::vector<float>> levels_;
+    unsigned int size_ = 0;
+    glm::mat4 viewProjection_{ 1.f };
+
+};
@@ -33,12 +33,11 @@
 #include "ZMesh.hpp"
 #include "ZTexture.hpp"
 #include "ZAABBox.hpp"
+#include "ZAnimation.hpp"
+#include "ZSkeleton.hpp"
 
 // Forward Declarations
 class ZShader;
-struct ZSkeleton;
-struct ZJoint;
-struct ZJointAnimation;
 class ZResourceLoadedEvent;
 class ZUniformBuffer;
 class ZRenderStateGroup;
@@ -72,8 +71,9 @@ public:
     const std::shared_ptr<ZRenderStateGroup> RenderState() const { return renderState_; }
 
     void SetInstanceData(const ZInstancedDataOptions& instanceData);
+    void UpdateInstances(const glm::mat4* transforms, unsigned int count);
 
-    void BoneTransform(const std::string& anim, double secondsTime);
+    void BoneTransform(const std::string& anim, double secondsTime, ZAnimationClipState& clipState);
 
     static void Create(std::shared_ptr<ZOFTree> data, ZModelMap& outModelMap);
     static void CreateAsync(std::shared_ptr<ZOFTree> data, ZModelIDMap& outPendingModels, ZModelMap& outModelMap);
@@ -94,16 +94,21 @@ protected:
     glm::mat4 globalInverseTransform_;
     ZAABBox bounds_;
 
+    std::vector<ZSkeletonJoint> joints_;
+    std::unordered_map<std::string, ZCompiledAnimation> compiledAnimations_;
+    std::vector<glm::mat4> bonePalette_;
+
     std::shared_ptr<ZRenderStateGroup> renderState_;
     std::shared_ptr<ZUniformBuffer> uniformBuffer_;
 
     static ZIDSequence idGenerator_;
 
     void ComputeBounds();
-    void CalculateTransformsInHierarchy(const std::string& animName, double animTime, const std::shared_ptr<ZJoint> joint, const glm::mat4& parentTransform);
-    glm::vec3 CalculateInterpolatedScaling(double animationTime, std::shared_ptr<ZJointAnimation> jointAnim);
-    glm::quat CalculateInterpolatedRotation(double animationTime, std::shared_ptr<ZJointAnimation> jointAnim);
-    glm::vec3 CalculateInterpolatedPosition(double animationTime, std::shared_ptr<ZJointAnimation> jointAnim);
+    void CompileAnimations();
+    void FlattenSkeleton(const std::shared_ptr<ZJoint>& joint, int parent, std::unordered_map<std::string, unsigned int>& outIndices);
+    glm::vec3 CalculateInterpolatedScaling(double animationTime, const ZJointAnimation& jointAnim, unsigned int& cursor);
+    glm::quat CalculateInterpolatedRotation(double animationTime, const ZJointAnimation& jointAnim, unsigned int& cursor);
+    glm::vec3 CalculateInterpolatedPosition(double animationTime, const ZJointAnimation& jointAnim, unsigned int& cursor);
 
     void HandleModelLoaded(const std::shared_ptr<ZResourceLoadedEvent>& event);
 
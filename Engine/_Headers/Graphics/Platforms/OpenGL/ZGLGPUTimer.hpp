@@ -0,0 +1,81 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZGLGPUTimer.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZGPUTimer.hpp"
+
+// Forward Declarations
+
+// Class and Data Structure Definitions
+class ZGLGPUTimer : public ZGPUTimer
+{
+
+public:
+
+    ZGLGPUTimer() { }
+    ~ZGLGPUTimer();
+
+    void BeginFrame() override;
+    void EndFrame() override;
+    void Begin(const std::string& name) override;
+    void End() override;
+
+    static bool Supported();
+
+private:
+
+    struct ZGLTimerScope
+    {
+        std::string name;
+        unsigned int depth = 0;
+        unsigned int beginQuery = 0;
+        unsigned int endQuery = 0;
+    };
+
+    // Each frame in flight owns a pool of timestamp queries that is reused once its results are read
+    struct ZGLTimerFrame
+    {
+        std::vector<ZGLTimerScope> scopes;
+        std::vector<unsigned int> queries;
+        unsigned int usedQueries = 0;
+        bool pending = false;
+    };
+
+    std::array<ZGLTimerFrame, frameLatency> frames_;
+    std::vector<unsigned int> openScopes_;
+    unsigned int currentFrame_ = 0;
+    unsigned int frameDepth_ = 0;
+    bool recording_ = false;
+
+    unsigned int AcquireQuery(ZGLTimerFrame& frame);
+    bool Resolve(ZGLTimerFrame& frame);
+
+};
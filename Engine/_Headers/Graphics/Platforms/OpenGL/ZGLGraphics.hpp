@@ -81,5 +81,6 @@ public:
     void SetBlending(ZBlendMode blendMode) override;
 
     void Draw(const std::shared_ptr<ZVertexBuffer>& bufferData, ZMeshDrawStyle drawStyle = ZMeshDrawStyle::Triangle) override;
+    void DrawInstanced(const std::shared_ptr<ZVertexBuffer>& bufferData, unsigned int instanceCount, ZMeshDrawStyle drawStyle = ZMeshDrawStyle::Triangle) override;
 
 };
@@ -0,0 +1,72 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZGLOcclusionBuffer.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZOcclusionBuffer.hpp"
+
+// Forward Declarations
+class ZShader;
+
+// Class and Data Structure Definitions
+class ZGLOcclusionBuffer : public ZOcclusionBuffer
+{
+
+public:
+
+    ZGLOcclusionBuffer() { }
+    ~ZGLOcclusionBuffer();
+
+    void Capture(const std::shared_ptr<ZTexture>& depth, const glm::mat4& viewProjection) override;
+    bool Read(std::vector<float>& outDepth, glm::mat4& outViewProjection) override;
+
+    static bool Supported();
+
+private:
+
+    // Each capture in flight owns a pixel buffer that is reused once its fence has signaled and it has been read
+    struct ZGLOcclusionFrame
+    {
+        unsigned int pbo = 0;
+        void* fence = nullptr;
+        glm::mat4 viewProjection{ 1.f };
+        bool pending = false;
+    };
+
+    std::array<ZGLOcclusionFrame, frameLatency> frames_;
+    std::shared_ptr<ZShader> shader_ = nullptr;
+    unsigned int fbo_ = 0;
+    unsigned int target_ = 0;
+    unsigned int vao_ = 0;
+    unsigned int currentFrame_ = 0;
+
+    void Initialize();
+
+};
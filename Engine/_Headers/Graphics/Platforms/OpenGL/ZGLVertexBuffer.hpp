@@ -46,12 +46,18 @@ public:
     void Unbind() override;
     void Load(const ZVertex2DDataOptions& vertexData) override;
     void Load(const ZVertex3DDataOptions& vertexData) override;
+    void Load(const ZDebugVertexDataOptions& vertexData) override;
     void Update(const ZVertex2DDataOptions& vertexData) override;
     void Update(const ZVertex3DDataOptions& vertexData) override;
+    void Update(const ZDebugVertexDataOptions& vertexData) override;
+    void UpdateInstances(const glm::mat4* transforms, unsigned int count) override;
     void Delete() override;
 
 protected:
 
+    // Number of vertices the vertex buffer storage can hold, for buffers that are streamed into
+    size_t vertexCapacity_ = 0;
+
     struct
     {
         std::mutex state;
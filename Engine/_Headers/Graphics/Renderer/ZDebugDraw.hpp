@@ -0,0 +1,79 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZDebugDraw.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+
+// Forward Declarations
+class ZScene;
+class ZFrustum;
+class ZAABBox;
+class ZVertexBuffer;
+
+// Class and Data Structure Definitions
+enum class ZDebugDepthMode
+{
+    Test = 0, Overlay, Count
+};
+
+// Collects debug geometry into a per-frame line list. Once per frame the lists are uploaded into
+// a ring of streamed vertex buffers, and each depth mode is drawn with a single line draw call.
+class ZDebugDraw
+{
+
+public:
+
+    static constexpr unsigned int frameLatency = 3;
+
+    ZDebugDraw() = default;
+    ~ZDebugDraw() = default;
+
+    void Line(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, ZDebugDepthMode depthMode = ZDebugDepthMode::Test);
+    void Box(const ZAABBox& aabb, const glm::vec4& color, ZDebugDepthMode depthMode = ZDebugDepthMode::Test);
+    void Sphere(const glm::vec3& center, float radius, const glm::vec4& color, ZDebugDepthMode depthMode = ZDebugDepthMode::Test, unsigned int segments = 24);
+    void Frustum(const ZFrustum& frustum, const glm::vec4& color, ZDebugDepthMode depthMode = ZDebugDepthMode::Test);
+    void Grid(unsigned int size, float cellSize, const glm::vec4& color, ZDebugDepthMode depthMode = ZDebugDepthMode::Test);
+
+    void Submit(const std::shared_ptr<ZScene>& scene);
+    void Clear();
+
+private:
+
+    using DepthModeArray = std::array<ZDebugVertexDataOptions, static_cast<size_t>(ZDebugDepthMode::Count)>;
+    using VertexBufferArray = std::array<std::shared_ptr<ZVertexBuffer>, static_cast<size_t>(ZDebugDepthMode::Count)>;
+
+    DepthModeArray streams_;
+    std::array<VertexBufferArray, frameLatency> vertexBuffers_;
+    unsigned int frameIndex_ = 0;
+
+    ZDebugVertexList& Stream(ZDebugDepthMode depthMode) { return streams_[static_cast<size_t>(depthMode)].vertices; }
+
+};
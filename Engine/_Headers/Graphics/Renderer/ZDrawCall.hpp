@@ -37,6 +37,7 @@ class ZDrawCall
 {
 
     friend class ZRenderStateExecutor;
+    friend class ZRenderQueue;
 
 public:
     
@@ -0,0 +1,96 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZLightGrid.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+
+// Forward Declarations
+class ZCamera;
+class ZLight;
+class ZStorageBuffer;
+
+// Class and Data Structure Definitions
+
+// Matches the header of the LightClusters buffer in clusters.glsl
+struct ZLightClusterUniforms
+{
+    // Maps log(view depth) to a depth slice: slice = log(depth) * x + y
+    glm::vec4 sliceScale;
+    // Cluster counts along x, y and depth in xyz, and the number of lights shaded everywhere in w
+    glm::uvec4 dimensions;
+};
+
+// Assigns lights to a grid of view space froxels so that each fragment only shades the lights whose range reaches
+// its cluster. The screen is split into tiles and the view depth into exponentially sized slices. Lights without a
+// finite range, like directional lights, are placed at the front of the light list and shaded everywhere.
+class ZLightGrid
+{
+
+public:
+
+    static constexpr unsigned int tilesX = 16;
+    static constexpr unsigned int tilesY = 9;
+    static constexpr unsigned int slices = 24;
+    static constexpr unsigned int clusterCount = tilesX * tilesY * slices;
+
+    ZLightGrid() = default;
+    ~ZLightGrid() = default;
+
+    size_t LightCount() const { return lights_.size(); }
+    size_t IndexCount() const { return indices_.size(); }
+    const std::vector<Light>& Lights() const { return lights_; }
+    const std::vector<glm::uvec2>& Clusters() const { return clusters_; }
+    const std::vector<uint32_t>& Indices() const { return indices_; }
+
+    void Build(const std::shared_ptr<ZCamera>& camera, const ZLightList& lights, const std::shared_ptr<ZLight>& excluded = nullptr);
+    void Cluster(const glm::mat4& view, const glm::mat4& projection, float near, float far, const std::vector<Light>& lights);
+    void Bind();
+
+    static float Range(const Light& light);
+
+private:
+
+    std::vector<Light> lights_;
+    std::vector<Light> candidates_;
+    std::vector<glm::uvec2> clusters_;
+    std::vector<uint32_t> indices_;
+    std::vector<glm::uvec2> assignments_;
+    std::vector<uint32_t> cursors_;
+    ZLightClusterUniforms uniforms_{ glm::vec4(0.f), glm::uvec4(tilesX, tilesY, slices, 0) };
+
+    std::shared_ptr<ZStorageBuffer> lightBuffer_ = nullptr;
+    std::shared_ptr<ZStorageBuffer> clusterBuffer_ = nullptr;
+    std::shared_ptr<ZStorageBuffer> indexBuffer_ = nullptr;
+
+    void Assign(uint32_t lightIndex, const glm::vec3& center, float range, const glm::mat4& projection, float near, float far);
+    void Upload();
+
+};
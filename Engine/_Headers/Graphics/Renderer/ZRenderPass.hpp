@@ -57,12 +57,13 @@ public:
 
     virtual void Initialize();
 
+    virtual const char* Name() const { return "Render Pass"; }
     std::shared_ptr<ZFramebuffer> Framebuffer() { return framebuffer_; }
     std::shared_ptr<ZRenderStateGroup> RenderState() const { return renderState_; }
 
     virtual void SetSize(const glm::vec2& size) { size_ = size; }
 
-    void Submit(const std::shared_ptr<ZRenderTask>& task);
+    void Submit(ZRenderTask* task);
     void Render(double deltaTime, const std::shared_ptr<ZScene>& scene, const std::shared_ptr<ZFramebuffer>& target = nullptr);
 
     static std::shared_ptr<ZRenderPass> Depth();
@@ -83,6 +84,7 @@ protected:
 
     uint8_t clearFlags_ = 0;
 
+    virtual bool NeedsRender(const std::shared_ptr<ZScene>& scene);
     virtual void Prepare(const std::shared_ptr<ZScene>& scene);
     virtual void Perform(double deltaTime, const std::shared_ptr<ZScene>& scene) { }
     virtual void Resolve(const std::shared_ptr<ZFramebuffer>& target = nullptr) { }
@@ -103,6 +105,8 @@ public:
         : ZRenderPass(shader, fbo, dependencies) { }
     ~ZDepthPass() { }
 
+    const char* Name() const override { return "Depth"; }
+
     void Initialize() override;
 
     void SetSize(const glm::vec2& size) override { }
@@ -127,6 +131,8 @@ public:
         : ZRenderPass(shader, fbo, dependencies) { }
     ~ZShadowPass() { }
 
+    const char* Name() const override { return "Shadow"; }
+
     void Initialize() override;
 
     void SetSize(const glm::vec2& size) override { }
@@ -135,6 +141,14 @@ protected:
 
     std::shared_ptr<ZUniformBuffer> uniformBuffer_ = nullptr;
 
+    // Cascade layers keep their depth between frames and are only redrawn when the scene's signature for
+    // them changes. The framebuffer is shared by every scene, so switching scenes invalidates all of them.
+    std::weak_ptr<ZScene> cachedScene_;
+    std::array<uint64_t, NUM_SHADOW_CASCADES> cachedSignatures_{};
+    uint8_t cachedCascades_ = 0;
+    uint8_t dirtyCascades_ = 0;
+
+    bool NeedsRender(const std::shared_ptr<ZScene>& scene) override;
     void Prepare(const std::shared_ptr<ZScene>& scene) override;
     void Perform(double deltaTime, const std::shared_ptr<ZScene>& scene )override;
     void Resolve(const std::shared_ptr<ZFramebuffer>& target = nullptr) override { }
@@ -153,6 +167,8 @@ public:
         : ZRenderPass(shader, fbo, dependencies), multisample_(multisample) { }
     ~ZColorPass() { }
 
+    const char* Name() const override { return "Color"; }
+
     void Initialize() override;
 
 protected:
@@ -178,6 +194,8 @@ public:
         : ZRenderPass(shader, fbo, dependencies) { }
     ~ZPostPass() { }
 
+    const char* Name() const override { return "Post"; }
+
     void Initialize() override;
 
 protected:
@@ -202,6 +220,8 @@ public:
         : ZRenderPass(shader, fbo, dependencies) { }
     ~ZUIPass() { }
 
+    const char* Name() const override { return "UI"; }
+
 protected:
 
     void Prepare(const std::shared_ptr<ZScene>& scene) override;
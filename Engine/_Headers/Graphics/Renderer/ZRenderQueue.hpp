@@ -38,8 +38,6 @@ class ZRenderStateExecutor;
 class ZRenderQueue
 {
 
-    using ZRenderTaskEntry = std::pair<uint64_t, std::shared_ptr<ZRenderTask>>;
-
 public:
 
     ZRenderQueue() { }
@@ -47,19 +45,41 @@ public:
 
     void Initialize();
 
-    bool Empty() { return queue_.empty(); }
+    bool Empty();
+    bool InstancingEnabled() const { return instancingEnabled_; }
+
+    void SetInstancingEnabled(bool enabled) { instancingEnabled_ = enabled; sorted_ = false; }
 
-    void Add(const std::shared_ptr<ZRenderTask>& task);
-    void Submit(bool flush = true);
+    void Add(ZRenderTask* task);
+    void Submit(bool flush = true, uint8_t viewMask = 0xff);
 
     static std::shared_ptr<ZRenderQueue> Create();
 
 protected:
 
-    std::vector<ZRenderTaskEntry> queue_;
+    std::vector<uint64_t> keys_;
+    std::vector<ZRenderTask*> tasks_;
+    std::vector<uint32_t> order_;
+    std::vector<uint32_t> orderScratch_;
+    std::vector<uint32_t> viewOrder_;
+    std::vector<glm::mat4> instanceTransforms_;
+    size_t frameGeneration_ = 0;
+    bool sorted_ = false;
+    bool instancingEnabled_ = true;
     std::shared_ptr<ZRenderStateExecutor> executor_ = nullptr;
 
-    void Execute(const std::shared_ptr<ZRenderTask>& task);
-    uint64_t GenerateKey(const std::shared_ptr<ZRenderTask>& task);
+    static size_t vertexBufferGeneration_;
+    static uint32_t nextVertexBufferId_;
+
+    void Sort();
+    void Clear();
+    void ReleaseStaleTasks();
+    void Execute(ZRenderTask* task);
+    void ExecuteInstanced(const uint32_t* indices, uint32_t count);
+    bool Instanceable(ZRenderTask* task);
+    bool CanInstance(uint32_t first, uint32_t second);
+    uint64_t GenerateKey(ZRenderTask* task);
+    uint32_t VertexBufferId(ZRenderTask* task);
+    uint64_t EncodeDepth(uint32_t depth);
 
 };
\ No newline at end of file
@@ -47,6 +47,7 @@ public:
     void operator()(const ZRenderPipelineState& pipelineState);
     void operator()(const ZRenderResourceState& resourceState);
     void operator()(ZDrawCall drawCall, const std::shared_ptr<ZVertexBuffer>& vertexBuffer);
+    void operator()(ZDrawCall drawCall, const std::shared_ptr<ZVertexBuffer>& vertexBuffer, const std::vector<glm::mat4>& instanceTransforms);
 
     static std::shared_ptr<ZRenderStateExecutor> Create();
 
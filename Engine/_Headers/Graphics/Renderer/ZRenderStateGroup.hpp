@@ -76,6 +76,9 @@ protected:
     uint8_t renderLayer_ = (uint8_t)ZRenderLayer::Null;
     uint32_t renderDepth_ = 0;
 
+    glm::mat4 instanceTransform_ = glm::mat4(1.f);
+    bool hasInstanceTransform_ = false;
+
 };
 
 class ZRenderStateGroupWriter
@@ -101,6 +104,7 @@ public:
     void SetDepthStencilState(const std::initializer_list<ZDepthStencilState>& depthStencilStates);
     void SetFaceCullState(const std::initializer_list<ZFaceCullState>& faceCullStates);
     void SetRenderDepth(uint32_t depth);
+    void SetInstanceTransform(const glm::mat4& transform);
     std::shared_ptr<ZRenderStateGroup> End();
 
 protected:
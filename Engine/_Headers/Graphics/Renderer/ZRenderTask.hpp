@@ -32,11 +32,15 @@
 // Includes
 #include "ZRenderStateGroup.hpp"
 #include "ZDrawCall.hpp"
+#include "ZFrameAllocator.hpp"
 
 class ZRenderQueue;
 class ZRenderPass;
 
-class ZRenderTask : public std::enable_shared_from_this<ZRenderTask>
+// Render tasks only live for the frame they are compiled in. They are allocated from a per-frame
+// linear allocator that is reset once the renderer has flushed every pass, so the pointers returned
+// by Compile must not be held past the end of the frame.
+class ZRenderTask
 {
 
     friend class ZRenderQueue;
@@ -47,8 +51,12 @@ public:
     ~ZRenderTask();
 
     void Submit(const std::initializer_list<std::shared_ptr<ZRenderPass>>& passes);
+    void SetViewMask(uint8_t viewMask) { viewMask_ = viewMask; }
 
-    static std::shared_ptr<ZRenderTask> Compile(ZDrawCall drawCall, const std::initializer_list<std::shared_ptr<ZRenderStateGroup>>& stateStack, const std::shared_ptr<ZRenderPass>& pass = nullptr);
+    static ZRenderTask* Compile(ZDrawCall drawCall, const std::initializer_list<std::shared_ptr<ZRenderStateGroup>>& stateStack, const std::shared_ptr<ZRenderPass>& pass = nullptr);
+
+    static ZFrameAllocator& FrameAllocator();
+    static void ReleaseFrame();
 
 protected:
 
@@ -58,6 +66,11 @@ protected:
     uint8_t fullscreenLayer_ = (uint8_t)ZFullScreenLayer::Null;
     uint8_t renderLayer_ = (uint8_t)ZRenderLayer::Null;
     uint32_t renderDepth_ = 0;
+    // Views of a pass (i.e. shadow cascades) this task is drawn into
+    uint8_t viewMask_ = 0xff;
+
+    glm::mat4 instanceTransform_ = glm::mat4(1.f);
+    bool hasInstanceTransform_ = false;
 
     ZDrawCall drawCall_;
 
@@ -31,6 +31,7 @@
 
 // Includes
 #include "ZRenderPass.hpp"
+#include "ZDebugDraw.hpp"
 
 // Forward Declarations
 class ZFramebuffer;
@@ -48,6 +49,7 @@ public:
     ~ZRenderer() = default;
 
     const std::vector<ZRenderPass::ptr>& Passes() const { return passes_; }
+    ZDebugDraw& DebugDraw() { return debugDraw_; }
 
     void SetTarget(const std::shared_ptr<ZFramebuffer>& target) { target_ = target; }
 
@@ -60,5 +62,6 @@ private:
     std::vector<ZRenderPass::ptr> passes_;
     std::shared_ptr<ZFramebuffer> target_ = nullptr;
     std::shared_ptr<ZScene> scene_ = nullptr;
+    ZDebugDraw debugDraw_;
 
 };
@@ -0,0 +1,91 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZGPUTimer.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+
+// Forward Declarations
+
+// Class and Data Structure Definitions
+
+// Measures GPU execution time of named, nestable scopes. Results are read back a few frames after they
+// were recorded so that collecting them never stalls the pipeline. Scopes are only recorded between
+// BeginFrame and EndFrame, and nested BeginFrame/EndFrame pairs are folded into the outermost one.
+class ZGPUTimer
+{
+
+public:
+
+    static constexpr unsigned int frameLatency = 4;
+
+    ZGPUTimer() { }
+    virtual ~ZGPUTimer() { }
+
+    virtual void BeginFrame() = 0;
+    virtual void EndFrame() = 0;
+    virtual void Begin(const std::string& name) = 0;
+    virtual void End() = 0;
+
+    // Timings of the most recent frame whose results have come back from the GPU
+    const std::vector<ZGPUTiming>& Timings() const { return timings_; }
+
+    static std::shared_ptr<ZGPUTimer> Create();
+
+protected:
+
+    std::vector<ZGPUTiming> timings_;
+
+};
+
+// Used when the platform has no timer queries (headless or software rendering). Scopes are reported
+// with a duration of zero so consumers don't have to special case it.
+class ZNullGPUTimer : public ZGPUTimer
+{
+
+public:
+
+    void BeginFrame() override { if (frameDepth_++ == 0) { recorded_.clear(); depth_ = 0; } }
+    void EndFrame() override
+    {
+        if (frameDepth_ == 0 || --frameDepth_ > 0) return;
+        timings_ = recorded_;
+        ZFrameProfiler::CollectGPUTimings(timings_);
+    }
+    void Begin(const std::string& name) override { if (frameDepth_ > 0) recorded_.push_back({ name, 0.0, depth_++ }); }
+    void End() override { if (frameDepth_ > 0 && depth_ > 0) --depth_; }
+
+private:
+
+    std::vector<ZGPUTiming> recorded_;
+    unsigned int frameDepth_ = 0;
+    unsigned int depth_ = 0;
+
+};
@@ -39,6 +39,9 @@ class ZAABBox;
 class ZVertexBuffer;
 class ZFont;
 class ZRenderStateExecutor;
+class ZGPUTimer;
+class ZShaderCache;
+class ZOcclusionBuffer;
 
 // Class and Data Structure Definitions
 class ZGraphics
@@ -53,12 +56,19 @@ public:
     void UseMotionBlur(bool blur = false) { options_.hasMotionBlur = blur; }
     bool HasPBR() const { return options_.hasPBR; }
     bool HasMotionBlur() const { return options_.hasMotionBlur; }
+    void UseShaderCache(const std::string& path) { options_.shaderCachePath = path; shaderCache_ = nullptr; }
+    void UseOcclusionCulling(bool occlusion = true) { options_.occlusionCulling = occlusion; }
+    bool HasOcclusionCulling() const { return options_.occlusionCulling; }
     std::shared_ptr<ZRenderStateExecutor> Executor();
+    std::shared_ptr<ZGPUTimer> GPUTimer();
+    std::shared_ptr<ZShaderCache> ShaderCache();
+    std::shared_ptr<ZOcclusionBuffer> OcclusionBuffer();
 
     void DebugDraw(const std::shared_ptr<ZScene>& scene, const ZFrustum& frustum, const glm::vec4& color);
     void DebugDraw(const std::shared_ptr<ZScene>& scene, const ZAABBox& aabb, const glm::vec4& color);
     void DebugDrawGrid(const std::shared_ptr<ZScene>& scene, const glm::vec4& color);
     void DebugDrawLine(const std::shared_ptr<ZScene>& scene, const glm::vec3& from, const glm::vec3& to, const glm::vec4& color);
+    void DebugDrawSphere(const std::shared_ptr<ZScene>& scene, const glm::vec3& center, float radius, const glm::vec4& color);
 
     // Platform Graphics
     virtual void Initialize() = 0;
@@ -93,10 +103,14 @@ public:
     virtual void SetBlending(ZBlendMode blendMode) = 0;
 
     virtual void Draw(const std::shared_ptr<ZVertexBuffer>& bufferData, ZMeshDrawStyle drawStyle = ZMeshDrawStyle::Triangle) = 0;
+    virtual void DrawInstanced(const std::shared_ptr<ZVertexBuffer>& bufferData, unsigned int instanceCount, ZMeshDrawStyle drawStyle = ZMeshDrawStyle::Triangle) = 0;
 
 protected:
 
     ZGraphicsOptions options_;
     std::shared_ptr<ZRenderStateExecutor> executor_;
+    std::shared_ptr<ZGPUTimer> gpuTimer_;
+    std::shared_ptr<ZShaderCache> shaderCache_;
+    std::shared_ptr<ZOcclusionBuffer> occlusionBuffer_;
 
 };
@@ -105,6 +105,7 @@ public:
     bool Instanced() const { return vertexData_.instanced.count > 1; }
 
     void SetInstanceData(const ZInstancedDataOptions& data);
+    void UpdateInstances(const glm::mat4* transforms, unsigned int count);
     void SetVertices(const ZVertex3DList& data);
     void SetIndices(const std::vector<unsigned int>& data);
 
@@ -0,0 +1,72 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZOcclusionBuffer.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+
+// Forward Declarations
+class ZTexture;
+
+// Class and Data Structure Definitions
+
+// Reduces a depth buffer to a small square grid holding the farthest depth under each cell and reads it back
+// to the CPU a few frames later, so that occlusion can be tested without waiting on the frame that produced it.
+class ZOcclusionBuffer
+{
+
+public:
+
+    static constexpr unsigned int frameLatency = 3;
+    // Must be a power of two so the CPU side can halve it down to a single texel
+    static constexpr unsigned int resolution = 256;
+
+    ZOcclusionBuffer() { }
+    virtual ~ZOcclusionBuffer() { }
+
+    // Queues a reduction of the given depth texture, rendered with the given view projection
+    virtual void Capture(const std::shared_ptr<ZTexture>& depth, const glm::mat4& viewProjection) = 0;
+    // Fetches the newest capture that has finished since the last call. Returns false if there is none.
+    virtual bool Read(std::vector<float>& outDepth, glm::mat4& outViewProjection) = 0;
+
+    static std::shared_ptr<ZOcclusionBuffer> Create();
+
+};
+
+// Used when the platform can't read back asynchronously. Nothing is ever captured, so nothing is ever occluded.
+class ZNullOcclusionBuffer : public ZOcclusionBuffer
+{
+
+public:
+
+    void Capture(const std::shared_ptr<ZTexture>&, const glm::mat4&) override { }
+    bool Read(std::vector<float>&, glm::mat4&) override { return false; }
+
+};
@@ -38,10 +38,25 @@ class ZTexture;
 class ZResourceLoadedEvent;
 
 // Class and Data Structure Definitions
+struct ZUniformHandle
+{
+    int location = -1;
+
+    bool Valid() const { return location != -1; }
+};
+
 class ZShader : public std::enable_shared_from_this<ZShader>
 {
 
     using AttachmentsMap = std::unordered_map<std::string, std::shared_ptr<ZTexture>>;
+    using UniformMap = std::unordered_map<std::string, int>;
+
+    struct ZSamplerSlot
+    {
+        std::string name;
+        int location = -1;
+    };
+    using SamplerMap = std::unordered_map<std::string, std::vector<ZSamplerSlot>>;
 
 public:
 
@@ -54,10 +69,13 @@ public:
     unsigned int ID() const { return id_; }
     const std::string& Name() const { return name_; }
     const AttachmentsMap& Attachments() const { return attachments_; }
+    bool Instanceable() const { return instanceable_; }
 
     void Activate();
     void Validate();
 
+    ZUniformHandle Uniform(const std::string& name) const;
+
     // Helpers for setting uniforms
     void SetBool(const std::string& name, bool value) const;
     void SetInt(const std::string& name, int value) const;
@@ -75,12 +93,26 @@ public:
     void SetFloatList(const std::string& name, const std::vector<float>& value) const;
     void SetMat4List(const std::string& name, const std::vector<glm::mat4>& value) const;
 
+    // Helpers for setting uniforms through handles resolved ahead of time with Uniform()
+    void SetBool(ZUniformHandle handle, bool value) const;
+    void SetInt(ZUniformHandle handle, int value) const;
+    void SetFloat(ZUniformHandle handle, float value) const;
+    void SetVec2(ZUniformHandle handle, const glm::vec2& value) const;
+    void SetVec3(ZUniformHandle handle, const glm::vec3& value) const;
+    void SetVec4(ZUniformHandle handle, const glm::vec4& value) const;
+    void SetMat2(ZUniformHandle handle, const glm::mat2& value) const;
+    void SetMat3(ZUniformHandle handle, const glm::mat3& value) const;
+    void SetMat4(ZUniformHandle handle, const glm::mat4& value) const;
+    void SetFloatList(ZUniformHandle handle, const std::vector<float>& value) const;
+    void SetMat4List(ZUniformHandle handle, const std::vector<glm::mat4>& value) const;
+
     void Use(const std::shared_ptr<ZMaterial>& material);
     void Use(const ZLightMap& lights);
     void Use(const ZBoneList& bones);
 
     void BindAttachments();
     void BindAttachment(const std::string& uniformName, const std::shared_ptr<ZTexture>& attachment);
+    void BindSampler(const std::string& type, unsigned int index, const std::shared_ptr<ZTexture>& attachment);
 
     void SetAttachments(const AttachmentsMap& attachments) { attachments_ = attachments; }
     void AddAttachment(const std::string& uniformName, const std::shared_ptr<ZTexture>& attachment) { attachments_[uniformName] = attachment; }
@@ -96,7 +128,7 @@ protected:
 
 private:
 
-    unsigned int id_;
+    unsigned int id_ = 0;
     std::string name_;
 
     std::string vertexShaderPath_;
@@ -108,10 +140,15 @@ private:
     std::string geometryShaderCode_;
 
     unsigned short loadedShadersMask_;
+    bool instanceable_ = false;
 
     unsigned int attachmentIndex_ = 0;
     AttachmentsMap attachments_;
 
+    UniformMap uniforms_;
+    SamplerMap samplers_;
+
+    void LoadSources();
     std::string GetShaderCode(const std::string& shaderPath, ZShaderType shaderType, bool async = false);
     void ProcessIncludes(std::string& shaderCode);
 
@@ -119,7 +156,9 @@ private:
     int CompileShader(const std::string& shaderCode, ZShaderType shaderType);
     void CheckCompileErrors(unsigned int compilationUnit, ZShaderType shaderType, const std::string& shaderSource);
 
-    unsigned int CreateProgram(int vShader, int pShader, int gShader);
+    unsigned int CreateProgram(int vShader, int pShader, int gShader, bool retrievable = false);
+    void Reflect();
+    void BindAttachment(const std::string& uniformName, ZUniformHandle handle, const std::shared_ptr<ZTexture>& attachment);
 
     void HandleShaderCodeLoaded(const std::shared_ptr<ZResourceLoadedEvent>& event);
 
@@ -0,0 +1,77 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZShaderCache.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+
+// Forward Declarations
+
+// Class and Data Structure Definitions
+
+// Persists linked program binaries to disk so shaders don't have to be recompiled from source on every run.
+// Entries are keyed by a hash of the preprocessed shader sources and the driver identity, so a driver update
+// or a shader edit simply misses the cache and falls back to a regular compile.
+class ZShaderCache
+{
+
+public:
+
+    ZShaderCache(const std::string& directory) : directory_(directory) { }
+    ~ZShaderCache() = default;
+
+    void Initialize();
+
+    bool Enabled() const { return enabled_; }
+
+    std::string Key(const std::string& vertexCode, const std::string& pixelCode, const std::string& geometryCode) const;
+    unsigned int Load(const std::string& key);
+    void Store(const std::string& key, unsigned int programId);
+
+    static std::shared_ptr<ZShaderCache> Create(const std::string& directory);
+
+private:
+
+    struct ZProgramBinaryHeader
+    {
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint32_t format = 0;
+        uint32_t length = 0;
+        uint64_t key = 0;
+    };
+
+    std::string directory_;
+    std::string driverIdentity_;
+    bool enabled_ = false;
+
+    std::string PathForKey(const std::string& key) const;
+
+};
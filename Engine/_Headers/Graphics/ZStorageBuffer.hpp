@@ -0,0 +1,73 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZStorageBuffer.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+
+enum class ZStorageBufferType
+{
+    None = 0, Lights, LightClusters, LightIndices, Last, UserDefined = Last
+};
+
+// A buffer shaders can index without a fixed size, for data whose length changes from frame to frame
+class ZStorageBuffer
+{
+
+public:
+
+    using ptr = std::shared_ptr<ZStorageBuffer>;
+
+    ZStorageBuffer(uint16_t index)
+        : index_(index)
+    { }
+    virtual ~ZStorageBuffer() {}
+
+    uint16_t Index() const { return index_; }
+    unsigned int Size() const { return size_; }
+
+    virtual void Bind() = 0;
+    virtual void Unbind() = 0;
+    virtual void Load(unsigned int size) = 0;
+    virtual void Update(unsigned int offset, unsigned int size, const void* data) = 0;
+    // Replaces the contents of the buffer, growing it first if the data doesn't fit
+    virtual void Upload(unsigned int size, const void* data) = 0;
+    virtual void Delete() = 0;
+
+    static ptr Create(uint16_t index, unsigned int size);
+    static ptr Create(ZStorageBufferType type, unsigned int size);
+
+protected:
+
+    unsigned int ssbo_ = 0;
+    unsigned int size_ = 0;
+    uint16_t index_;
+
+};
@@ -47,6 +47,10 @@ public:
     unsigned int indexCount = 0;
     unsigned int instanceCount = 0;
 
+    // Dense id the render queues sort draws of this buffer by, valid for the frame it was stamped in
+    uint32_t sortId = 0;
+    size_t sortGeneration = std::numeric_limits<size_t>::max();
+
     ZVertexBuffer() {}
     virtual ~ZVertexBuffer() {}
 
@@ -54,12 +58,16 @@ public:
     virtual void Unbind() = 0;
     virtual void Load(const ZVertex2DDataOptions& vertexData) = 0;
     virtual void Load(const ZVertex3DDataOptions& vertexData) = 0;
+    virtual void Load(const ZDebugVertexDataOptions& vertexData) = 0;
     virtual void Update(const ZVertex2DDataOptions& vertexData) = 0;
     virtual void Update(const ZVertex3DDataOptions& vertexData) = 0;
+    virtual void Update(const ZDebugVertexDataOptions& vertexData) = 0;
+    virtual void UpdateInstances(const glm::mat4* transforms, unsigned int count) = 0;
     virtual void Delete() = 0;
 
     static ptr Create(const ZVertex3DDataOptions& options);
     static ptr Create(const ZVertex2DDataOptions& options);
+    static ptr Create(const ZDebugVertexDataOptions& options);
 
 protected:
 
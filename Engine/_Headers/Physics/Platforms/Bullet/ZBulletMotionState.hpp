@@ -0,0 +1,77 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZBulletMotionState.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+#include "btBulletDynamicsCommon.h"
+
+// Forward Declarations
+
+// Class and Data Structure Definitions
+
+// Bullet only writes the motion states of bodies that are awake, so a motion state that has been written
+// to since the last sync is exactly a body whose game object needs a new transform. Once a body is in a
+// world it queues itself on the world's moved list the first time it is written each step.
+class ZBulletMotionState : public btDefaultMotionState
+{
+
+public:
+
+    ZBulletMotionState(const btTransform& startTransform = btTransform::getIdentity())
+        : btDefaultMotionState(startTransform) { }
+    ~ZBulletMotionState() { }
+
+    void setWorldTransform(const btTransform& centerOfMassWorldTrans) override
+    {
+        btDefaultMotionState::setWorldTransform(centerOfMassWorldTrans);
+        // Transforms set outside of a step (i.e. moving a static body) leave the query tree's bounds stale
+        if (boundsDirty_) *boundsDirty_ = true;
+        if (movedList_ && !moved_) {
+            moved_ = true;
+            movedList_->push_back(this);
+        }
+    }
+
+    btRigidBody* Body() const { return body_; }
+    bool Moved() const { return moved_; }
+
+    void Attach(btRigidBody* body, std::vector<ZBulletMotionState*>* movedList, bool* boundsDirty) { body_ = body; movedList_ = movedList; boundsDirty_ = boundsDirty; }
+    void Detach() { body_ = nullptr; movedList_ = nullptr; boundsDirty_ = nullptr; moved_ = false; }
+    void ClearMoved() { moved_ = false; }
+
+protected:
+
+    btRigidBody* body_ = nullptr;
+    std::vector<ZBulletMotionState*>* movedList_ = nullptr;
+    bool* boundsDirty_ = nullptr;
+    bool moved_ = false;
+
+};
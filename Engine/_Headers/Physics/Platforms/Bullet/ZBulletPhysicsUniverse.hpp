@@ -36,6 +36,8 @@
 
 // Forward Declarations
 class ZScene;
+class ZBulletTaskScheduler;
+class ZBulletMotionState;
 
 // Class and Data Structure Definitions
 class ZBulletPhysicsUniverse : public ZPhysicsUniverse, public btIDebugDraw
@@ -43,7 +45,7 @@ class ZBulletPhysicsUniverse : public ZPhysicsUniverse, public btIDebugDraw
 
 public:
 
-    ZBulletPhysicsUniverse() {}
+    ZBulletPhysicsUniverse(const ZPhysicsOptions& options = ZPhysicsOptions()) : ZPhysicsUniverse(options) {}
     ~ZBulletPhysicsUniverse() {}
 
     void Initialize() override;
@@ -56,6 +58,12 @@ public:
 
     ZRaycastHitResult Raycast(const glm::vec3& start, const glm::vec3& direction, float t = 100.f) override;
 
+    void Raycast(const std::vector<ZRayQuery>& queries, std::vector<ZPhysicsQueryHit>& hits, const ZPhysicsQueryOptions& options = ZPhysicsQueryOptions()) override;
+    void Sweep(const std::vector<ZSweepQuery>& queries, std::vector<ZPhysicsQueryHit>& hits, const ZPhysicsQueryOptions& options = ZPhysicsQueryOptions()) override;
+    void Overlap(const std::vector<ZOverlapQuery>& queries, std::vector<ZPhysicsQueryHit>& hits, const ZPhysicsQueryOptions& options = ZPhysicsQueryOptions()) override;
+
+    ZGameObject* BodyObject(ZPhysicsBodyHandle handle) const override;
+
     void DebugDraw(const std::shared_ptr<ZScene>& scene) override;
 
     void CleanUp() override;
@@ -76,10 +84,38 @@ private:
     std::shared_ptr<btDefaultCollisionConfiguration> collisionConfig_ = nullptr;
     std::shared_ptr<btCollisionDispatcher> dispatcher_ = nullptr;
     std::shared_ptr<btBroadphaseInterface> overlappingPairCache_ = nullptr;
-    std::shared_ptr<btSequentialImpulseConstraintSolver> solver_ = nullptr;
+    std::shared_ptr<ZBulletTaskScheduler> taskScheduler_ = nullptr;
+    std::shared_ptr<btConstraintSolver> solver_ = nullptr;
     std::shared_ptr<btDiscreteDynamicsWorld> dynamicsWorld_ = nullptr;
     int debugMode_ = 0;
 
+    // Body transforms from before the latest fixed step, indexed like the world's collision objects. Only
+    // kept in interpolation mode, and cleared whenever bodies are added or removed.
+    btAlignedObjectArray<btTransform> previousTransforms_;
+    double stepRemainder_ = 0.0;
+
+    // Motion states written since the last sync, which are the only game objects that need new transforms
+    std::vector<ZBulletMotionState*> movedMotionStates_;
+
+    std::unordered_map<ZPhysicsBodyHandle, btCollisionObject*> bodies_;
+    ZPhysicsBodyHandle nextBodyHandle_ = 0;
+
+    // Batched queries walk their own copy of the broadphase bounds, since the world's ray test keeps a shared
+    // traversal stack and can't be called from several threads. The copy is rebuilt lazily after a step, after
+    // bodies are added or removed, or after any body's motion state is written.
+    btDbvt queryTree_;
+    bool queryTreeDirty_ = true;
+
+    static constexpr unsigned int cQueryBatchSize = 64;
+
+    void UpdateQueryTree();
+    void InterpolateMotionStates(float alpha);
+    void SyncMovedBodies();
+
+    template<class Query, class Function>
+    void RunQueries(const std::vector<Query>& queries, std::vector<ZPhysicsQueryHit>& hits, bool parallel, const Function& query);
+
     static void TickCallback(btDynamicsWorld* world, btScalar timeStep);
+    static void PreTickCallback(btDynamicsWorld* world, btScalar timeStep);
 
 };
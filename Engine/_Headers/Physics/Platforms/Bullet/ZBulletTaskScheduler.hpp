@@ -0,0 +1,65 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZBulletTaskScheduler.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+#include "LinearMath/btThreads.h"
+
+// Forward Declarations
+
+// Class and Data Structure Definitions
+
+// Runs Bullet's parallel loops on the engine job system. Each loop is split into at most as many jobs as the
+// scheduler has threads, so the simulation never floods the workers that rendering and gameplay also share.
+class ZBulletTaskScheduler : public btITaskScheduler
+{
+
+public:
+
+    ZBulletTaskScheduler(unsigned int maxThreads = 0);
+    ~ZBulletTaskScheduler() {}
+
+    int getMaxNumThreads() const override { return maxThreads_; }
+    int getNumThreads() const override { return numThreads_; }
+    void setNumThreads(int numThreads) override;
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+protected:
+
+    int maxThreads_ = 1;
+    int numThreads_ = 1;
+    std::vector<btScalar> partialSums_;
+
+    int BatchCount(int iBegin, int iEnd, int grainSize) const;
+
+};
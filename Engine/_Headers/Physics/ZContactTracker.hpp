@@ -0,0 +1,89 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZContactTracker.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+
+// Forward Declarations
+
+// Class and Data Structure Definitions
+
+// Finds the body pairs that started and stopped touching between two physics ticks. Pairs are stored in
+// two open addressing tables, one for this tick and one for the last, that swap every tick. Entries are
+// stamped with the generation of the tick that wrote them, so a table is cleared by bumping its generation
+// and finding ended pairs is one pass over the previous table. Nothing is allocated once the tables have
+// grown to fit the largest contact count seen.
+class ZContactTracker
+{
+
+public:
+
+    ZContactTracker() = default;
+    ~ZContactTracker() = default;
+
+    void BeginTick();
+    void Add(uint32_t bodyA, uint32_t bodyB, const ZCollisionPair& pair);
+    void EndTick();
+
+    unsigned int Count() const { return tables_[current_].count; }
+    const ZCollisionPairList& Began() const { return began_; }
+    const ZCollisionPairList& Ended() const { return ended_; }
+
+protected:
+
+    struct ZContactEntry
+    {
+        uint64_t key = 0;
+        uint32_t generation = 0;
+        ZCollisionPair pair;
+    };
+
+    struct ZContactTable
+    {
+        std::vector<ZContactEntry> entries;
+        uint32_t generation = 0;
+        unsigned int count = 0;
+    };
+
+    static constexpr unsigned int cInitialCapacity = 64;
+
+    std::array<ZContactTable, 2> tables_;
+    unsigned int current_ = 0;
+    uint32_t generation_ = 0;
+    ZCollisionPairList began_;
+    ZCollisionPairList ended_;
+
+    static uint64_t Hash(uint64_t key);
+    static const ZContactEntry* Find(const ZContactTable& table, uint64_t key);
+    static ZContactEntry* Insert(ZContactTable& table, uint64_t key, bool& inserted);
+    static void Grow(ZContactTable& table);
+
+};
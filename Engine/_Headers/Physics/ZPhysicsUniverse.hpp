@@ -31,16 +31,62 @@
 
 // Includes
 #include "ZProcess.hpp"
+#include "ZContactTracker.hpp"
 
 // Forward Declarations
 class ZRigidBody;
 
 // Class and Data Structure Definitions
+using ZPhysicsBodyHandle = int;
+
+constexpr ZPhysicsBodyHandle INVALID_BODY_HANDLE = -1;
+
+struct ZRayQuery
+{
+    glm::vec3 start;
+    glm::vec3 end;
+};
+
+struct ZSweepQuery
+{
+    ZColliderType shape;
+    glm::vec3 extents;
+    glm::vec3 start;
+    glm::vec3 end;
+    glm::quat orientation = glm::quat(1.f, 0.f, 0.f, 0.f);
+};
+
+struct ZOverlapQuery
+{
+    ZColliderType shape;
+    glm::vec3 extents;
+    glm::vec3 position;
+    glm::quat orientation = glm::quat(1.f, 0.f, 0.f, 0.f);
+};
+
+// Ray and sweep queries report their closest hit, overlap queries report every body they touch.
+// Hits are ordered by the index of the query that produced them.
+struct ZPhysicsQueryHit
+{
+    unsigned int query;
+    ZPhysicsBodyHandle body;
+    glm::vec3 position;
+    glm::vec3 normal;
+    float fraction;
+};
+
+struct ZPhysicsQueryOptions
+{
+    int mask = static_cast<int>(ZPhysicsBodyType::All) & ~static_cast<int>(ZPhysicsBodyType::Trigger);
+    bool parallel = true;
+};
+
 class ZPhysicsUniverse : public ZProcess
 {
 
 public:
 
+    ZPhysicsUniverse(const ZPhysicsOptions& options = ZPhysicsOptions()) : options_(options) {}
     virtual ~ZPhysicsUniverse() {}
 
     virtual void Initialize() override;
@@ -55,10 +101,21 @@ public:
 
     virtual ZRaycastHitResult Raycast(const glm::vec3& start, const glm::vec3& direction, float t = 100.f) = 0;
 
+    // Batched queries run synchronously and can be split across the job system workers. Bounds are tested
+    // against a copy of every body's AABB that is rebuilt at the start of a batch if any body was stepped,
+    // added, removed or moved since the last batch. Only the bounds are copied, and the narrow phase reads
+    // live body transforms, so batches must be issued from the main thread and never overlap a step.
+    virtual void Raycast(const std::vector<ZRayQuery>& queries, std::vector<ZPhysicsQueryHit>& hits, const ZPhysicsQueryOptions& options = ZPhysicsQueryOptions()) = 0;
+    virtual void Sweep(const std::vector<ZSweepQuery>& queries, std::vector<ZPhysicsQueryHit>& hits, const ZPhysicsQueryOptions& options = ZPhysicsQueryOptions()) = 0;
+    virtual void Overlap(const std::vector<ZOverlapQuery>& queries, std::vector<ZPhysicsQueryHit>& hits, const ZPhysicsQueryOptions& options = ZPhysicsQueryOptions()) = 0;
+
+    virtual ZGameObject* BodyObject(ZPhysicsBodyHandle handle) const = 0;
+
     virtual void DebugDraw(const std::shared_ptr<ZScene>& scene) = 0;
 
 protected:
 
-    ZCollisionPairs previousTickCollisionPairs_;
+    ZPhysicsOptions options_;
+    ZContactTracker contacts_;
 
 };
@@ -36,24 +36,23 @@
 // class SomeClass;
 
 // Class and Data Structure Definitions
+// Runs its work on the shared job system instead of a dedicated thread. The process finishes
+// on the first update after Run has returned.
 class ZConcurrentWorker : public ZProcess, public std::enable_shared_from_this<ZConcurrentWorker>
 {
 
-private:
-
-    static void ThreadStarter(std::shared_ptr<ZConcurrentWorker> process);
-
 public:
 
     ZConcurrentWorker() { }
-    virtual ~ZConcurrentWorker() { if (processThread_.joinable()) processThread_.join(); }
+    virtual ~ZConcurrentWorker() { }
 
     void Initialize() override;
+    void Update(double deltaTime) override;
     void Start();
 
 protected:
 
-    std::thread processThread_;
+    std::atomic_bool complete_{ false };
 
     virtual void Run() = 0;
 
@@ -0,0 +1,116 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZJobSystem.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+
+// Forward Declarations
+class ZJobCounter;
+
+// Class and Data Structure Definitions
+using ZJob = std::function<void()>;
+
+struct ZJobEntry
+{
+    ZJob function;
+    std::shared_ptr<ZJobCounter> counter = nullptr;
+};
+
+// Counts the number of outstanding jobs in a batch. Jobs scheduled with a counter as their dependency are held
+// back until the counter reaches zero, at which point they are handed to the workers.
+class ZJobCounter
+{
+
+    friend class ZJobSystem;
+
+public:
+
+    ZJobCounter() = default;
+    ~ZJobCounter() = default;
+
+    int Value() const { return count_.load(std::memory_order_acquire); }
+    bool Done() const { return Value() == 0; }
+
+protected:
+
+    std::atomic_int count_{ 0 };
+    std::mutex mutex_;
+    std::vector<ZJobEntry> continuations_;
+
+};
+
+// A fixed size pool of worker threads, each with its own job deque. Workers pop their own jobs LIFO and
+// steal from the front of other workers' deques when they run dry. Jobs scheduled before Initialize or
+// after CleanUp are run inline on the scheduling thread.
+class ZJobSystem
+{
+
+public:
+
+    ZJobSystem(unsigned int threadCount = 0);
+    ~ZJobSystem();
+
+    void Initialize();
+    void CleanUp();
+
+    unsigned int ThreadCount() const { return static_cast<unsigned int>(workers_.size()); }
+
+    std::shared_ptr<ZJobCounter> Schedule(const ZJob& job, const std::shared_ptr<ZJobCounter>& dependency = nullptr, std::shared_ptr<ZJobCounter> counter = nullptr);
+    std::shared_ptr<ZJobCounter> Schedule(const std::vector<ZJob>& jobs, const std::shared_ptr<ZJobCounter>& dependency = nullptr, std::shared_ptr<ZJobCounter> counter = nullptr);
+    void Wait(const std::shared_ptr<ZJobCounter>& counter);
+
+protected:
+
+    struct ZJobQueue
+    {
+        std::mutex mutex;
+        std::deque<ZJobEntry> jobs;
+    };
+
+    unsigned int requestedThreadCount_ = 0;
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<ZJobQueue>> queues_;
+    std::atomic_uint nextQueue_{ 0 };
+    std::atomic_int pendingJobs_{ 0 };
+    std::atomic_bool running_{ false };
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+    std::condition_variable waitCondition_;
+
+    void WorkerLoop(unsigned int index);
+    void Enqueue(ZJobEntry&& entry);
+    void Enqueue(ZJobEntry&& entry, const std::shared_ptr<ZJobCounter>& dependency);
+    bool Pop(unsigned int index, ZJobEntry& outEntry);
+    bool Steal(unsigned int index, ZJobEntry& outEntry);
+    bool RunOne(unsigned int index);
+    void Complete(const std::shared_ptr<ZJobCounter>& counter);
+
+};
@@ -31,12 +31,22 @@
 
 // Includes
 #include "ZResourceFile.hpp"
+#include "ZMappedFile.hpp"
 #include "zip.h"
 
 // Forward Declarations
 //class SomeClass;
 
 // Class and Data Structure Definitions
+struct ZZipEntry
+{
+    std::string name;
+    size_t size = 0;
+    size_t compressedSize = 0;
+    size_t headerOffset = 0;
+    bool stored = false;
+};
+
 class ZZipFile : public ZResourceFile
 {
 
@@ -44,6 +54,9 @@ private:
 
     struct zip_t* zipFile_ = nullptr;
     std::string fileName_;
+    ZMappedFile archive_;
+    std::vector<ZZipEntry> entries_;
+    std::unordered_map<std::string, unsigned int> entryIndices_;
 
 public:
 
@@ -60,4 +73,11 @@ public:
 
 protected:
 
+    bool IndexCentralDirectory();
+    void IndexEntries();
+    const ZZipEntry* FindEntry(const std::string& name) const;
+    const char* StoredEntryData(const ZZipEntry& entry) const;
+
+    static std::string NormalizedName(const std::string& name);
+
 };
@@ -0,0 +1,69 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZMappedFile.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+
+// Forward Declarations
+
+// Class and Data Structure Definitions
+
+// A read-only view of a whole file mapped into memory. Pages are only read from disk when they are first
+// touched, so mapping a large archive to read a handful of entries is cheap.
+class ZMappedFile
+{
+
+public:
+
+    ZMappedFile() = default;
+    ZMappedFile(const ZMappedFile&) = delete;
+    ZMappedFile& operator=(const ZMappedFile&) = delete;
+    ~ZMappedFile() { Close(); }
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return open_; }
+    const char* Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+protected:
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+
+#if defined _WIN64 || defined _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+
+};
@@ -33,16 +33,30 @@
 #include "ZResourceHandle.hpp"
 #include "ZResourceLoader.hpp"
 #include "ZResourceFile.hpp"
+#include "ZSlabAllocator.hpp"
 
 // Forward Declarations
 class ZResource;
 
 // Class and Data Structure Definitions
-using ResourceHandleList = std::list<std::shared_ptr<ZResourceHandle>>;
-using ResourceHandleMap = std::map<std::string, std::shared_ptr<ZResourceHandle>>;
+using ResourceHandleMap = std::unordered_map<std::string, std::shared_ptr<ZResourceHandle>>;
 using ResourceFileMap = std::map<std::string, std::shared_ptr<ZResourceFile>>;
 using ResourceLoaderList = std::list<std::shared_ptr<ZResourceLoader>>;
 
+struct ZResourceCacheStats
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t resourceCount = 0;
+    unsigned int allocated = 0;
+    unsigned int capacity = 0;
+    ZSlabAllocatorStats memory;
+};
+
+// Resources are looked up through a hash table of handles. Each handle carries intrusive links into the LRU
+// list, so touching and evicting a resource are both constant time. Resource payloads are allocated from a slab
+// allocator, and the cache budget is enforced against the requested payload sizes.
 class ZResourceCache
 {
 
@@ -50,12 +64,9 @@ private:
 
     struct
     {
-        std::mutex allocated;
-        std::mutex lru;
         std::mutex resources;
         std::mutex resourceFiles;
         std::mutex resourceLoaders;
-        std::mutex all;
     } mutexes_;
 
 public:
@@ -73,23 +84,37 @@ public:
     int Preload(const std::string& pattern, void(*progressCallback)(int, bool&));
     void Flush();
     void FreeMemory(unsigned int size);
+    ZResourceCacheStats Stats();
 
 protected:
 
-    ResourceHandleList lru_;
     ResourceHandleMap resources_;
     ResourceLoaderList resourceLoaders_;
     ResourceFileMap resourceFiles_;
+    // Reads are serialized per resource file, so loads from different files don't wait on each other
+    std::map<std::string, std::shared_ptr<std::mutex>> resourceFileMutexes_;
+    std::shared_ptr<ZSlabAllocator> allocator_;
+
+    // Most recently used handle at the head, eviction candidate at the tail
+    ZResourceHandle* lruHead_ = nullptr;
+    ZResourceHandle* lruTail_ = nullptr;
 
     unsigned int cacheSize_;
     unsigned int allocated_;
 
+    std::atomic<uint64_t> hits_{ 0 };
+    std::atomic<uint64_t> misses_{ 0 };
+    std::atomic<uint64_t> evictions_{ 0 };
+
     std::shared_ptr<ZResourceHandle> Find(ZResource* resource);
-    const void Update(std::shared_ptr<ZResourceHandle> handle);
+    void Update(const std::shared_ptr<ZResourceHandle>& handle);
     std::shared_ptr<ZResourceHandle> Load(ZResource* resource);
     void Free(std::shared_ptr<ZResourceHandle> handle);
     bool MatchPattern(const std::string& pattern, const std::string& str);
 
+    void LinkFront(ZResourceHandle* handle);
+    void Unlink(ZResourceHandle* handle);
+
     bool MakeRoom(unsigned int size);
     char* Allocate(unsigned int size);
     void FreeOneResource();
@@ -38,6 +38,7 @@ class ZWavResourceLoader;
 class ZOggResourceLoader;
 class ZResourceLoadTask;
 class ZImageImporter;
+class ZOFBinaryTree;
 struct ZSkeleton;
 
 // Class and Data Structure Definitions
@@ -109,11 +110,17 @@ public:
     ~ZZOFResourceExtraData() {}
 
     std::string ToString() override { return "ZZOFResourceExtraData"; }
-    std::shared_ptr<ZOFTree> ObjectTree() { return objectTree_; }
+    // Compiled files are only converted to a ZOFTree the first time the tree is asked for
+    std::shared_ptr<ZOFTree> ObjectTree();
+    // View over a compiled file's buffer, or null if the resource was text. Only valid while the
+    // owning resource handle is alive.
+    std::shared_ptr<ZOFBinaryTree> BinaryTree() { return binaryTree_; }
 
 protected:
 
     std::shared_ptr<ZOFTree> objectTree_;
+    std::shared_ptr<ZOFBinaryTree> binaryTree_;
+    std::mutex treeMutex_;
 
 };
 
@@ -35,6 +35,7 @@
 // Forward Declarations
 class ZResourceCache;
 class ZResourceExtraData;
+class ZSlabAllocator;
 
 // Class and Data Structure Definitions
 class ZResourceHandle
@@ -46,7 +47,7 @@ private:
 
 public:
 
-    ZResourceHandle(ZResource& resource, void* buffer, unsigned int size, ZResourceCache* resourceCache);
+    ZResourceHandle(ZResource& resource, void* buffer, unsigned int size, ZResourceCache* resourceCache, const std::shared_ptr<ZSlabAllocator>& allocator = nullptr);
     virtual ~ZResourceHandle();
 
     ZResource& Resource() { return resource_; }
@@ -63,6 +64,11 @@ protected:
     void* buffer_ = nullptr;
     unsigned int size_;
     ZResourceCache* resourceCache_ = nullptr;
+    std::shared_ptr<ZSlabAllocator> allocator_;
     std::shared_ptr<ZResourceExtraData> extraData_;
 
+    // Intrusive links into the resource cache's LRU list
+    ZResourceHandle* lruPrevious_ = nullptr;
+    ZResourceHandle* lruNext_ = nullptr;
+
 };
@@ -0,0 +1,95 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZFrameAllocator.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+
+// Class and Data Structure Definitions
+
+// Linear allocator for objects that only live for a single frame. Memory is handed out by
+// bumping an offset into a set of blocks that are kept around between frames, so once the
+// allocator has warmed up a frame's worth of allocations never touches the heap. Objects
+// with non-trivial destructors are destroyed in reverse order when the allocator is reset.
+class ZFrameAllocator
+{
+
+public:
+
+    ZFrameAllocator(size_t blockSize = 64 * 1024) : blockSize_(blockSize) { }
+    ~ZFrameAllocator();
+
+    size_t Generation() const { return generation_; }
+    size_t Allocated() const { return allocated_; }
+    size_t Capacity() const;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    void Reset();
+
+    template<class T, typename... Args>
+    T* New(Args&&... args)
+    {
+        T* object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            destructors_.push_back({ object, [](void* p) { static_cast<T*>(p)->~T(); } });
+        }
+        return object;
+    }
+
+    template<class T>
+    T* NewArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "Frame allocated arrays must be trivially destructible");
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+private:
+
+    struct Block
+    {
+        std::unique_ptr<char[]> memory;
+        size_t size;
+    };
+
+    struct Destructor
+    {
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    std::vector<Block> blocks_;
+    std::vector<Destructor> destructors_;
+    size_t blockSize_;
+    size_t currentBlock_ = 0;
+    size_t offset_ = 0;
+    size_t allocated_ = 0;
+    size_t generation_ = 0;
+
+};
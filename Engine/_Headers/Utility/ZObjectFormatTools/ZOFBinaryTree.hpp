@@ -0,0 +1,132 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZOFBinaryTree.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZOFTree.hpp"
+
+// Forward Declarations
+
+// Class and Data Structure Definitions
+
+// Read-only view over a compiled .zofb buffer. Every id, property key and string value is interned into a
+// single string table, and nodes, properties and values are stored as flat arrays that reference each other
+// by index. The children of a node and the properties of an object are contiguous. Nothing is copied on load,
+// so a buffer passed by pointer must outlive the view.
+class ZOFBinaryTree
+{
+
+public:
+
+    static const uint32_t Version = 1;
+
+    enum class ValueType : uint32_t
+    {
+        Number, String, NumberList, StringList
+    };
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t size;
+        uint32_t stringCount, stringOffset;
+        uint32_t characterCount, characterOffset;
+        uint32_t nodeCount, nodeOffset;
+        uint32_t propertyCount, propertyOffset;
+        uint32_t valueCount, valueOffset;
+        uint32_t numberCount, numberOffset;
+        uint32_t stringReferenceCount, stringReferenceOffset;
+    };
+
+    struct StringEntry
+    {
+        uint32_t offset, length;
+    };
+
+    struct Node
+    {
+        uint32_t id;
+        uint32_t firstChild, childCount;
+        uint32_t firstProperty, propertyCount;
+    };
+
+    struct Property
+    {
+        uint32_t key;
+        uint32_t firstValue, valueCount;
+    };
+
+    // Numbers and strings index into the number and string tables directly, lists index into the
+    // number table or the string reference table respectively.
+    struct Value
+    {
+        ValueType type;
+        uint32_t first, count;
+    };
+
+    ZOFBinaryTree() = default;
+    ~ZOFBinaryTree() = default;
+
+    bool Load(const char* data, size_t size);
+    bool Load(std::vector<char>&& data);
+    bool Valid() const { return header_ != nullptr; }
+
+    std::string_view String(uint32_t index) const;
+
+    const Node& Root() const { return nodes_[0]; }
+    const Node& Child(const Node& node, uint32_t index) const { return nodes_[node.firstChild + index]; }
+    const Property& NodeProperty(const Node& node, uint32_t index) const { return properties_[node.firstProperty + index]; }
+    const Property* FindProperty(const Node& node, std::string_view key) const;
+    const Value& PropertyValue(const Property& property, uint32_t index) const { return values_[property.firstValue + index]; }
+
+    float Number(const Value& value, uint32_t index = 0) const { return numbers_[value.first + index]; }
+    std::string_view StringValue(const Value& value, uint32_t index = 0) const;
+
+    std::shared_ptr<ZOFTree> ToTree() const;
+
+    static bool IsBinary(const char* data, size_t size);
+
+private:
+
+    std::vector<char> storage_;
+    const char* data_ = nullptr;
+    const Header* header_ = nullptr;
+    const StringEntry* strings_ = nullptr;
+    const char* characters_ = nullptr;
+    const Node* nodes_ = nullptr;
+    const Property* properties_ = nullptr;
+    const Value* values_ = nullptr;
+    const float* numbers_ = nullptr;
+    const uint32_t* stringReferences_ = nullptr;
+
+    bool Validate() const;
+
+};
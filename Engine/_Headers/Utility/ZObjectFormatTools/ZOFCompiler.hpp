@@ -0,0 +1,71 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZOFCompiler.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZOFBinaryTree.hpp"
+
+// Forward Declarations
+
+// Class and Data Structure Definitions
+
+// Compiles text ZOF into the binary .zofb layout read by ZOFBinaryTree. Meant to be run offline over scene and
+// material files, so that level loads skip tokenizing altogether. String globals such as $ENGINE_ROOT$ are kept
+// as is and expanded when the compiled file is loaded.
+class ZOFCompiler
+{
+
+public:
+
+    ZOFCompiler() {}
+    ~ZOFCompiler() {}
+
+    std::vector<char> Compile(const std::string& zofSource);
+    std::vector<char> Compile(const std::shared_ptr<ZOFTree>& tree);
+    bool CompileFile(const std::string& sourcePath, const std::string& outputPath);
+    // Loads a compiled buffer back into a tree and checks it against the text parser's tree for the same source
+    bool Verify(const std::string& zofSource, const std::vector<char>& compiled);
+
+private:
+
+    std::unordered_map<std::string, uint32_t> internedStrings_;
+    std::vector<ZOFBinaryTree::StringEntry> strings_;
+    std::string characters_;
+    std::vector<ZOFBinaryTree::Node> nodes_;
+    std::vector<ZOFBinaryTree::Property> properties_;
+    std::vector<ZOFBinaryTree::Value> values_;
+    std::vector<float> numbers_;
+    std::vector<uint32_t> stringReferences_;
+
+    void Reset();
+    uint32_t Intern(const std::string& str);
+    void AddProperty(const std::shared_ptr<ZOFPropertyNode>& property);
+
+};
@@ -41,6 +41,7 @@ class ZOFParser
 private:
 
     std::string currentToken_;
+    bool expandGlobals_;
     std::stringstream zof_;
     std::regex id_ = std::regex("\"[^\"]+\"|[^\\-\\d\"]\\S+");
     std::regex number_ = std::regex("-?\\d+\\.?\\d*");
@@ -62,7 +63,7 @@ private:
 
 public:
 
-    ZOFParser() {}
+    ZOFParser(bool expandGlobals = true) : expandGlobals_(expandGlobals) {}
     ~ZOFParser() {}
 
     std::shared_ptr<ZOFTree> Parse(const std::string& contents);
@@ -0,0 +1,136 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZRingBuffer.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+
+// Class and Data Structure Definitions
+
+// Bounded lock-free queue that is safe for any number of producers and consumers. Each cell carries a sequence
+// number that tells producers and consumers whether it is free to write or ready to read, so the only contention
+// is a compare-and-swap on the head or tail position. Capacity is rounded up to a power of two.
+template<typename T>
+class ZRingBuffer
+{
+
+public:
+
+    ZRingBuffer(size_t capacity = 1024)
+    {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+
+        mask_ = size - 1;
+        cells_ = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    ~ZRingBuffer() = default;
+
+    ZRingBuffer(const ZRingBuffer&) = delete;
+    ZRingBuffer& operator=(const ZRingBuffer&) = delete;
+
+    size_t Capacity() const { return mask_ + 1; }
+
+    bool Empty() const
+    {
+        return enqueuePosition_.load(std::memory_order_acquire) == dequeuePosition_.load(std::memory_order_acquire);
+    }
+
+    bool Push(T value)
+    {
+        Cell* cell = nullptr;
+        size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells_[position & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0) {
+                // The cell still holds a value from the previous lap, so the buffer is full
+                return false;
+            }
+            else {
+                position = enqueuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(T& outValue)
+    {
+        Cell* cell = nullptr;
+        size_t position = dequeuePosition_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells_[position & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (dequeuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0) {
+                return false;
+            }
+            else {
+                position = dequeuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+
+        outValue = std::move(cell->value);
+        cell->value = T();
+        cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+
+    // Keep the producer and consumer positions on separate cache lines
+    alignas(64) std::atomic<size_t> enqueuePosition_{ 0 };
+    alignas(64) std::atomic<size_t> dequeuePosition_{ 0 };
+
+};
@@ -0,0 +1,98 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZSlabAllocator.hpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Includes
+#include "ZCommon.hpp"
+
+// Class and Data Structure Definitions
+struct ZSlabAllocatorStats
+{
+    // Bytes asked for by callers, and bytes actually handed out after rounding up to a size class
+    size_t requestedBytes = 0;
+    size_t blockBytes = 0;
+    // Bytes reserved in slabs, and bytes in allocations too large for any size class
+    size_t slabBytes = 0;
+    size_t largeBytes = 0;
+    size_t allocations = 0;
+
+    // Share of handed out memory lost to size class rounding
+    float InternalFragmentation() const { return blockBytes > 0 ? 1.f - static_cast<float>(requestedBytes) / static_cast<float>(blockBytes) : 0.f; }
+    // Share of reserved slab memory that sits unused in free lists
+    float ExternalFragmentation() const
+    {
+        size_t slabBlockBytes = blockBytes - std::min(blockBytes, largeBytes);
+        return slabBytes > 0 ? 1.f - static_cast<float>(slabBlockBytes) / static_cast<float>(slabBytes) : 0.f;
+    }
+};
+
+// Allocator for variable sized payloads that rounds requests up to power of two size classes. Each class
+// carves its blocks out of fixed size slabs and recycles them through a free list, so repeated load and evict
+// cycles reuse the same memory instead of fragmenting the heap. An idle size class keeps one slab for reuse
+// and releases the rest. Requests above the largest size class go straight to the heap. Every size class has
+// its own lock.
+class ZSlabAllocator
+{
+
+public:
+
+    ZSlabAllocator(size_t slabSize = 1024 * 1024);
+    ~ZSlabAllocator();
+
+    char* Allocate(size_t size);
+    void Free(char* memory, size_t size);
+
+    ZSlabAllocatorStats Stats() const;
+
+private:
+
+    static const size_t minBlockShift_ = 6;
+    static const size_t maxBlockShift_ = 18;
+    static const size_t sizeClassCount_ = maxBlockShift_ - minBlockShift_ + 1;
+
+    struct SizeClass
+    {
+        size_t blockSize = 0;
+        size_t usedBlocks = 0;
+        size_t requestedBytes = 0;
+        std::vector<std::unique_ptr<char[]>> slabs;
+        std::vector<char*> freeBlocks;
+        mutable std::mutex mutex;
+    };
+
+    size_t slabSize_;
+    std::array<SizeClass, sizeClassCount_> sizeClasses_;
+
+    std::atomic<size_t> largeBytes_{ 0 };
+    std::atomic<size_t> largeCount_{ 0 };
+
+    int SizeClassIndex(size_t size) const;
+
+};
@@ -29,11 +29,20 @@
 
 #include "ZCommon.hpp"
 #include "ZFrameProfiler.hpp"
+#include "ZServices.hpp"
+#include <fstream>
+#include <iomanip>
 
 std::array<ZFrameProfileSession, ZFrameProfiler::maxProfileSessionsBucketSize> ZFrameProfiler::sessions_;
 std::vector<ZFrameProfileSession> ZFrameProfiler::sessionStack_;
 std::unordered_map<std::string, unsigned int> ZFrameProfiler::sessionIndices_;
 std::atomic_uint ZFrameProfiler::currentBucketIndex_ = 0;
+std::atomic_bool ZFrameProfiler::captureEnabled_ = false;
+std::mutex ZFrameProfiler::threadBuffersMutex_;
+std::vector<std::unique_ptr<ZProfileThreadBuffer>> ZFrameProfiler::threadBuffers_;
+std::unordered_map<uint32_t, std::string> ZFrameProfiler::threadNames_;
+std::mutex ZFrameProfiler::gpuTimingsMutex_;
+std::vector<ZGPUTiming> ZFrameProfiler::gpuTimings_;
 
 void ZFrameProfiler::StartSession(const std::string& name)
 {
@@ -96,3 +105,120 @@ ZFrameProfileSession ZFrameProfiler::CurrentSession()
 {
     return sessionStack_.back();
 }
+
+void ZFrameProfiler::EnableCapture(bool enabled)
+{
+    captureEnabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void ZFrameProfiler::SetThreadName(const std::string& name)
+{
+    uint32_t threadId = ThreadBuffer()->threadId;
+    std::lock_guard<std::mutex> lock(threadBuffersMutex_);
+    threadNames_[threadId] = name;
+}
+
+ZProfileThreadBuffer* ZFrameProfiler::ThreadBuffer()
+{
+    // Buffers are registered once per thread and owned by the profiler, so zones recorded by
+    // threads that have since exited can still be exported
+    static thread_local ZProfileThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(threadBuffersMutex_);
+        threadBuffers_.push_back(std::make_unique<ZProfileThreadBuffer>(static_cast<uint32_t>(threadBuffers_.size())));
+        buffer = threadBuffers_.back().get();
+    }
+    return buffer;
+}
+
+static void WriteJSONString(std::ostream& out, const char* str)
+{
+    out << '"';
+    for (; str && *str; str++) {
+        switch (*str) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\t': out << "\\t"; break;
+        default: if (static_cast<unsigned char>(*str) >= 0x20) out << *str; break;
+        }
+    }
+    out << '"';
+}
+
+bool ZFrameProfiler::ExportChromeTrace(const std::string& path)
+{
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        LOG("Could not open " + path + " to export the profiler trace", ZSeverity::Error);
+        return false;
+    }
+
+    std::vector<std::pair<uint32_t, ZProfileEvent>> events;
+    std::unordered_map<uint32_t, std::string> threadNames;
+    uint64_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(threadBuffersMutex_);
+        for (auto& buffer : threadBuffers_) {
+            uint32_t threadId = buffer->threadId;
+            buffer->Drain([&events, threadId](const ZProfileEvent& event) { events.emplace_back(threadId, event); });
+            dropped += buffer->Dropped();
+        }
+        threadNames = threadNames_;
+    }
+
+    int64_t epoch = std::numeric_limits<int64_t>::max();
+    for (const auto& [threadId, event] : events) {
+        epoch = std::min(epoch, event.start);
+    }
+
+    // Chrome trace event format: complete events ("X") with microsecond timestamps, plus
+    // metadata events ("M") naming each thread
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& [threadId, name] : threadNames) {
+        out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadId << ",\"args\":{\"name\":";
+        WriteJSONString(out, name.c_str());
+        out << "}}";
+        first = false;
+    }
+    for (const auto& [threadId, event] : events) {
+        out << (first ? "" : ",") << "\n{\"name\":";
+        WriteJSONString(out, event.name);
+        out << ",\"cat\":\"zenith\",\"ph\":\"X\",\"pid\":0,\"tid\":" << threadId
+            << ",\"ts\":" << (event.start - epoch) * 0.001
+            << ",\"dur\":" << (event.end - event.start) * 0.001
+            << ",\"args\":{\"depth\":" << event.depth << "}}";
+        first = false;
+    }
+    out << "\n]}\n";
+
+    if (dropped > 0) {
+        LOG("Profiler trace is missing " + std::to_string(dropped) + " zones that overflowed their thread buffers", ZSeverity::Warning);
+    }
+
+    return out.good();
+}
+
+void ZFrameProfiler::CollectGPUTimings(const std::vector<ZGPUTiming>& timings)
+{
+    std::lock_guard<std::mutex> lock(gpuTimingsMutex_);
+    gpuTimings_ = timings;
+}
+
+std::vector<ZGPUTiming> ZFrameProfiler::GPUTimings()
+{
+    std::lock_guard<std::mutex> lock(gpuTimingsMutex_);
+    return gpuTimings_;
+}
+
+double ZFrameProfiler::GPUFrameTime()
+{
+    std::lock_guard<std::mutex> lock(gpuTimingsMutex_);
+    double frameTime = 0.0;
+    for (const auto& timing : gpuTimings_) {
+        if (timing.depth == 0) frameTime += timing.milliseconds;
+    }
+    return frameTime;
+}
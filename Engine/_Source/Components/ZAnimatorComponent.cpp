@@ -52,7 +52,7 @@ void ZAnimatorComponent::Update(double deltaTime)
         currentClip_.currentTime += deltaTime;
         if (currentClip_.startTime + currentClip_.currentTime <= currentClip_.endTime)
         {
-            currentClip_.model->BoneTransform(currentClip_.name, currentClip_.currentTime);
+            currentClip_.model->BoneTransform(currentClip_.name, currentClip_.currentTime, currentClip_.clipState);
         }
         else if (currentClip_.state == ZAnimationState::Looping)
         {
@@ -150,9 +150,6 @@ void ZGraphicsComponent::Prepare(double deltaTime, const std::shared_ptr<ZRender
     auto scene = object_->Scene();
     if (!scene) return;
 
-    if (hasAABB_ && isBoundsTraversable_)
-        scene->AddBVHPrimitive(ZBVHPrimitive(object_->ID(), bounds_));
-
     glm::mat4 modelMatrix = object_->ModelMatrix();
 
     auto viewPos = object_->Position() - gameCamera_->Position();
@@ -188,34 +185,38 @@ void ZGraphicsComponent::Prepare(double deltaTime, const std::shared_ptr<ZRender
 
         ZDrawCall drawCall = ZDrawCall::Create(ZMeshDrawStyle::Triangle);
 
-        if (hasDepthInfo_) {
-            auto depthTask = ZRenderTask::Compile(drawCall,
+        // Objects outside the view are only prepared because they cast shadows into it
+        if (isShadowCaster_ && shadowCascades_) {
+            auto shadowTask = ZRenderTask::Compile(drawCall,
                 { cameraState, objectState, modelState, meshState, additionalState, overrideState_ },
-                ZRenderPass::Depth()
+                ZRenderPass::Shadow()
             );
-            depthTask->Submit({ ZRenderPass::Depth() });
+            shadowTask->SetViewMask(shadowCascades_);
+            shadowTask->Submit({ ZRenderPass::Shadow() });
         }
 
-        if (isShadowCaster_) {
-            auto shadowTask = ZRenderTask::Compile(drawCall,
+        if (!inView_) continue;
+
+        if (hasDepthInfo_) {
+            auto depthTask = ZRenderTask::Compile(drawCall,
                 { cameraState, objectState, modelState, meshState, additionalState, overrideState_ },
-                ZRenderPass::Shadow()
+                ZRenderPass::Depth()
             );
-            shadowTask->Submit({ ZRenderPass::Shadow() });
+            depthTask->Submit({ ZRenderPass::Depth() });
         }
 
         if (hasLightingInfo_) {
-            for (const auto& light : gameLights_) {
-                auto lightState = light->RenderState();
-                for (auto material : materials) {
-                    auto materialState = material->RenderState();
-
-                    auto colorRenderTask = ZRenderTask::Compile(drawCall,
-                        { cameraState, objectState, modelState, meshState, additionalState, materialState, lightState, skyboxState, overrideState_ },
-                        ZRenderPass::Color()
-                    );
-                    colorRenderTask->Submit({ ZRenderPass::Color() });
-                }
+            // Only the shadow casting main light is bound per draw, every other light comes from the scene's light grid
+            if (gameLights_.empty()) continue;
+            auto lightState = gameLights_.front()->RenderState();
+            for (auto material : materials) {
+                auto materialState = material->RenderState();
+
+                auto colorRenderTask = ZRenderTask::Compile(drawCall,
+                    { cameraState, objectState, modelState, meshState, additionalState, materialState, lightState, skyboxState, overrideState_ },
+                    ZRenderPass::Color()
+                );
+                colorRenderTask->Submit({ ZRenderPass::Color() });
             }
         }
         else {
@@ -231,6 +232,8 @@ void ZGraphicsComponent::Prepare(double deltaTime, const std::shared_ptr<ZRender
         }
     }
     
+    if (!inView_) return;
+
     if (outlineMaterial_) {
         PrepareOutlineDisplay(modelMatrix, model, additionalState, cameraState);
     }
@@ -346,9 +349,9 @@ void ZGraphicsComponent::SetupAABB()
     Transform(mat);
 }
 
-bool ZGraphicsComponent::IsVisible(ZFrustum frustrum)
+bool ZGraphicsComponent::IsVisible(const ZFrustum& frustum) const
 {
-    return !hasAABB_ || frustrum.Contains(bounds_);
+    return !hasAABB_ || frustum.Contains(bounds_);
 }
 
 void ZGraphicsComponent::Transform(const glm::mat4& mat)
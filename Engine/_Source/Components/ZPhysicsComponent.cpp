@@ -126,15 +126,16 @@ void ZPhysicsComponent::Update(double deltaTime)
         inUniverse_ = true;
     }
 
-    if (body_->Type() == ZPhysicsBodyType::Trigger)
-        body_->SetTransformMatrix(object_->ModelMatrix());
-
-    // Don't update static rigid bodies with the physic engine, since the physics engine cannot affect them
-    if (body_->InverseMass() == 0.0) return;
+    // Triggers follow their game object, but only need to be moved when the object has
+    if (body_->Type() == ZPhysicsBodyType::Trigger) {
+        glm::mat4 M = object_->ModelMatrix();
+        if (M != lastTriggerMatrix_) {
+            body_->SetTransformMatrix(M);
+            lastTriggerMatrix_ = M;
+        }
+    }
 
-    glm::mat4 M = body_->TransformMatrix();
-    M = glm::scale(M, object_->Scale());
-    object_->SetModelMatrix(M);
+    // Dynamic bodies that moved during the step are written back to their game objects by the physics universe
 }
 
 std::shared_ptr<ZComponent> ZPhysicsComponent::Clone()
@@ -65,7 +65,7 @@ void ZBase::Initialize(const ZGameOptions& options)
     /* =================================== */
 
     /* ========= Physics System ============ */
-    Provide(std::make_shared<ZBulletPhysicsUniverse>());
+    Provide(std::make_shared<ZBulletPhysicsUniverse>(options.physics));
     /* ===================================== */
 
     /* ========= Audio System ============ */
@@ -33,6 +33,8 @@
 #include "ZQuitEvent.hpp"
 #include "ZDomain.hpp"
 #include "ZInput.hpp"
+#include "ZGraphics.hpp"
+#include "ZGPUTimer.hpp"
 
 using namespace std;
 
@@ -83,6 +85,11 @@ void ZGame::UpdateSceneConfig()
 
 void ZGame::CleanUp()
 {
+    // Export whatever was recorded if the game closed before the capture finished
+    if (ZFrameProfiler::CaptureEnabled()) {
+        ZPR_CAPTURE_END(gameOptions_.profiler.tracePath)
+    }
+
     ZServices::EventAgent()->Unsubscribe(this, &ZGame::HandleQuit);
     ZBase::CleanUp();
 }
@@ -90,6 +97,11 @@ void ZGame::CleanUp()
 void ZGame::Loop()
 {
     LOG("Zenith is about to loop...", ZSeverity::Info);
+    ZPR_THREAD_NAME("Main")
+
+    if (gameOptions_.profiler.captureFrames > 0) {
+        ZPR_CAPTURE_BEGIN()
+    }
 
     while (Running())
     {
@@ -102,6 +114,7 @@ void ZGame::Loop()
 void ZGame::Tick()
 {
     ZPR_SESSION_BEGIN(name_)
+    ZPR_ZONE("Game Tick")
 
     if (previousTime_ == 0.0)
         previousTime_ = SECONDS_TIME;
@@ -110,6 +123,9 @@ void ZGame::Tick()
     deltaTime_ = currentTime - previousTime_;
     previousTime_ = currentTime;
 
+    auto gpuTimer = ZServices::Graphics()->GPUTimer();
+    gpuTimer->BeginFrame();
+
     ZServices::ProcessRunner(name_)->UpdateTick(deltaTime_);
     // We tick the default process runner to update global systems like input
     // and concurrent tasks, only if we are the top level game base
@@ -119,8 +135,14 @@ void ZGame::Tick()
     if (onUpdateTickCallback_)
         onUpdateTickCallback_();
 
+    gpuTimer->EndFrame();
+
     ZPR_SESSION_END();
 
+    if (gameOptions_.profiler.captureFrames > 0 && ++capturedFrames_ == gameOptions_.profiler.captureFrames) {
+        ZPR_CAPTURE_END(gameOptions_.profiler.tracePath)
+    }
+
     if (!gameOptions_.domain.offline)
         Domain()->SwapBuffers();
 }
@@ -42,9 +42,13 @@
 #include "ZUICanvas.hpp"
 #include "ZUIElement.hpp"
 #include "ZModel.hpp"
+#include "ZMaterial.hpp"
 #include "ZShader.hpp"
 #include "ZSceneRoot.hpp"
 #include "ZComponent.hpp"
+#include "ZGraphicsComponent.hpp"
+#include "ZAnimatorComponent.hpp"
+#include "ZOcclusionBuffer.hpp"
 #include "ZResourceLoadedEvent.hpp"
 #include "ZResourceExtraData.hpp"
 #include "ZTextureReadyEvent.hpp"
@@ -57,6 +61,7 @@
 #include "ZObjectSelectedEvent.hpp"
 #include "ZWindowResizeEvent.hpp"
 #include "ZStringHelpers.hpp"
+#include "ZHash.hpp"
 
 ZScene::ZScene(const std::string& name) : name_(name), playState_(ZPlayState::Loading)
 { }
@@ -86,7 +91,9 @@ void ZScene::Initialize()
     CreateSceneRoot(name_);
     CreateUICanvas();
 
-    bvh_ = std::make_shared<ZBVH>(4, ZBVHSplitMethod::SAH);
+    // The parallel build only splits ranges that are large enough to be worth a task, so small scenes
+    // are still built on the calling thread
+    bvh_ = std::make_shared<ZBVH>(4, ZBVHSplitMethod::SAH, ZBVHBuildMode::Parallel);
 
     for (auto it = pendingSceneDefinitions_.begin(); it != pendingSceneDefinitions_.end(); it++)
     {
@@ -130,11 +137,29 @@ void ZScene::SetupRenderPasses()
 
 void ZScene::Update(double deltaTime)
 {
+    ZPR_ZONE("Scene Update")
     if (playState_ == ZPlayState::Playing || playState_ == ZPlayState::Paused) {
-        root_->Prepare(deltaTime);
-        canvas_->Prepare(deltaTime);
+        // Cascades are fit before culling so that the shadow casters are culled against the matrices they are drawn with
+        UpdateLightspaceMatrices();
+        CullObjects();
+        {
+            ZPR_ZONE("Light Assignment")
+            // The first light is drawn separately with shadows, every other light is shaded through the grid
+            lightGrid_.Build(activeCamera_, gameLights_, gameLights_.empty() ? nullptr : gameLights_.front());
+        }
+        {
+            ZPR_ZONE("Scene Prepare")
+            root_->Prepare(deltaTime);
+        }
+        {
+            ZPR_ZONE("UI Prepare")
+            canvas_->Prepare(deltaTime);
+        }
         renderer_->Render(deltaTime);
-        bvh_->Build();
+        {
+            ZPR_ZONE("BVH Build")
+            bvh_->Build();
+        }
     }
     else if (playState_ == ZPlayState::Loading) {
         CheckPendingObjects();
@@ -173,13 +198,149 @@ void ZScene::Stop()
 
 void ZScene::UpdateLightspaceMatrices()
 {
-    if (gameLights_.empty() || !activeCamera_->Moving()) return;
-    ZFrustum frustum = activeCamera_->Frustum();
+    if (gameLights_.empty() || !activeCamera_) return;
+    const ZFrustum& frustum = activeCamera_->Frustum();
     for (const auto& light : gameLights_) {
         light->UpdateLightspaceMatrices(frustum);
     }
 }
 
+/**
+    Resolves the visibility of every object with graphics for this frame, once for the active camera
+    and once per shadow cascade. The results are stored on the graphics components, which skip the
+    passes they were culled from when they are prepared.
+*/
+void ZScene::CullObjects()
+{
+    ZPR_ZONE("Culling")
+
+    culler_.Clear();
+    cullables_.clear();
+    cullableObjects_.clear();
+    preparedObjects_.clear();
+    casterSignatures_.clear();
+    animatedCasters_.clear();
+    uint8_t dynamicCascades = 0;
+    if (skybox_) preparedObjects_.push_back(skybox_.get());
+    for (const auto& object : gameObjects_)
+    {
+        auto graphicsComp = object->FindComponent<ZGraphicsComponent>();
+        if (!graphicsComp) {
+            if (object->IsVisible()) preparedObjects_.push_back(object.get());
+            continue;
+        }
+
+        // Objects without bounds can't be culled, so they are always drawn
+        if (!graphicsComp->AABBEnabled()) {
+            graphicsComp->SetInView(true);
+            graphicsComp->SetShadowCascades(0xff);
+            if (graphicsComp->IsShadowCaster()) dynamicCascades = 0xff;
+            if (object->IsVisible()) preparedObjects_.push_back(object.get());
+            continue;
+        }
+
+        // Added here rather than when preparing so that objects outside the view can still be picked
+        if (graphicsComp->BVHTraversable())
+            AddBVHPrimitive(ZBVHPrimitive(object->ID(), graphicsComp->AABB()));
+
+        graphicsComp->SetInView(false);
+        graphicsComp->SetShadowCascades(0);
+        culler_.Add(graphicsComp->AABB());
+        cullables_.push_back(graphicsComp.get());
+
+        // With its culling results cleared, an object is only still visible if it overrides visibility, like
+        // particle systems and grass do. Those are prepared whatever the culler decides. Null entries are
+        // never added from the culling results, which also keeps an object from being added twice.
+        bool alwaysVisible = object->IsVisible();
+        if (alwaysVisible) preparedObjects_.push_back(object.get());
+        cullableObjects_.push_back(object->Active() && !alwaysVisible ? object.get() : nullptr);
+
+        // Anything that changes what a caster draws into the shadow map has to change its signature.
+        // Inactive objects aren't prepared, so they drop out of the cascade hashes like removed objects do.
+        uint64_t signature = 0;
+        bool animated = false;
+        if (graphicsComp->IsShadowCaster() && object->Active()) {
+            glm::mat4 modelMatrix = object->ModelMatrix();
+            const void* identity[] = { graphicsComp.get(), graphicsComp->Model().get() };
+            signature = zenith::hash::FNV1a(identity, sizeof(identity));
+            signature = zenith::hash::FNV1a(glm::value_ptr(modelMatrix), sizeof(modelMatrix), signature);
+            for (const auto& material : graphicsComp->Materials()) {
+                const ZMaterialProperties& properties = material->Properties();
+                const void* materialIdentity = material.get();
+                signature = zenith::hash::FNV1a(&materialIdentity, sizeof(materialIdentity), signature);
+                signature = zenith::hash::FNV1a(&properties.alpha, sizeof(properties.alpha), signature);
+                signature = zenith::hash::FNV1a(&properties.hasDisplacement, sizeof(properties.hasDisplacement), signature);
+            }
+            animated = object->FindComponent<ZAnimatorComponent>() != nullptr;
+        }
+        casterSignatures_.push_back(signature);
+        animatedCasters_.push_back(animated);
+    }
+
+    if (!activeCamera_ || cullables_.empty()) {
+        dynamicShadowCascades_ = 0xff;
+        return;
+    }
+
+    culler_.Cull(ZFrustumCuller::Planes(activeCamera_->ViewProjectionMatrix()), visibleObjects_);
+
+    // Objects hidden behind the most recent depth read back from the GPU skip the depth and color passes.
+    // They are still tested against the shadow cascades below, since they can cast shadows into view.
+    if (ZServices::Graphics()->HasOcclusionCulling()) {
+        ZPR_ZONE("Occlusion Culling")
+        glm::mat4 occlusionViewProjection;
+        if (ZServices::Graphics()->OcclusionBuffer()->Read(occlusionDepth_, occlusionViewProjection)) {
+            occlusionCuller_.Build(occlusionDepth_, ZOcclusionBuffer::resolution, occlusionViewProjection);
+        }
+        if (occlusionCuller_.Valid()) {
+            visibleObjects_.erase(std::remove_if(visibleObjects_.begin(), visibleObjects_.end(), [this](uint32_t index) {
+                return occlusionCuller_.Occluded(cullables_[index]->AABB());
+            }), visibleObjects_.end());
+        }
+    }
+    else {
+        occlusionCuller_.Clear();
+    }
+
+    auto prepare = [this](uint32_t index) {
+        if (ZGameObject* object = cullableObjects_[index]) {
+            preparedObjects_.push_back(object);
+            cullableObjects_[index] = nullptr;
+        }
+    };
+
+    for (auto index : visibleObjects_) {
+        cullables_[index]->SetInView(true);
+        prepare(index);
+    }
+
+    // The shadow pass only renders cascades for the first light
+    static const std::vector<glm::mat4> noLightspaceMatrices;
+    const std::vector<glm::mat4>& lightspaceMatrices = gameLights_.empty() ? noLightspaceMatrices : gameLights_.front()->LightSpaceMatrices();
+    for (unsigned int j = 0; j < NUM_SHADOW_CASCADES; j++)
+    {
+        if (j >= lightspaceMatrices.size()) {
+            for (uint32_t index = 0; index < cullables_.size(); index++) {
+                cullables_[index]->AddShadowCascade(j);
+                prepare(index);
+            }
+            dynamicCascades |= static_cast<uint8_t>(1 << j);
+            continue;
+        }
+        culler_.Cull(ZFrustumCuller::Planes(lightspaceMatrices[j]), cascadeObjects_, false);
+        uint64_t signature = zenith::hash::FNV1a(glm::value_ptr(lightspaceMatrices[j]), sizeof(glm::mat4));
+        for (auto index : cascadeObjects_) {
+            cullables_[index]->AddShadowCascade(j);
+            prepare(index);
+            if (!casterSignatures_[index]) continue;
+            if (animatedCasters_[index]) dynamicCascades |= static_cast<uint8_t>(1 << j);
+            signature = zenith::hash::FNV1a(&casterSignatures_[index], sizeof(uint64_t), signature);
+        }
+        shadowCascadeSignatures_[j] = signature;
+    }
+    dynamicShadowCascades_ = dynamicCascades;
+}
+
 ZSceneSnapshot ZScene::Snapshot()
 {
     ZSceneSnapshot snapshot;
@@ -46,6 +46,7 @@ std::shared_ptr<ZGraphics> ZServices::graphics_ = nullptr;
 std::shared_ptr<ZInput> ZServices::input_ = nullptr;
 std::shared_ptr<ZEventAgent> ZServices::eventAgent_ = nullptr;
 std::shared_ptr<ZResourceCache> ZServices::resourceCache_ = nullptr;
+std::shared_ptr<ZJobSystem> ZServices::jobSystem_ = nullptr;
 std::shared_ptr<ZScriptManager> ZServices::scriptManager_ = nullptr;
 std::shared_ptr<ZAssetStore> ZServices::assetStore_ = nullptr;
 std::unordered_map<std::string, std::shared_ptr<ZProcessRunner>> ZServices::processRunners_;
@@ -55,6 +56,10 @@ bool ZServices::initialized_ = false;
 void ZServices::Initialize()
 {
     if (!initialized_) {
+        /* ========= Job System ============ */
+        Provide(std::make_shared<ZJobSystem>());
+        /* ================================= */
+
         /* ========= Resource Cache System ============ */
         Provide(std::make_shared<ZResourceCache>(256));
         /* ============================================ */
@@ -139,6 +144,15 @@ void ZServices::Provide(const std::shared_ptr<ZResourceCache>& resourceCache)
     resourceCache_->RegisterLoader(std::shared_ptr<ZOggResourceLoader>(new ZOggResourceLoader));
 }
 
+void ZServices::Provide(const std::shared_ptr<ZJobSystem>& jobSystem)
+{
+    if (jobSystem_)
+        jobSystem_->CleanUp();
+
+    jobSystem_ = jobSystem;
+    jobSystem_->Initialize();
+}
+
 void ZServices::Provide(const std::shared_ptr<ZEventAgent>& eventAgent)
 {
     if (eventAgent_) {
@@ -6,9 +6,9 @@
    /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
    \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
 
-   ZCollisionEvent.cpp
+   ZCollisionBatchEvent.cpp
 
-   Created by Adrian Sanchez on 12/03/2019.
+   Created by Adrian Sanchez on 10/18/2026.
    Copyright © 2019 Pervasive Sense. All rights reserved.
 
  This file is part of Zenith.
@@ -27,6 +27,6 @@
  along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include "ZCollisionEvent.hpp"
+#include "ZCollisionBatchEvent.hpp"
 
-const ZTypeIdentifier ZCollisionEvent::Type(TYPE_ID(ZCollisionEvent));
+const ZTypeIdentifier ZCollisionBatchEvent::Type(TYPE_ID(ZCollisionBatchEvent));
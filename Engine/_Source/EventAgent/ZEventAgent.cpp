@@ -38,107 +38,86 @@ void ZEventAgent::Initialize()
 bool ZEventAgent::Subscribe(const std::shared_ptr<ZEventDelegate>& eventDelegate, const ZTypeIdentifier& type)
 {
     std::lock_guard<std::mutex> listenersLock(mutexes_.listeners);
-    EventListenerList& listeners = eventListeners_[activeListeners_][type];
-    for (auto it = listeners.begin(); it != listeners.end(); it++)
+    auto current = Listeners(type);
+    auto listeners = current ? std::make_shared<EventListenerList>(*current) : std::make_shared<EventListenerList>();
+    for (auto it = listeners->begin(); it != listeners->end(); it++)
     {
-        if (eventDelegate == (*it))
+        if (*eventDelegate == *(*it))
         {
             LOG("Attempted to register the same delegate twice for event " + std::to_string(type), ZSeverity::Warning);
             return false;
         }
     }
-    listeners.emplace_back(eventDelegate);
+    listeners->emplace_back(eventDelegate);
+    PublishListeners(type, listeners);
     return true;
 }
 
 bool ZEventAgent::Unsubscribe(const std::shared_ptr<ZEventDelegate>& eventDelegate, const ZTypeIdentifier& type)
 {
-    bool success = false;
+    std::lock_guard<std::mutex> listenersLock(mutexes_.listeners);
+    auto current = Listeners(type);
+    if (!current) return false;
 
+    for (auto it = current->begin(); it != current->end(); it++)
     {
-        std::lock_guard<std::mutex> listenersLock(mutexes_.listeners);
-        auto findIt = eventListeners_[activeListeners_].find(type);
-        if (findIt != eventListeners_[activeListeners_].end())
+        if (*(*it) == *eventDelegate)
         {
-            EventListenerList& listeners = findIt->second;
-            for (auto it = listeners.begin(); it != listeners.end(); it++)
-            {
-                if ((*it) == eventDelegate)
-                {
-                    listeners.erase(it);
-                    success = true;
-                    break;
-                }
-            }
+            auto listeners = std::make_shared<EventListenerList>(*current);
+            listeners->erase(listeners->begin() + std::distance(current->begin(), it));
+            PublishListeners(type, listeners);
+            return true;
         }
     }
-
-    return success;
+    return false;
 }
 
 bool ZEventAgent::Trigger(const std::shared_ptr<ZEvent>& event)
 {
-    bool processed = false;
+    auto listeners = Listeners(event->EventType());
+    if (!listeners || listeners->empty()) return false;
 
+    for (const auto& listener : *listeners)
     {
-        std::lock_guard<std::mutex> listenersLock(mutexes_.listeners);
-        auto findIt = eventListeners_[activeListeners_].find(event->EventType());
-        if (findIt != eventListeners_[activeListeners_].end())
-        {
-            const EventListenerList& listeners = findIt->second;
-            for (auto it = listeners.begin(); it != listeners.end(); it++)
-            {
-                event->SetTimeStamp(SECONDS_TIME);
-                (*it)->operator()(event);
-                processed = true;
-            }
-        }
+        event->SetTimeStamp(SECONDS_TIME);
+        (*listener)(event);
     }
-
-    return processed;
+    return true;
 }
 
 bool ZEventAgent::Queue(const std::shared_ptr<ZEvent>& event)
 {
-    assert(activeQueue_ >= 0 && activeQueue_ < NUM_EVENT_QUEUES);
-    bool success = false;
+    auto listeners = Listeners(event->EventType());
+    if (!listeners || listeners->empty()) return false;
 
-    {
-        std::lock_guard<std::mutex> listenersLock(mutexes_.listeners);
-        auto findIt = eventListeners_[activeListeners_].find(event->EventType());
-        if (findIt != eventListeners_[activeListeners_].end())
-        {
-            eventQueues_[activeQueue_].emplace_back(event);
-            success = true;
-        }
-    }
+    // Once the ring has filled up every producer goes through the overflow list until the next update drains it,
+    // so that events queued during a burst are still dispatched in order
+    if (!overflowing_.load(std::memory_order_acquire) && eventRing_.Push(event))
+        return true;
 
-    return success;
+    std::lock_guard<std::mutex> overflowLock(mutexes_.overflow);
+    overflowing_.store(true, std::memory_order_release);
+    overflowQueue_.emplace_back(event);
+    return true;
 }
 
 bool ZEventAgent::Cancel(const ZTypeIdentifier& eventType, bool allOfType)
 {
-    assert(activeQueue_ >= 0 && activeQueue_ < NUM_EVENT_QUEUES);
     bool success = false;
 
+    std::lock_guard<std::mutex> pendingLock(mutexes_.pending);
+    DrainQueue();
+
+    auto it = pendingQueue_.begin();
+    while (it != pendingQueue_.end())
     {
-        std::lock_guard<std::mutex> listenersLock(mutexes_.listeners);
-        auto findIt = eventListeners_[activeListeners_].find(eventType);
-        if (findIt != eventListeners_[activeListeners_].end())
+        auto thisIt = it;
+        ++it;
+        if ((*thisIt)->EventType() == eventType)
         {
-            EventQueue eventQueue = eventQueues_[activeQueue_];
-            auto it = eventQueue.begin();
-            while (it != eventQueue.end())
-            {
-                auto thisIt = it;
-                ++it;
-                if ((*thisIt)->EventType() == eventType)
-                {
-                    eventQueue.erase(thisIt);
-                    success = true;
-                    if (!allOfType) break;
-                }
-            }
+            pendingQueue_.erase(thisIt);
+            success = true;
+            if (!allOfType) break;
         }
     }
 
@@ -147,35 +126,30 @@ bool ZEventAgent::Cancel(const ZTypeIdentifier& eventType, bool allOfType)
 
 void ZEventAgent::Update(double deltaTime)
 {
+    ZPR_ZONE("Event Dispatch")
     constexpr float floatMax = std::numeric_limits<float>::max();
     float currentTime = SECONDS_TIME;
     const float maxTime = ((updateTimeoutMax_ == floatMax) ? floatMax : currentTime + updateTimeoutMax_);
 
-    int listenersToProcess = activeListeners_;
-    int queueToProcess = activeQueue_;
+    EventQueue eventsToProcess;
     {
-        std::lock_guard<std::mutex> listenersLock(mutexes_.listeners);
-        activeListeners_ = (activeListeners_ + 1) % NUM_LISTENER_QUEUES;
-        eventListeners_[activeListeners_] = eventListeners_[listenersToProcess];
-
-        activeQueue_ = (activeQueue_ + 1) % NUM_EVENT_QUEUES;
-        eventQueues_[activeQueue_].clear();
+        std::lock_guard<std::mutex> pendingLock(mutexes_.pending);
+        DrainQueue();
+        eventsToProcess.swap(pendingQueue_);
     }
 
-    while (!eventQueues_[queueToProcess].empty())
+    while (!eventsToProcess.empty())
     {
-        std::shared_ptr<ZEvent> event = eventQueues_[queueToProcess].front();
-        eventQueues_[queueToProcess].pop_front();
-        const ZTypeIdentifier& eventType = event->EventType();
+        std::shared_ptr<ZEvent> event = eventsToProcess.front();
+        eventsToProcess.pop_front();
 
-        auto findIt = eventListeners_[listenersToProcess].find(eventType);
-        if (findIt != eventListeners_[listenersToProcess].end())
+        // Grab the listeners per event, since handlers are free to subscribe and unsubscribe while we dispatch
+        if (auto listeners = Listeners(event->EventType()))
         {
-            const EventListenerList& listeners = findIt->second;
-            for (auto it = listeners.begin(); it != listeners.end(); it++)
+            for (const auto& listener : *listeners)
             {
                 event->SetTimeStamp(SECONDS_TIME);
-                (*it)->operator()(event);
+                (*listener)(event);
             }
         }
 
@@ -186,20 +160,11 @@ void ZEventAgent::Update(double deltaTime)
         }
     }
 
+    if (!eventsToProcess.empty())
     {
-        std::lock_guard<std::mutex> listenersLock(mutexes_.listeners);
-        bool queueFlushed = eventQueues_[queueToProcess].empty();
-        if (!queueFlushed)
-        {
-            while (!eventQueues_[queueToProcess].empty())
-            {
-                std::shared_ptr<ZEvent> event = eventQueues_[queueToProcess].back();
-                eventQueues_[queueToProcess].pop_back();
-                eventQueues_[activeQueue_].emplace_front(event);
-            }
-        }
-
-        eventListeners_[listenersToProcess] = eventListeners_[activeListeners_];
+        // Whatever we didn't get to goes back in front of the events queued in the meantime
+        std::lock_guard<std::mutex> pendingLock(mutexes_.pending);
+        pendingQueue_.splice(pendingQueue_.begin(), eventsToProcess);
     }
 
     ZProcess::Update(deltaTime);
@@ -209,9 +174,45 @@ void ZEventAgent::CleanUp()
 {
     {
         std::lock_guard<std::mutex> listenersLock(mutexes_.listeners);
-        for (int i = 0; i < NUM_LISTENER_QUEUES; i++)
-        {
-            eventListeners_[i].clear();
-        }
+        std::atomic_store(&eventListeners_, std::shared_ptr<const EventListenerMap>(std::make_shared<EventListenerMap>()));
+    }
+    {
+        std::lock_guard<std::mutex> pendingLock(mutexes_.pending);
+        DrainQueue();
+        pendingQueue_.clear();
+    }
+}
+
+std::shared_ptr<const ZEventAgent::EventListenerMap> ZEventAgent::Listeners() const
+{
+    return std::atomic_load(&eventListeners_);
+}
+
+std::shared_ptr<const ZEventAgent::EventListenerList> ZEventAgent::Listeners(const ZTypeIdentifier& type) const
+{
+    auto listenerMap = Listeners();
+    auto findIt = listenerMap->find(type);
+    return findIt != listenerMap->end() ? findIt->second : nullptr;
+}
+
+void ZEventAgent::PublishListeners(const ZTypeIdentifier& type, const std::shared_ptr<const EventListenerList>& listeners)
+{
+    // Only the per-type array that changed is rebuilt, the rest of the map shares the existing arrays
+    auto listenerMap = std::make_shared<EventListenerMap>(*Listeners());
+    (*listenerMap)[type] = listeners;
+    std::atomic_store(&eventListeners_, std::shared_ptr<const EventListenerMap>(listenerMap));
+}
+
+void ZEventAgent::DrainQueue()
+{
+    // Must be called with the pending lock held
+    std::shared_ptr<ZEvent> event;
+    while (eventRing_.Pop(event))
+    {
+        pendingQueue_.emplace_back(std::move(event));
     }
+
+    std::lock_guard<std::mutex> overflowLock(mutexes_.overflow);
+    pendingQueue_.splice(pendingQueue_.end(), overflowQueue_);
+    overflowing_.store(false, std::memory_order_release);
 }
@@ -30,6 +30,7 @@
 #include "ZLight.hpp"
 #include "ZSkybox.hpp"
 #include "ZGrass.hpp"
+#include "ZParticleSystem.hpp"
 #include "ZCamera.hpp"
 #include "ZGame.hpp"
 #include "ZScene.hpp"
@@ -68,6 +69,7 @@ void ZGameObject::Initialize()
     ZRenderStateGroupWriter writer;
     writer.Begin();
     writer.BindUniformBuffer(uniformBuffer_);
+    writer.SetInstanceTransform(properties_.modelMatrix);
     renderState_ = writer.End();
 
     CalculateDerivedData();
@@ -112,6 +114,15 @@ void ZGameObject::Prepare(double deltaTime)
     auto scene = Scene();
     if (!scene) return;
 
+    // Keep a CPU side copy of the model matrix in the render state so that the render queue
+    // can batch draws of the same mesh into a single instanced draw
+    if (renderState_ && instanceTransformDirty_.exchange(false)) {
+        ZRenderStateGroupWriter writer(renderState_);
+        writer.Begin();
+        writer.SetInstanceTransform(ModelMatrix());
+        renderState_ = writer.End();
+    }
+
     if (std::shared_ptr<ZGraphicsComponent> graphicsComp = FindComponent<ZGraphicsComponent>())
     {
         graphicsComp->SetGameLights(scene->GameLights());
@@ -219,9 +230,10 @@ bool ZGameObject::IsVisible()
     auto scene = Scene();
     if (!scene) return false;
 
-    std::shared_ptr<ZCamera> activeCamera = scene->ActiveCamera();
+    // Visibility is resolved for every object at once by the scene culling stage. Objects outside the
+    // view still have to be prepared if they cast shadows into one of the cascades.
     if (auto graphicsComp = FindComponent<ZGraphicsComponent>()) {
-        return activeCamera && graphicsComp->IsVisible(activeCamera->Frustum()) && properties_.active;
+        return scene->ActiveCamera() && (graphicsComp->InView() || graphicsComp->ShadowCascades()) && properties_.active;
     }
     return false;
 }
@@ -425,6 +437,10 @@ void ZGameObject::SetModelMatrix(const glm::mat4& modelMatrix)
     if (uniformBuffer_)
         uniformBuffer_->Update(offsetof(ZObjectUniforms, M), sizeof(glm::mat4), glm::value_ptr(properties_.modelMatrix));
 
+    // The render state is read while preparing and rendering, which can overlap with physics or scripts
+    // moving the object, so the instance transform is only staged here and applied in Prepare
+    instanceTransformDirty_ = true;
+
     if (auto graphicsComp = FindComponent<ZGraphicsComponent>())
         graphicsComp->Transform(properties_.modelMatrix);
 
@@ -495,6 +511,10 @@ ZGameObjectList ZGameObject::Load(std::shared_ptr<ZOFTree> data, const std::shar
         {
             gameObject = ZGrass::Create(node, scene);
         }
+        else if (HasObjectPrefix(node->id, "ZPS"))
+        {
+            gameObject = ZParticleSystem::Create(node, scene);
+        }
 
         if (gameObject) {
             gameObjects.push_back(gameObject);
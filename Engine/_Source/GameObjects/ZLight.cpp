@@ -153,11 +153,6 @@ void ZLight::Prepare(double deltaTime)
     auto scene = Scene();
     if (!scene) return;
 
-    auto cam = scene->ActiveCamera();
-    if (cam && cam->Moving()) {
-        UpdateLightspaceMatrices(cam->Frustum());
-    }
-
     if (scene->GameConfig().graphics.drawAABBDebug) {
         ZServices::Graphics()->DebugDraw(scene, lightspaceRegion_, glm::vec4(1.f));
     }
@@ -182,24 +177,33 @@ void ZLight::UpdateLightspaceMatrices(const ZFrustum& frustum)
     if (type == ZLightType::Directional) {
         shadowFarPlaneSplits_ = glm::vec4(frustum.far * 0.2f, frustum.far * 0.35f, frustum.far * 0.75f, frustum.far);
         lightspaceMatrices_.clear();
+
+        // Every cascade shares the light's rotation, so that only the translation changes as the camera moves
+        glm::mat4 lightV = glm::lookAt(glm::vec3(0.f), -glm::eulerAngles(glm::normalize(Orientation())), WORLD_UP);
+
         for (int i = 0; i < NUM_SHADOW_CASCADES; i++) {
             ZFrustum splitFrustum = frustum;
             splitFrustum.far = shadowFarPlaneSplits_[i];
             splitFrustum.Recalculate();
 
-            glm::mat4 lightV = glm::lookAt(splitFrustum.center + glm::eulerAngles(glm::normalize(Orientation())), splitFrustum.center, WORLD_UP);
-
             lightspaceRegion_ = ZAABBox();
+            float radius = 0.f;
             for (const auto& corner : splitFrustum.corners) {
-                auto transformedCorner = glm::vec4(corner, 1.0) * lightV;
-                lightspaceRegion_ = ZAABBox::Union(lightspaceRegion_, transformedCorner);
+                lightspaceRegion_ = ZAABBox::Union(lightspaceRegion_, corner);
+                radius = glm::max(radius, glm::length(corner - splitFrustum.center));
             }
 
-            glm::vec3 extents = glm::vec3(glm::abs(lightspaceRegion_.maximum.x - lightspaceRegion_.minimum.x),
-                                          glm::abs(lightspaceRegion_.maximum.y - lightspaceRegion_.minimum.y),
-                                          glm::abs(lightspaceRegion_.maximum.z - lightspaceRegion_.minimum.z)) * 0.5f;
-
-            lightspaceMatrices_.push_back(glm::ortho(-extents.x, extents.x, -extents.y, extents.y, -extents.z, extents.z) * lightV);
+            // Bounding the split with a sphere keeps the cascade the same size when the camera turns, and
+            // snapping its center to whole shadow map texels keeps the cascade from shimmering when the camera
+            // moves. Together they make the matrix stable enough that cached cascades can be reused.
+            radius = glm::ceil(radius * 16.f) / 16.f;
+            float texelSize = radius * 2.f / static_cast<float>(SHADOW_MAP_SIZE);
+            glm::vec3 center = glm::vec3(lightV * glm::vec4(splitFrustum.center, 1.f));
+            center = glm::floor(center / texelSize) * texelSize;
+
+            // Casters between the light and the split are kept by pushing the near plane further toward the light
+            lightspaceMatrices_.push_back(glm::ortho(center.x - radius, center.x + radius, center.y - radius, center.y + radius,
+                                                     -center.z - radius * 2.f, -center.z + radius) * lightV);
         }
 
         uniformBuffer_->Update(offsetof(ZLightUniforms, ViewProjectionsLightSpace), sizeof(glm::mat4) * NUM_SHADOW_CASCADES, lightspaceMatrices_.data());
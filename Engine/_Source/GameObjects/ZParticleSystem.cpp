@@ -28,21 +28,395 @@
 */
 
 #include "ZParticleSystem.hpp"
+#include "ZServices.hpp"
+#include "ZScene.hpp"
+#include "ZPlane.hpp"
+#include "ZShader.hpp"
+#include "ZMaterial.hpp"
+#include "ZGraphicsComponent.hpp"
+#include "ZTextureReadyEvent.hpp"
+
+static std::vector<float> ZParticleBuffer::* const cParticleFields[] = {
+    &ZParticleBuffer::positionX, &ZParticleBuffer::positionY, &ZParticleBuffer::positionZ,
+    &ZParticleBuffer::velocityX, &ZParticleBuffer::velocityY, &ZParticleBuffer::velocityZ,
+    &ZParticleBuffer::colorR, &ZParticleBuffer::colorG, &ZParticleBuffer::colorB, &ZParticleBuffer::colorA,
+    &ZParticleBuffer::colorRateR, &ZParticleBuffer::colorRateG, &ZParticleBuffer::colorRateB, &ZParticleBuffer::colorRateA,
+    &ZParticleBuffer::size, &ZParticleBuffer::sizeRate,
+    &ZParticleBuffer::age, &ZParticleBuffer::lifetime, &ZParticleBuffer::damping
+};
+
+void ZParticleBuffer::Resize(unsigned int capacity)
+{
+    for (auto field : cParticleFields)
+    {
+        (this->*field).resize(capacity);
+    }
+    count = std::min(count, capacity);
+}
+
+void ZParticleBuffer::Move(unsigned int from, unsigned int to)
+{
+    for (auto field : cParticleFields)
+    {
+        (this->*field)[to] = (this->*field)[from];
+    }
+}
+
+// The kernels below only touch plain float arrays over a contiguous range so that the compiler
+// can vectorize them, and so that large systems can be split into independent jobs.
+static void IntegrateParticles(ZParticleBuffer& particles, unsigned int begin, unsigned int end, float deltaTime, const glm::vec3& gravity)
+{
+    float* px = particles.positionX.data(); float* py = particles.positionY.data(); float* pz = particles.positionZ.data();
+    float* vx = particles.velocityX.data(); float* vy = particles.velocityY.data(); float* vz = particles.velocityZ.data();
+    const float* damping = particles.damping.data();
+    float* age = particles.age.data();
+    float gx = gravity.x * deltaTime, gy = gravity.y * deltaTime, gz = gravity.z * deltaTime;
+
+    for (unsigned int i = begin; i < end; i++)
+    {
+        float drag = std::max(0.f, 1.f - damping[i] * deltaTime);
+        vx[i] = vx[i] * drag + gx;
+        vy[i] = vy[i] * drag + gy;
+        vz[i] = vz[i] * drag + gz;
+        px[i] += vx[i] * deltaTime;
+        py[i] += vy[i] * deltaTime;
+        pz[i] += vz[i] * deltaTime;
+        age[i] += deltaTime;
+    }
+}
+
+static void FadeParticles(ZParticleBuffer& particles, unsigned int begin, unsigned int end, float deltaTime)
+{
+    float* r = particles.colorR.data(); float* g = particles.colorG.data(); float* b = particles.colorB.data(); float* a = particles.colorA.data();
+    const float* dr = particles.colorRateR.data(); const float* dg = particles.colorRateG.data();
+    const float* db = particles.colorRateB.data(); const float* da = particles.colorRateA.data();
+    float* size = particles.size.data();
+    const float* ds = particles.sizeRate.data();
+
+    for (unsigned int i = begin; i < end; i++)
+    {
+        r[i] += dr[i] * deltaTime;
+        g[i] += dg[i] * deltaTime;
+        b[i] += db[i] * deltaTime;
+        a[i] += da[i] * deltaTime;
+        size[i] += ds[i] * deltaTime;
+    }
+}
 
 ZParticleSystem::ZParticleSystem(std::initializer_list<ZParticleRule> rules)
+    : ZParticleSystem()
+{
+    for (const ZParticleRule& rule : rules)
+    {
+        ZParticleEmitter emitter;
+        emitter.rule = rule;
+        emitters_.push_back(emitter);
+    }
+}
+
+void ZParticleSystem::Initialize()
 {
-    for (ZParticle* particle : particles_)
+    SetRenderOrder(ZRenderLayer::Dynamic);
+
+    particles_.Resize(maxParticles_);
+    instances_.resize(maxParticles_);
+    random_.seed(std::random_device()());
+
+    if (emitters_.empty())
+    {
+        emitters_.push_back(ZParticleEmitter());
+    }
+
+    quad_ = ZPlane::Create(glm::vec2(0.5f));
+
+    graphicsComp_ = std::static_pointer_cast<ZGraphicsComponent>(ZGraphicsComponent::CreateIn(shared_from_this()));
+    graphicsComp_->Initialize(quad_);
+    graphicsComp_->DisableShadowCasting();
+    graphicsComp_->DisableLightingInfo();
+    graphicsComp_->DisableDepthInfo();
+    graphicsComp_->DisableAABB();
+    graphicsComp_->DisableBVHTraversal();
+
+    if (textureId_.empty())
+    {
+        graphicsComp_->AddMaterial(ZMaterial::Create(ZMaterialProperties(), ZShader::Create("/Shaders/Vertex/particle.vert", "/Shaders/Pixel/particle.frag")));
+    }
+    else
+    {
+        ZServices::EventAgent()->Subscribe(this, &ZParticleSystem::HandleTextureReady);
+    }
+
+    ZGameObject::Initialize();
+}
+
+void ZParticleSystem::Initialize(std::shared_ptr<ZOFNode> root)
+{
+    std::shared_ptr<ZOFObjectNode> node = std::dynamic_pointer_cast<ZOFObjectNode>(root);
+    if (!node)
+    {
+        LOG("Could not initalize ZParticleSystem", ZSeverity::Error);
+        return;
+    }
+
+    ZOFPropertyMap props = node->properties;
+
+    ZParticleEmitter emitter;
+    ZParticleRule& rule = emitter.rule;
+
+    if (props.find("maxParticles") != props.end() && props["maxParticles"]->HasValues())
+    {
+        std::shared_ptr<ZOFNumber> maxParticlesProp = props["maxParticles"]->Value<ZOFNumber>(0);
+        maxParticles_ = static_cast<unsigned int>(maxParticlesProp->value);
+    }
+
+    if (props.find("emissionRate") != props.end() && props["emissionRate"]->HasValues())
+    {
+        std::shared_ptr<ZOFNumber> rateProp = props["emissionRate"]->Value<ZOFNumber>(0);
+        emitter.rate = rateProp->value;
+    }
+
+    if (props.find("extents") != props.end() && props["extents"]->HasValues())
+    {
+        std::shared_ptr<ZOFNumberList> extentsProp = props["extents"]->Value<ZOFNumberList>(0);
+        emitter.extents = glm::vec3(extentsProp->value[0], extentsProp->value[1], extentsProp->value[2]);
+    }
+
+    if (props.find("age") != props.end() && props["age"]->HasValues())
+    {
+        std::shared_ptr<ZOFNumberList> ageProp = props["age"]->Value<ZOFNumberList>(0);
+        rule.minAge = ageProp->value[0];
+        rule.maxAge = ageProp->value[1];
+    }
+
+    if (props.find("velocity") != props.end() && props["velocity"]->HasValues())
+    {
+        std::shared_ptr<ZOFNumberList> velocityProp = props["velocity"]->Value<ZOFNumberList>(0);
+        rule.minVelocity = velocityProp->value[0];
+        rule.maxVelocity = velocityProp->value[1];
+    }
+
+    if (props.find("size") != props.end() && props["size"]->HasValues())
+    {
+        std::shared_ptr<ZOFNumberList> sizeProp = props["size"]->Value<ZOFNumberList>(0);
+        rule.minSize = sizeProp->value[0];
+        rule.maxSize = sizeProp->value[1];
+    }
+
+    if (props.find("endSizeScale") != props.end() && props["endSizeScale"]->HasValues())
+    {
+        std::shared_ptr<ZOFNumber> endSizeProp = props["endSizeScale"]->Value<ZOFNumber>(0);
+        rule.endSizeScale = endSizeProp->value;
+    }
+
+    if (props.find("damping") != props.end() && props["damping"]->HasValues())
+    {
+        std::shared_ptr<ZOFNumber> dampingProp = props["damping"]->Value<ZOFNumber>(0);
+        rule.damping = dampingProp->value;
+    }
+
+    if (props.find("direction") != props.end() && props["direction"]->HasValues())
+    {
+        std::shared_ptr<ZOFNumberList> directionProp = props["direction"]->Value<ZOFNumberList>(0);
+        rule.direction = glm::vec3(directionProp->value[0], directionProp->value[1], directionProp->value[2]);
+    }
+
+    if (props.find("spread") != props.end() && props["spread"]->HasValues())
+    {
+        std::shared_ptr<ZOFNumber> spreadProp = props["spread"]->Value<ZOFNumber>(0);
+        rule.spread = spreadProp->value;
+    }
+
+    if (props.find("startColor") != props.end() && props["startColor"]->HasValues())
+    {
+        std::shared_ptr<ZOFNumberList> colorProp = props["startColor"]->Value<ZOFNumberList>(0);
+        rule.startColor = glm::vec4(colorProp->value[0], colorProp->value[1], colorProp->value[2], colorProp->value.size() > 3 ? colorProp->value[3] : 1.f);
+    }
+
+    if (props.find("endColor") != props.end() && props["endColor"]->HasValues())
+    {
+        std::shared_ptr<ZOFNumberList> colorProp = props["endColor"]->Value<ZOFNumberList>(0);
+        rule.endColor = glm::vec4(colorProp->value[0], colorProp->value[1], colorProp->value[2], colorProp->value.size() > 3 ? colorProp->value[3] : 0.f);
+    }
+
+    if (props.find("gravity") != props.end() && props["gravity"]->HasValues())
+    {
+        std::shared_ptr<ZOFNumberList> gravityProp = props["gravity"]->Value<ZOFNumberList>(0);
+        gravity_ = glm::vec3(gravityProp->value[0], gravityProp->value[1], gravityProp->value[2]);
+    }
+
+    if (props.find("texture") != props.end() && props["texture"]->HasValues())
+    {
+        std::shared_ptr<ZOFString> textureProp = props["texture"]->Value<ZOFString>(0);
+        textureId_ = textureProp->value;
+    }
+
+    isAlive_ = true;
+    if (props.find("autoStart") != props.end() && props["autoStart"]->HasValues())
     {
-        particles_.push_back(particle);
+        std::shared_ptr<ZOFString> autoStartProp = props["autoStart"]->Value<ZOFString>(0);
+        isAlive_ = autoStartProp->value == "Yes";
     }
+
+    emitters_.push_back(emitter);
+
+    ZGameObject::Initialize(root);
+}
+
+void ZParticleSystem::Prepare(double deltaTime)
+{
+    auto scene = Scene();
+    if (!scene) return;
+
+    if (scene->PlayState() == ZPlayState::Playing) {
+        Update(deltaTime);
+    }
+
+    if (particles_.count == 0) return;
+
+    PackInstances();
+    quad_->UpdateInstances(instances_.data(), particles_.count);
+
+    graphicsComp_->SetGameLights(scene->GameLights());
+    graphicsComp_->SetGameCamera(scene->ActiveCamera());
+    graphicsComp_->Prepare(deltaTime);
 }
 
 void ZParticleSystem::Update(double deltaTime)
 {
-// TODO: Create a particle based on a particle rule and set its age randomly between the min and max ages.
-// Also set the velocity randomly between the min and max velocities. If emitting randomly,
-// pick randmly from the list of provided particles rules to create the particle.
-// Make sure emissionRate time has elapsed before the previous emission to emit a new particle.
+    ZPR_ZONE("Particle Update")
+    float dt = static_cast<float>(deltaTime);
+
+    Simulate(dt);
+    Compact();
+
+    for (ZParticleEmitter& emitter : emitters_)
+    {
+        if (!isAlive_)
+        {
+            emitter.accumulator = 0.f;
+            continue;
+        }
+        emitter.accumulator += emitter.rate * dt;
+        unsigned int count = static_cast<unsigned int>(emitter.accumulator);
+        emitter.accumulator -= count;
+        Emit(emitter, count);
+    }
+}
+
+void ZParticleSystem::SetMaxParticles(unsigned int maxParticles)
+{
+    maxParticles_ = maxParticles;
+    particles_.Resize(maxParticles_);
+    instances_.resize(maxParticles_);
+}
+
+void ZParticleSystem::Emit(ZParticleEmitter& emitter, unsigned int count)
+{
+    count = std::min(count, maxParticles_ - particles_.count);
+    if (count == 0) return;
+
+    const ZParticleRule& rule = emitter.rule;
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+    glm::vec3 origin = Position() + emitter.offset;
+    glm::vec3 direction = glm::length2(rule.direction) > 0.f ? glm::normalize(rule.direction) : glm::vec3(0.f, 1.f, 0.f);
+
+    for (unsigned int n = 0; n < count; n++)
+    {
+        unsigned int i = particles_.count++;
+
+        glm::vec3 position = origin + emitter.extents * (glm::vec3(unit(random_), unit(random_), unit(random_)) * 2.f - 1.f);
+
+        // Jitter the emission direction by a uniformly distributed unit vector scaled by the spread
+        float z = unit(random_) * 2.f - 1.f;
+        float phi = unit(random_) * glm::two_pi<float>();
+        float radius = std::sqrt(1.f - z * z);
+        glm::vec3 heading = direction + rule.spread * glm::vec3(radius * std::cos(phi), radius * std::sin(phi), z);
+        heading = glm::length2(heading) > 0.f ? glm::normalize(heading) : direction;
+        glm::vec3 velocity = heading * glm::mix(rule.minVelocity, rule.maxVelocity, unit(random_));
+
+        float lifetime = std::max(glm::mix(rule.minAge, rule.maxAge, unit(random_)), 0.001f);
+        float size = glm::mix(rule.minSize, rule.maxSize, unit(random_));
+        glm::vec4 colorRate = (rule.endColor - rule.startColor) / lifetime;
+
+        particles_.positionX[i] = position.x; particles_.positionY[i] = position.y; particles_.positionZ[i] = position.z;
+        particles_.velocityX[i] = velocity.x; particles_.velocityY[i] = velocity.y; particles_.velocityZ[i] = velocity.z;
+        particles_.colorR[i] = rule.startColor.r; particles_.colorG[i] = rule.startColor.g;
+        particles_.colorB[i] = rule.startColor.b; particles_.colorA[i] = rule.startColor.a;
+        particles_.colorRateR[i] = colorRate.r; particles_.colorRateG[i] = colorRate.g;
+        particles_.colorRateB[i] = colorRate.b; particles_.colorRateA[i] = colorRate.a;
+        particles_.size[i] = size;
+        particles_.sizeRate[i] = size * (rule.endSizeScale - 1.f) / lifetime;
+        particles_.age[i] = 0.f;
+        particles_.lifetime[i] = lifetime;
+        particles_.damping[i] = rule.damping;
+    }
+}
+
+void ZParticleSystem::Simulate(float deltaTime)
+{
+    unsigned int count = particles_.count;
+    if (count == 0) return;
+
+    auto jobSystem = ZServices::JobSystem();
+    if (jobSystem && count > cParallelBatchSize)
+    {
+        std::vector<ZJob> jobs;
+        for (unsigned int begin = 0; begin < count; begin += cParallelBatchSize)
+        {
+            unsigned int end = std::min(begin + cParallelBatchSize, count);
+            jobs.push_back([this, begin, end, deltaTime] {
+                IntegrateParticles(particles_, begin, end, deltaTime, gravity_);
+                FadeParticles(particles_, begin, end, deltaTime);
+            });
+        }
+        jobSystem->Wait(jobSystem->Schedule(jobs));
+    }
+    else
+    {
+        IntegrateParticles(particles_, 0, count, deltaTime, gravity_);
+        FadeParticles(particles_, 0, count, deltaTime);
+    }
+}
+
+void ZParticleSystem::Compact()
+{
+    // Swap dead particles with the last live one. Draw order is not preserved, which is fine for
+    // blended particles that don't write depth.
+    unsigned int i = 0;
+    while (i < particles_.count)
+    {
+        if (particles_.age[i] >= particles_.lifetime[i])
+        {
+            particles_.Move(--particles_.count, i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+void ZParticleSystem::PackInstances()
+{
+    // The particle shader reads the center and size from the first column of the
+    // instance matrix and the color from the second, and builds the billboard itself
+    for (unsigned int i = 0, j = particles_.count; i < j; i++)
+    {
+        glm::mat4& instance = instances_[i];
+        instance[0] = glm::vec4(particles_.positionX[i], particles_.positionY[i], particles_.positionZ[i], particles_.size[i]);
+        instance[1] = glm::vec4(particles_.colorR[i], particles_.colorG[i], particles_.colorB[i], particles_.colorA[i]);
+    }
+}
+
+void ZParticleSystem::HandleTextureReady(const std::shared_ptr<ZTextureReadyEvent>& event)
+{
+    if (event->Texture()->name == textureId_)
+    {
+        auto particleMaterial = ZMaterial::Create({ event->Texture() }, ZShader::Create("/Shaders/Vertex/particle.vert", "/Shaders/Pixel/particle.frag"));
+        graphicsComp_->AddMaterial(particleMaterial);
+        ZServices::EventAgent()->Unsubscribe(this, &ZParticleSystem::HandleTextureReady);
+    }
 }
 
-DEFINE_OBJECT_CREATORS(ZParticleSystem)
\ No newline at end of file
+DEFINE_OBJECT_CREATORS(ZParticleSystem)
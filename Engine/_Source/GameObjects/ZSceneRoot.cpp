@@ -85,7 +85,9 @@ void ZSceneRoot::PrepareChildren(double deltaTime)
     if (scene->GameConfig().graphics.drawGrid)
         ZServices::Graphics()->DebugDrawGrid(scene, glm::vec4(0.75f, 0.75f, 0.75f, 1.f));
 
-    ZGameObject::PrepareChildren(deltaTime);
+    // Culling already resolved which objects need preparing this frame, so the hierarchy isn't walked
+    for (ZGameObject* object : scene->PreparedObjects())
+        object->Prepare(deltaTime);
 
     if (scene->GameConfig().graphics.drawPhysicsDebug)
         scene->PhysicsUniverse()->DebugDraw(scene);
@@ -36,9 +36,10 @@ ZAbstractPlane::ZAbstractPlane(const glm::vec3& p1, const glm::vec3& p2, const g
     center = normal * glm::dot(p1, normal);
 }
 
-float ZAbstractPlane::Distance(const glm::vec3& point)
+float ZAbstractPlane::Distance(const glm::vec3& point) const
 {
-    return glm::length(glm::dot(point, glm::normalize(normal)) - center);
+    // Signed distance, positive on the side the normal points to
+    return glm::dot(point - center, glm::normalize(normal));
 }
 
 glm::vec3 ZAbstractPlane::Intersection(const ZAbstractPlane& a, const ZAbstractPlane& b)
@@ -28,13 +28,63 @@
 */
 
 #include "ZBVH.hpp"
+#include "ZServices.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define ZBVH_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ZBVH_NEON
+#include <arm_neon.h>
+#endif
+
+// Number of SAH buckets used when binning primitive centroids
+constexpr int BVH_SAH_BUCKETS = 12;
+// Ranges smaller than this are always built on the calling thread
+constexpr int BVH_PARALLEL_BUILD_THRESHOLD = 4096;
+// Ranges at least this large also compute bounds and SAH bins across several threads
+constexpr int BVH_PARALLEL_BIN_THRESHOLD = 65536;
+
+// Number of rays traced together by the packet traversal
+constexpr int BVH_PACKET_SIZE = 4;
+// Maximum depth of the traversal stacks
+constexpr int BVH_MAX_TRAVERSAL_DEPTH = 64;
+// Magnitude that infinite inverse direction components are clamped to
+constexpr float BVH_MAX_INVERSE_DIRECTION = 1e30f;
+
+// Inverse ray direction for the slab tests. Axis aligned rays would otherwise get infinite components, and a ray
+// that starts exactly on a box face then computes 0 * inf = NaN, which the scalar and SIMD min/max resolve differently.
+static glm::vec3 InverseDirection(const glm::vec3& direction)
+{
+    return glm::clamp(1.f / direction, glm::vec3(-BVH_MAX_INVERSE_DIRECTION), glm::vec3(BVH_MAX_INVERSE_DIRECTION));
+}
 
 void ZBVH::Build()
+{
+    if (refitEnabled_ && Refit()) {
+        userPrimitives_.clear();
+        return;
+    }
+    Rebuild();
+}
+
+void ZBVH::Rebuild()
 {
     primitives_.swap(userPrimitives_);
     userPrimitives_.clear();
+    primitiveSlots_.resize(primitives_.size());
 
-    if (primitives_.empty()) return;
+    if (primitives_.empty()) {
+        nodes_.clear();
+        IndexPrimitives();
+        return;
+    }
+
+    if (buildMode_ == ZBVHBuildMode::Parallel) {
+        ParallelBuild();
+        IndexPrimitives();
+        return;
+    }
 
     std::vector<ZBVHPrimitiveInfo> primitiveInfo(primitives_.size());
     for (auto i = 0; i < primitives_.size(); ++i) {
@@ -50,6 +100,47 @@ void ZBVH::Build()
     int offset = 0; 
     nodes_.resize(totalNodes);
     FlattenBVHTree(root, &offset);
+
+    IndexPrimitives();
+}
+
+bool ZBVH::Refit()
+{
+    // Any change in the primitive set invalidates the tree topology, so we can only refit
+    // when the same objects as the last build were submitted this frame
+    if (nodes_.empty() || userPrimitives_.size() != primitiveSlots_.size()) return false;
+
+    dirtyLeaves_.clear();
+    for (size_t slot = 0; slot < userPrimitives_.size(); ++slot) {
+        // Scenes submit their objects in the same order every frame, so the submission slot finds the
+        // primitive directly. Comparing ids only confirms that the slot still holds the same object.
+        const ZBVHPrimitive& primitive = userPrimitives_[slot];
+        int index = primitiveSlots_[slot];
+        if (primitives_[index].objectId != primitive.objectId) return false;
+
+        ZAABBox& bounds = primitives_[index].bounds;
+        if (bounds.minimum != primitive.bounds.minimum || bounds.maximum != primitive.bounds.maximum) {
+            bounds = primitive.bounds;
+            dirtyLeaves_.push_back(primitiveLeaves_[index]);
+        }
+    }
+
+    for (int leaf : dirtyLeaves_) {
+        RefitNode(leaf);
+    }
+
+    // Refitting keeps the topology of the last build, which degrades as objects move away from
+    // where they were when the tree was built. Once the unnormalized SAH cost has grown enough it is cheaper to rebuild.
+    // We don't normalize by the root area here since a growing root would hide the growth of the inner nodes.
+    return interiorArea_ + leafArea_ <= builtArea_ * refitThreshold_;
+}
+
+float ZBVH::Cost() const
+{
+    if (nodes_.empty()) return 0.f;
+    float rootArea = nodes_[0].bounds.SurfaceArea();
+    if (rootArea <= 0.f) return 0.f;
+    return (interiorArea_ + leafArea_) / rootArea;
 }
 
 void ZBVH::AddPrimitive(const ZBVHPrimitive& primitive)
@@ -59,25 +150,47 @@ void ZBVH::AddPrimitive(const ZBVHPrimitive& primitive)
 
 bool ZBVH::Intersect(ZRay& ray, ZIntersectHitResult& hitResult)
 {
-    if (primitives_.empty()) return false;
+    ZBVHHit hit;
+    if (!Intersect(static_cast<const ZRay&>(ray), hit)) return false;
+
+    hitResult.objectId = primitives_[hit.primitive].objectId;
+    ray.tMax = hit.distance;
+    return true;
+}
+
+bool ZBVH::Intersect(const ZRay& ray, ZBVHHit& hit) const
+{
+    hit = ZBVHHit();
+    if (nodes_.empty()) return false;
 
-    bool hit = false;
-    glm::vec3 invDir = 1.f / ray.Direction();
+    const glm::vec3& origin = ray.Origin();
+    glm::vec3 invDir = InverseDirection(ray.Direction());
     int dirIsNegative[3] = { invDir.x < 0, invDir.y < 0, invDir.z < 0 };
 
+    // Returns the entry distance of the ray into the box, or a negative value on a miss
+    auto slabTest = [&origin, &invDir](const ZAABBox& box, float& tEntry) {
+        glm::vec3 t0 = (box.minimum - origin) * invDir;
+        glm::vec3 t1 = (box.maximum - origin) * invDir;
+        glm::vec3 tNear = glm::min(t0, t1), tFar = glm::max(t0, t1);
+        tEntry = std::max({ tNear.x, tNear.y, tNear.z });
+        float tExit = std::min({ tFar.x, tFar.y, tFar.z });
+        return tEntry <= tExit && tExit >= 0.f;
+    };
+
     int toVisitOffset = 0, currentNodeIndex = 0;
-    int nodesToVisit[64];
-    std::map<int, std::string> hits;
+    int nodesToVisit[BVH_MAX_TRAVERSAL_DEPTH];
     while (true) {
-        ZLinearBVHNode& node = nodes_[currentNodeIndex];
-        if (node.bounds.Intersects(ray)) {
+        const ZLinearBVHNode& node = nodes_[currentNodeIndex];
+        float tEntry;
+        if (slabTest(node.bounds, tEntry) && tEntry < hit.distance) {
             if (node.primitiveCount > 0) {
                 for (auto i = 0; i < node.primitiveCount; ++i) {
-                    auto& prim = primitives_[static_cast<size_t>(node.primitiveOffset) + i];
-                    if (prim.bounds.Intersects(ray) && ray.tMax > 0) {
-                        hits[ray.tMax] = prim.objectId;
-                        hitResult.objectId = prim.objectId;
-                        hit = true;
+                    int primitive = node.primitiveOffset + i;
+                    // Primitives that contain the ray origin are skipped so that picking from inside
+                    // an object still selects what is in front of it
+                    if (slabTest(primitives_[primitive].bounds, tEntry) && tEntry > 0.f && tEntry < hit.distance) {
+                        hit.primitive = primitive;
+                        hit.distance = tEntry;
                     }
                 }
                 if (toVisitOffset == 0) break;
@@ -100,10 +213,26 @@ bool ZBVH::Intersect(ZRay& ray, ZIntersectHitResult& hitResult)
         }
     }
 
-    if (!hits.empty())
-        hitResult.objectId = hits.begin()->second;
+    return hit.primitive >= 0;
+}
 
-    return hit;
+int ZBVH::IntersectMany(const ZRay* rays, int count, ZBVHHit* hits) const
+{
+    for (auto i = 0; i < count; i += BVH_PACKET_SIZE) {
+        IntersectPacket(rays + i, std::min(BVH_PACKET_SIZE, count - i), hits + i);
+    }
+
+    int hitCount = 0;
+    for (auto i = 0; i < count; ++i) {
+        hitCount += hits[i].primitive >= 0;
+    }
+    return hitCount;
+}
+
+int ZBVH::IntersectMany(const std::vector<ZRay>& rays, std::vector<ZBVHHit>& hits) const
+{
+    hits.resize(rays.size());
+    return IntersectMany(rays.data(), rays.size(), hits.data());
 }
 
 std::shared_ptr<ZBVHBuildNode> ZBVH::RecursiveBuild(std::vector<ZBVHPrimitiveInfo>& primitiveInfo, int start, int end, int* totalNodes, std::vector<ZBVHPrimitive>& orderedPrimitives)
@@ -236,6 +365,7 @@ std::shared_ptr<ZBVHBuildNode> ZBVH::CreateLeafNode(std::vector<ZBVHPrimitive>&
     int firstPrimitiveOffset = orderedPrimitives.size();
     for (auto i = start; i < end; ++i) {
         int primitiveIndex = primitiveInfo[i].index;
+        primitiveSlots_[primitiveIndex] = orderedPrimitives.size();
         orderedPrimitives.push_back(primitives_[primitiveIndex]);
     }
     return std::make_shared<ZBVHBuildNode>(firstPrimitiveOffset, primitiveCount, bounds);
@@ -258,3 +388,451 @@ int ZBVH::FlattenBVHTree(const std::shared_ptr<ZBVHBuildNode>& node, int* offset
     }
     return thisOffset;
 }
+
+void ZBVH::IndexPrimitives()
+{
+    primitiveLeaves_.assign(primitives_.size(), 0);
+    nodeParents_.assign(nodes_.size(), -1);
+    interiorArea_ = 0.f;
+    leafArea_ = 0.f;
+
+    for (int i = 0; i < static_cast<int>(nodes_.size()); ++i) {
+        const ZLinearBVHNode& node = nodes_[i];
+        if (node.primitiveCount > 0) {
+            for (auto j = 0; j < node.primitiveCount; ++j) {
+                primitiveLeaves_[static_cast<size_t>(node.primitiveOffset) + j] = i;
+            }
+            leafArea_ += node.bounds.SurfaceArea() * node.primitiveCount;
+        }
+        else {
+            nodeParents_[i + 1] = i;
+            nodeParents_[node.secondChildOffset] = i;
+            interiorArea_ += node.bounds.SurfaceArea();
+        }
+    }
+
+    builtArea_ = interiorArea_ + leafArea_;
+}
+
+void ZBVH::RefitNode(int nodeIndex)
+{
+    while (nodeIndex >= 0) {
+        ZLinearBVHNode& node = nodes_[nodeIndex];
+        ZAABBox bounds;
+        if (node.primitiveCount > 0) {
+            for (auto i = 0; i < node.primitiveCount; ++i) {
+                bounds = ZAABBox::Union(bounds, primitives_[static_cast<size_t>(node.primitiveOffset) + i].bounds);
+            }
+        }
+        else {
+            bounds = ZAABBox::Union(nodes_[nodeIndex + 1].bounds, nodes_[node.secondChildOffset].bounds);
+        }
+
+        if (bounds.minimum == node.bounds.minimum && bounds.maximum == node.bounds.maximum) break;
+
+        float areaDelta = bounds.SurfaceArea() - node.bounds.SurfaceArea();
+        if (node.primitiveCount > 0)
+            leafArea_ += areaDelta * node.primitiveCount;
+        else
+            interiorArea_ += areaDelta;
+
+        node.bounds = bounds;
+        nodeIndex = nodeParents_[nodeIndex];
+    }
+}
+
+void ZBVH::ParallelBuild()
+{
+    int primitiveCount = primitives_.size();
+
+    primitiveInfo_.resize(primitiveCount);
+    for (auto i = 0; i < primitiveCount; ++i) {
+        primitiveInfo_[i] = { i, primitives_[i].bounds };
+    }
+
+    // A binary tree with n leaves has at most 2n - 1 nodes, so the arena never has to grow
+    // during the build and tasks can claim nodes with a single atomic increment
+    size_t arenaCapacity = 2 * static_cast<size_t>(primitiveCount) - 1;
+    if (arena_.size() < arenaCapacity) {
+        arena_.resize(arenaCapacity);
+    }
+    arenaSize_ = 0;
+
+    // Subtrees and large bounds/binning passes are spread over the job system's workers, with the building
+    // thread helping out while it waits. Only the top levels are split into tasks, since below that there
+    // is enough work per thread already.
+    auto jobSystem = ZServices::JobSystem();
+    buildThreads_ = jobSystem ? static_cast<int>(jobSystem->ThreadCount()) + 1 : 1;
+    buildTaskDepth_ = static_cast<int>(std::log2(buildThreads_)) + 1;
+
+    // Levels that split their passes have buildThreads_ >> depth >= 2 tasks per node and at most 2^depth
+    // nodes, so each of those levels needs buildThreads_ slots
+    int passLevels = static_cast<int>(std::log2(buildThreads_));
+    size_t partialCount = static_cast<size_t>(passLevels) * buildThreads_;
+    if (boundsPartials_.size() < partialCount) {
+        boundsPartials_.resize(partialCount);
+        bucketPartials_.resize(partialCount * BVH_SAH_BUCKETS);
+    }
+
+    int root = ArenaBuild(0, primitiveCount, 0, 0);
+
+    // Leaves reference their range of the partitioned primitive info directly, so the
+    // primitives only need to be reordered once at the end
+    orderedPrimitives_.clear();
+    orderedPrimitives_.reserve(primitiveCount);
+    for (auto i = 0; i < primitiveCount; ++i) {
+        primitiveSlots_[primitiveInfo_[i].index] = i;
+        orderedPrimitives_.emplace_back(std::move(primitives_[primitiveInfo_[i].index]));
+    }
+    primitives_.swap(orderedPrimitives_);
+
+    int offset = 0;
+    nodes_.resize(arenaSize_);
+    FlattenArena(root, &offset);
+}
+
+int ZBVH::ArenaBuild(int start, int end, int depth, int slot)
+{
+    ZAABBox bounds, centroidBounds;
+    ComputeBounds(start, end, bounds, centroidBounds, depth, slot);
+
+    int primitiveCount = end - start;
+    if (primitiveCount == 1) {
+        return CreateArenaLeaf(start, end, bounds);
+    }
+
+    int axis = centroidBounds.MaxExtent();
+    if (centroidBounds.maximum[axis] == centroidBounds.minimum[axis]) {
+        return CreateArenaLeaf(start, end, bounds);
+    }
+
+    auto info = primitiveInfo_.data();
+    auto centroidCompare = [axis](const ZBVHPrimitiveInfo& a, const ZBVHPrimitiveInfo& b) {
+        return a.centroid[axis] < b.centroid[axis];
+    };
+
+    int mid = (start + end) / 2;
+    switch (splitMethod_) {
+    case ZBVHSplitMethod::Middle: {
+        float midPartition = (centroidBounds.minimum[axis] + centroidBounds.maximum[axis]) / 2.f;
+        ZBVHPrimitiveInfo* midPtr = std::partition(info + start, info + end,
+            [axis, midPartition](const ZBVHPrimitiveInfo& pi) {
+                return pi.centroid[axis] < midPartition;
+            });
+        mid = midPtr - info;
+        if (mid != start && mid != end)
+            break;
+    }
+    case ZBVHSplitMethod::EqualCounts: {
+        mid = (start + end) / 2;
+        std::nth_element(info + start, info + mid, info + end, centroidCompare);
+        break;
+    }
+    case ZBVHSplitMethod::SAH: {
+        if (primitiveCount <= 2) {
+            mid = (start + end) / 2;
+            std::nth_element(info + start, info + mid, info + end, centroidCompare);
+            break;
+        }
+
+        ZBVHBucketInfo buckets[BVH_SAH_BUCKETS];
+        BinPrimitives(start, end, axis, centroidBounds, buckets, depth, slot);
+
+        // Sweep the buckets once from each side instead of re-unioning every candidate split
+        float cost[BVH_SAH_BUCKETS - 1];
+        ZAABBox below, above;
+        int countBelow = 0, countAbove = 0;
+        for (auto i = 0; i < BVH_SAH_BUCKETS - 1; ++i) {
+            below = ZAABBox::Union(below, buckets[i].bounds);
+            countBelow += buckets[i].count;
+            cost[i] = countBelow > 0 ? countBelow * below.SurfaceArea() : 0.f;
+        }
+        for (auto i = BVH_SAH_BUCKETS - 1; i > 0; --i) {
+            above = ZAABBox::Union(above, buckets[i].bounds);
+            countAbove += buckets[i].count;
+            cost[i - 1] += countAbove > 0 ? countAbove * above.SurfaceArea() : 0.f;
+        }
+
+        int minCostBucket = 0;
+        for (auto i = 1; i < BVH_SAH_BUCKETS - 1; ++i) {
+            if (cost[i] < cost[minCostBucket]) {
+                minCostBucket = i;
+            }
+        }
+        float minCost = 1 + cost[minCostBucket] / bounds.SurfaceArea();
+
+        float leafCost = primitiveCount;
+        if (static_cast<unsigned int>(primitiveCount) <= maxNodePrimitives_ && minCost >= leafCost) {
+            return CreateArenaLeaf(start, end, bounds);
+        }
+
+        ZBVHPrimitiveInfo* midInfo = std::partition(info + start, info + end,
+            [=](const ZBVHPrimitiveInfo& pi) {
+                int b = BVH_SAH_BUCKETS * centroidBounds.Offset(pi.centroid)[axis];
+                if (b == BVH_SAH_BUCKETS) b = BVH_SAH_BUCKETS - 1;
+                return b <= minCostBucket;
+            });
+        mid = midInfo - info;
+
+        // Default to middle split if partition is still not generous enough
+        if (mid == start || mid == end) {
+            mid = (start + end) / 2;
+            std::nth_element(info + start, info + mid, info + end, centroidCompare);
+        }
+        break;
+    }
+    }
+
+    // The two halves touch disjoint ranges of the primitive info, so they can be built concurrently.
+    // Slots only matter while a level can still split its passes, so they stop growing past the task levels.
+    int children[2];
+    int childSlot = depth < buildTaskDepth_ ? slot * 2 : 0;
+    if (primitiveCount >= BVH_PARALLEL_BUILD_THRESHOLD && depth < buildTaskDepth_ && buildThreads_ > 1) {
+        auto jobSystem = ZServices::JobSystem();
+        auto counter = jobSystem->Schedule([this, &children, start, mid, depth, childSlot] {
+            children[0] = ArenaBuild(start, mid, depth + 1, childSlot);
+        });
+        children[1] = ArenaBuild(mid, end, depth + 1, childSlot + 1);
+        jobSystem->Wait(counter);
+    }
+    else {
+        children[0] = ArenaBuild(start, mid, depth + 1, childSlot);
+        children[1] = ArenaBuild(mid, end, depth + 1, childSlot + 1);
+    }
+
+    int nodeIndex = arenaSize_++;
+    ZBVHArenaNode& node = arena_[nodeIndex];
+    node.bounds = bounds;
+    node.children[0] = children[0];
+    node.children[1] = children[1];
+    node.splitAxis = axis;
+    node.firstPrimitiveOffset = 0;
+    node.primitivesCount = 0;
+    return nodeIndex;
+}
+
+int ZBVH::CreateArenaLeaf(int start, int end, const ZAABBox& bounds)
+{
+    int nodeIndex = arenaSize_++;
+    ZBVHArenaNode& node = arena_[nodeIndex];
+    node.bounds = bounds;
+    node.children[0] = node.children[1] = -1;
+    node.splitAxis = 0;
+    node.firstPrimitiveOffset = start;
+    node.primitivesCount = end - start;
+    return nodeIndex;
+}
+
+void ZBVH::ComputeBounds(int start, int end, ZAABBox& bounds, ZAABBox& centroidBounds, int depth, int slot)
+{
+    auto computeRange = [this](int first, int last, ZAABBox& b, ZAABBox& cb) {
+        for (auto i = first; i < last; ++i) {
+            b = ZAABBox::Union(b, primitiveInfo_[i].bounds);
+            cb = ZAABBox::Union(cb, primitiveInfo_[i].centroid);
+        }
+    };
+
+    int taskCount = buildThreads_ >> depth;
+    if (end - start < BVH_PARALLEL_BIN_THRESHOLD || taskCount < 2) {
+        computeRange(start, end, bounds, centroidBounds);
+        return;
+    }
+
+    auto partials = boundsPartials_.data() + static_cast<size_t>(depth) * buildThreads_ + static_cast<size_t>(slot) * taskCount;
+    std::fill(partials, partials + taskCount, std::pair<ZAABBox, ZAABBox>());
+    int chunkSize = (end - start + taskCount - 1) / taskCount;
+
+    auto jobSystem = ZServices::JobSystem();
+    std::shared_ptr<ZJobCounter> counter;
+    for (auto t = 1; t < taskCount; ++t) {
+        int first = std::min(end, start + t * chunkSize), last = std::min(end, first + chunkSize);
+        auto partial = partials + t;
+        counter = jobSystem->Schedule([=] { computeRange(first, last, partial->first, partial->second); }, nullptr, counter);
+    }
+    computeRange(start, std::min(end, start + chunkSize), partials[0].first, partials[0].second);
+    jobSystem->Wait(counter);
+
+    for (auto t = 0; t < taskCount; ++t) {
+        bounds = ZAABBox::Union(bounds, partials[t].first);
+        centroidBounds = ZAABBox::Union(centroidBounds, partials[t].second);
+    }
+}
+
+void ZBVH::BinPrimitives(int start, int end, int axis, const ZAABBox& centroidBounds, ZBVHBucketInfo* buckets, int depth, int slot)
+{
+    auto binRange = [this, axis, &centroidBounds](int first, int last, ZBVHBucketInfo* bins) {
+        for (auto i = first; i < last; ++i) {
+            int b = BVH_SAH_BUCKETS * centroidBounds.Offset(primitiveInfo_[i].centroid)[axis];
+            if (b == BVH_SAH_BUCKETS) b = BVH_SAH_BUCKETS - 1;
+            bins[b].count++;
+            bins[b].bounds = ZAABBox::Union(bins[b].bounds, primitiveInfo_[i].bounds);
+        }
+    };
+
+    int taskCount = buildThreads_ >> depth;
+    if (end - start < BVH_PARALLEL_BIN_THRESHOLD || taskCount < 2) {
+        binRange(start, end, buckets);
+        return;
+    }
+
+    // Each task bins its own chunk into a private set of buckets, which are merged afterwards
+    auto partials = bucketPartials_.data() + (static_cast<size_t>(depth) * buildThreads_ + static_cast<size_t>(slot) * taskCount) * BVH_SAH_BUCKETS;
+    std::fill(partials, partials + static_cast<size_t>(taskCount) * BVH_SAH_BUCKETS, ZBVHBucketInfo());
+    int chunkSize = (end - start + taskCount - 1) / taskCount;
+
+    auto jobSystem = ZServices::JobSystem();
+    std::shared_ptr<ZJobCounter> counter;
+    for (auto t = 1; t < taskCount; ++t) {
+        int first = std::min(end, start + t * chunkSize), last = std::min(end, first + chunkSize);
+        auto bins = partials + static_cast<size_t>(t) * BVH_SAH_BUCKETS;
+        counter = jobSystem->Schedule([=] { binRange(first, last, bins); }, nullptr, counter);
+    }
+    binRange(start, std::min(end, start + chunkSize), partials);
+    jobSystem->Wait(counter);
+
+    for (auto t = 0; t < taskCount; ++t) {
+        for (auto b = 0; b < BVH_SAH_BUCKETS; ++b) {
+            const ZBVHBucketInfo& partial = partials[static_cast<size_t>(t) * BVH_SAH_BUCKETS + b];
+            buckets[b].count += partial.count;
+            buckets[b].bounds = ZAABBox::Union(buckets[b].bounds, partial.bounds);
+        }
+    }
+}
+
+int ZBVH::FlattenArena(int nodeIndex, int* offset)
+{
+    const ZBVHArenaNode& node = arena_[nodeIndex];
+    ZLinearBVHNode& linearNode = nodes_[*offset];
+    linearNode.bounds = node.bounds;
+    int thisOffset = (*offset)++;
+    if (node.primitivesCount > 0) {
+        linearNode.primitiveOffset = node.firstPrimitiveOffset;
+        linearNode.primitiveCount = node.primitivesCount;
+    }
+    else {
+        linearNode.axis = node.splitAxis;
+        linearNode.primitiveCount = 0;
+        FlattenArena(node.children[0], offset);
+        linearNode.secondChildOffset = FlattenArena(node.children[1], offset);
+    }
+    return thisOffset;
+}
+
+namespace
+{
+    // Structure-of-arrays layout of a ray packet so that each slab test runs across all rays at once
+    struct alignas(16) ZBVHRayPacket
+    {
+        float originX[BVH_PACKET_SIZE], originY[BVH_PACKET_SIZE], originZ[BVH_PACKET_SIZE];
+        float invDirX[BVH_PACKET_SIZE], invDirY[BVH_PACKET_SIZE], invDirZ[BVH_PACKET_SIZE];
+        float tClosest[BVH_PACKET_SIZE];
+    };
+
+    // Tests a box against every ray of the packet. Returns a bit mask of the rays that enter the box
+    // in front of their closest hit so far, and writes each ray's entry distance.
+    inline int SlabTestPacket(const ZAABBox& box, const ZBVHRayPacket& packet, float* tEntry)
+    {
+#if defined(ZBVH_SSE)
+        __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.minimum.x), _mm_load_ps(packet.originX)), _mm_load_ps(packet.invDirX));
+        __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.maximum.x), _mm_load_ps(packet.originX)), _mm_load_ps(packet.invDirX));
+        __m128 tNear = _mm_min_ps(t0, t1), tFar = _mm_max_ps(t0, t1);
+        t0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.minimum.y), _mm_load_ps(packet.originY)), _mm_load_ps(packet.invDirY));
+        t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.maximum.y), _mm_load_ps(packet.originY)), _mm_load_ps(packet.invDirY));
+        tNear = _mm_max_ps(tNear, _mm_min_ps(t0, t1)); tFar = _mm_min_ps(tFar, _mm_max_ps(t0, t1));
+        t0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.minimum.z), _mm_load_ps(packet.originZ)), _mm_load_ps(packet.invDirZ));
+        t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.maximum.z), _mm_load_ps(packet.originZ)), _mm_load_ps(packet.invDirZ));
+        tNear = _mm_max_ps(tNear, _mm_min_ps(t0, t1)); tFar = _mm_min_ps(tFar, _mm_max_ps(t0, t1));
+        _mm_store_ps(tEntry, tNear);
+        __m128 hit = _mm_and_ps(_mm_cmple_ps(tNear, tFar), _mm_cmpge_ps(tFar, _mm_setzero_ps()));
+        hit = _mm_and_ps(hit, _mm_cmplt_ps(tNear, _mm_load_ps(packet.tClosest)));
+        return _mm_movemask_ps(hit);
+#elif defined(ZBVH_NEON)
+        float32x4_t t0 = vmulq_f32(vsubq_f32(vdupq_n_f32(box.minimum.x), vld1q_f32(packet.originX)), vld1q_f32(packet.invDirX));
+        float32x4_t t1 = vmulq_f32(vsubq_f32(vdupq_n_f32(box.maximum.x), vld1q_f32(packet.originX)), vld1q_f32(packet.invDirX));
+        float32x4_t tNear = vminq_f32(t0, t1), tFar = vmaxq_f32(t0, t1);
+        t0 = vmulq_f32(vsubq_f32(vdupq_n_f32(box.minimum.y), vld1q_f32(packet.originY)), vld1q_f32(packet.invDirY));
+        t1 = vmulq_f32(vsubq_f32(vdupq_n_f32(box.maximum.y), vld1q_f32(packet.originY)), vld1q_f32(packet.invDirY));
+        tNear = vmaxq_f32(tNear, vminq_f32(t0, t1)); tFar = vminq_f32(tFar, vmaxq_f32(t0, t1));
+        t0 = vmulq_f32(vsubq_f32(vdupq_n_f32(box.minimum.z), vld1q_f32(packet.originZ)), vld1q_f32(packet.invDirZ));
+        t1 = vmulq_f32(vsubq_f32(vdupq_n_f32(box.maximum.z), vld1q_f32(packet.originZ)), vld1q_f32(packet.invDirZ));
+        tNear = vmaxq_f32(tNear, vminq_f32(t0, t1)); tFar = vminq_f32(tFar, vmaxq_f32(t0, t1));
+        vst1q_f32(tEntry, tNear);
+        uint32x4_t hit = vandq_u32(vcleq_f32(tNear, tFar), vcgeq_f32(tFar, vdupq_n_f32(0.f)));
+        hit = vandq_u32(hit, vcltq_f32(tNear, vld1q_f32(packet.tClosest)));
+        return (vgetq_lane_u32(hit, 0) & 1) | (vgetq_lane_u32(hit, 1) & 2) | (vgetq_lane_u32(hit, 2) & 4) | (vgetq_lane_u32(hit, 3) & 8);
+#else
+        int mask = 0;
+        for (auto i = 0; i < BVH_PACKET_SIZE; ++i) {
+            float t0 = (box.minimum.x - packet.originX[i]) * packet.invDirX[i], t1 = (box.maximum.x - packet.originX[i]) * packet.invDirX[i];
+            float tNear = std::min(t0, t1), tFar = std::max(t0, t1);
+            t0 = (box.minimum.y - packet.originY[i]) * packet.invDirY[i]; t1 = (box.maximum.y - packet.originY[i]) * packet.invDirY[i];
+            tNear = std::max(tNear, std::min(t0, t1)); tFar = std::min(tFar, std::max(t0, t1));
+            t0 = (box.minimum.z - packet.originZ[i]) * packet.invDirZ[i]; t1 = (box.maximum.z - packet.originZ[i]) * packet.invDirZ[i];
+            tNear = std::max(tNear, std::min(t0, t1)); tFar = std::min(tFar, std::max(t0, t1));
+            tEntry[i] = tNear;
+            mask |= (tNear <= tFar && tFar >= 0.f && tNear < packet.tClosest[i]) << i;
+        }
+        return mask;
+#endif
+    }
+}
+
+void ZBVH::IntersectPacket(const ZRay* rays, int count, ZBVHHit* hits) const
+{
+    for (auto i = 0; i < count; ++i) {
+        hits[i] = ZBVHHit();
+    }
+    if (nodes_.empty()) return;
+
+    ZBVHRayPacket packet;
+    int activeMask = (1 << count) - 1;
+    for (auto i = 0; i < BVH_PACKET_SIZE; ++i) {
+        // Unused lanes duplicate the first ray and are masked out of the results
+        const ZRay& ray = rays[i < count ? i : 0];
+        glm::vec3 invDir = InverseDirection(ray.Direction());
+        packet.originX[i] = ray.Origin().x; packet.originY[i] = ray.Origin().y; packet.originZ[i] = ray.Origin().z;
+        packet.invDirX[i] = invDir.x; packet.invDirY[i] = invDir.y; packet.invDirZ[i] = invDir.z;
+        packet.tClosest[i] = std::numeric_limits<float>::max();
+    }
+
+    // Child ordering follows the first ray of the packet, which works best for coherent packets
+    int dirIsNegative[3] = { packet.invDirX[0] < 0, packet.invDirY[0] < 0, packet.invDirZ[0] < 0 };
+
+    alignas(16) float tEntry[BVH_PACKET_SIZE];
+    int toVisitOffset = 0, currentNodeIndex = 0;
+    int nodesToVisit[BVH_MAX_TRAVERSAL_DEPTH];
+    while (true) {
+        const ZLinearBVHNode& node = nodes_[currentNodeIndex];
+        if (SlabTestPacket(node.bounds, packet, tEntry) & activeMask) {
+            if (node.primitiveCount > 0) {
+                for (auto i = 0; i < node.primitiveCount; ++i) {
+                    int primitive = node.primitiveOffset + i;
+                    int mask = SlabTestPacket(primitives_[primitive].bounds, packet, tEntry) & activeMask;
+                    for (auto r = 0; mask; ++r, mask >>= 1) {
+                        if ((mask & 1) && tEntry[r] > 0.f) {
+                            packet.tClosest[r] = tEntry[r];
+                            hits[r].primitive = primitive;
+                            hits[r].distance = tEntry[r];
+                        }
+                    }
+                }
+                if (toVisitOffset == 0) break;
+                currentNodeIndex = nodesToVisit[--toVisitOffset];
+            }
+            else {
+                if (dirIsNegative[node.axis]) {
+                    nodesToVisit[toVisitOffset++] = currentNodeIndex + 1;
+                    currentNodeIndex = node.secondChildOffset;
+                }
+                else {
+                    nodesToVisit[toVisitOffset++] = node.secondChildOffset;
+                    currentNodeIndex += 1;
+                }
+            }
+        }
+        else {
+            if (toVisitOffset == 0) break;
+            currentNodeIndex = nodesToVisit[--toVisitOffset];
+        }
+    }
+}
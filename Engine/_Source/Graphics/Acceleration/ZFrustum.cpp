@@ -74,15 +74,22 @@ void ZFrustum::Recalculate()
     }
     center /= 8;
 
-    planes[NEAR] = ZAbstractPlane(corners[0], corners[0], corners[2]);
+    planes[NEAR] = ZAbstractPlane(corners[1], corners[0], corners[2]);
     planes[FAR] = ZAbstractPlane(corners[5], corners[4], corners[7]);
     planes[TOP] = ZAbstractPlane(corners[1], corners[0], corners[4]);
     planes[BOTTOM] = ZAbstractPlane(corners[3], corners[2], corners[6]);
     planes[LEFT] = ZAbstractPlane(corners[0], corners[3], corners[7]);
     planes[RIGHT] = ZAbstractPlane(corners[2], corners[1], corners[6]);
+
+    // Make every plane face inwards so that points inside the frustum have a positive distance
+    for (auto& plane : planes) {
+        if (plane.Distance(center) < 0.f) {
+            plane.normal = -plane.normal;
+        }
+    }
 }
 
-bool ZFrustum::Contains(const glm::vec3& point)
+bool ZFrustum::Contains(const glm::vec3& point) const
 {
     for (int plane = 0; plane < NUMPLANES; plane++)
     {
@@ -92,7 +99,7 @@ bool ZFrustum::Contains(const glm::vec3& point)
     return true;
 }
 
-bool ZFrustum::Contains(const glm::vec3& center, float radius)
+bool ZFrustum::Contains(const glm::vec3& center, float radius) const
 {
     float distance;
     for (int plane = 0; plane < NUMPLANES; plane++)
@@ -106,12 +113,18 @@ bool ZFrustum::Contains(const glm::vec3& center, float radius)
     return true;
 }
 
-bool ZFrustum::Contains(const ZAABBox& box)
+bool ZFrustum::Contains(const ZAABBox& box) const
 {
     for (int plane = 0; plane < NUMPLANES; plane++)
     {
-        if (planes[plane].Distance(box.maximum) < 0 &&
-            planes[plane].Distance(box.minimum) < 0)
+        // The box is outside if even its corner furthest along the plane normal (the p-vertex) is behind the plane
+        const glm::vec3& normal = planes[plane].normal;
+        glm::vec3 pVertex(
+            normal.x >= 0.f ? box.maximum.x : box.minimum.x,
+            normal.y >= 0.f ? box.maximum.y : box.minimum.y,
+            normal.z >= 0.f ? box.maximum.z : box.minimum.z
+        );
+        if (planes[plane].Distance(pVertex) < 0.f)
         {
             return false;
         }
@@ -119,7 +132,7 @@ bool ZFrustum::Contains(const ZAABBox& box)
     return true;
 }
 
-bool ZFrustum::Contains(const ZFrustum& frustum)
+bool ZFrustum::Contains(const ZFrustum&) const
 {
 // TODO:
     return true;
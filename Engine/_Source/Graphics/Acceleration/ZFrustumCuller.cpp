@@ -0,0 +1,156 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZFrustumCuller.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZFrustumCuller.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define ZCULL_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ZCULL_NEON
+#include <arm_neon.h>
+#endif
+
+void ZFrustumCuller::Clear()
+{
+    minX_.clear(); minY_.clear(); minZ_.clear();
+    maxX_.clear(); maxY_.clear(); maxZ_.clear();
+}
+
+uint32_t ZFrustumCuller::Add(const ZAABBox& bounds)
+{
+    minX_.push_back(bounds.minimum.x); minY_.push_back(bounds.minimum.y); minZ_.push_back(bounds.minimum.z);
+    maxX_.push_back(bounds.maximum.x); maxY_.push_back(bounds.maximum.y); maxZ_.push_back(bounds.maximum.z);
+    return static_cast<uint32_t>(minX_.size() - 1);
+}
+
+/**
+    Tests every box against the given planes and writes the indices of the boxes that are at least
+    partially inside. A box is rejected as soon as its p-vertex, the corner furthest along a plane's
+    normal, lies behind that plane.
+
+    @param planes the inward facing view planes, i.e. from Planes().
+    @param outVisible the list that receives the visible box indices, in increasing order.
+    @param cullNear whether to test the near plane. Shadow views skip it so that casters between
+    the light and the view volume are kept.
+*/
+void ZFrustumCuller::Cull(const ZFrustumPlanes& planes, std::vector<uint32_t>& outVisible, bool cullNear) const
+{
+    outVisible.clear();
+
+    const uint32_t count = static_cast<uint32_t>(Size());
+    outVisible.reserve(count);
+
+    // Since the normal is shared by every box, picking the p-vertex boils down to picking the min or
+    // max array per axis once per plane
+    struct PlaneSetup
+    {
+        glm::vec4 plane;
+        const float* x; const float* y; const float* z;
+    } setups[ZFrustum::NUMPLANES];
+    int planeCount = 0;
+    for (int i = 0; i < ZFrustum::NUMPLANES; i++) {
+        if (!cullNear && i == ZFrustum::NEAR) continue;
+        const glm::vec4& plane = planes[i];
+        setups[planeCount++] = {
+            plane,
+            plane.x >= 0.f ? maxX_.data() : minX_.data(),
+            plane.y >= 0.f ? maxY_.data() : minY_.data(),
+            plane.z >= 0.f ? maxZ_.data() : minZ_.data()
+        };
+    }
+
+    uint32_t i = 0;
+#if defined(ZCULL_SSE)
+    for (; i + 4 <= count; i += 4) {
+        __m128 inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+        for (int p = 0; p < planeCount && _mm_movemask_ps(inside); p++) {
+            const PlaneSetup& s = setups[p];
+            __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(s.plane.x), _mm_loadu_ps(s.x + i)), _mm_mul_ps(_mm_set1_ps(s.plane.y), _mm_loadu_ps(s.y + i))),
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(s.plane.z), _mm_loadu_ps(s.z + i)), _mm_set1_ps(s.plane.w))
+            );
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+        }
+        int mask = _mm_movemask_ps(inside);
+        for (uint32_t lane = 0; lane < 4; lane++) {
+            if (mask & (1 << lane)) outVisible.push_back(i + lane);
+        }
+    }
+#elif defined(ZCULL_NEON)
+    for (; i + 4 <= count; i += 4) {
+        uint32x4_t inside = vdupq_n_u32(0xffffffff);
+        for (int p = 0; p < planeCount; p++) {
+            const PlaneSetup& s = setups[p];
+            float32x4_t distance = vdupq_n_f32(s.plane.w);
+            distance = vmlaq_f32(distance, vdupq_n_f32(s.plane.x), vld1q_f32(s.x + i));
+            distance = vmlaq_f32(distance, vdupq_n_f32(s.plane.y), vld1q_f32(s.y + i));
+            distance = vmlaq_f32(distance, vdupq_n_f32(s.plane.z), vld1q_f32(s.z + i));
+            inside = vandq_u32(inside, vcgeq_f32(distance, vdupq_n_f32(0.f)));
+        }
+        if (vgetq_lane_u32(inside, 0)) outVisible.push_back(i);
+        if (vgetq_lane_u32(inside, 1)) outVisible.push_back(i + 1);
+        if (vgetq_lane_u32(inside, 2)) outVisible.push_back(i + 2);
+        if (vgetq_lane_u32(inside, 3)) outVisible.push_back(i + 3);
+    }
+#endif
+    // Remaining boxes, or all of them when there is no SIMD support
+    for (; i < count; i++) {
+        bool inside = true;
+        for (int p = 0; p < planeCount && inside; p++) {
+            const PlaneSetup& s = setups[p];
+            inside = s.plane.x * s.x[i] + s.plane.y * s.y[i] + s.plane.z * s.z[i] + s.plane.w >= 0.f;
+        }
+        if (inside) outVisible.push_back(i);
+    }
+}
+
+/**
+    Extracts the six view planes from a view projection matrix, using the Gribb/Hartmann method. This
+    works for both perspective and orthographic projections, so it also covers shadow cascades.
+
+    @param viewProjection the view projection matrix of the view to cull against.
+    @return the normalized, inward facing planes in ZFrustum plane order.
+*/
+ZFrustumPlanes ZFrustumCuller::Planes(const glm::mat4& viewProjection)
+{
+    glm::mat4 m = glm::transpose(viewProjection);
+    ZFrustumPlanes planes;
+    planes[ZFrustum::LEFT] = m[3] + m[0];
+    planes[ZFrustum::RIGHT] = m[3] - m[0];
+    planes[ZFrustum::BOTTOM] = m[3] + m[1];
+    planes[ZFrustum::TOP] = m[3] - m[1];
+    planes[ZFrustum::NEAR] = m[3] + m[2];
+    planes[ZFrustum::FAR] = m[3] - m[2];
+    for (auto& plane : planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.f) plane /= length;
+    }
+    return planes;
+}
@@ -0,0 +1,118 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZOcclusionCuller.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZOcclusionCuller.hpp"
+
+/**
+    Builds the depth pyramid from a square grid of farthest depths.
+
+    @param depth the window space depths, row by row starting at the bottom of the view.
+    @param size the width and height of the grid. Must be a power of two.
+    @param viewProjection the view projection the depths were rendered with. Boxes are projected with it,
+    so tests stay consistent with the depths even if the camera has moved since they were captured.
+*/
+void ZOcclusionCuller::Build(const std::vector<float>& depth, unsigned int size, const glm::mat4& viewProjection)
+{
+    levels_.clear();
+    if (size == 0 || (size & (size - 1)) != 0 || depth.size() != size * size) return;
+
+    size_ = size;
+    viewProjection_ = viewProjection;
+    levels_.push_back(depth);
+    for (unsigned int levelSize = size / 2; levelSize > 0; levelSize /= 2) {
+        const std::vector<float>& previous = levels_.back();
+        std::vector<float> level(levelSize * levelSize);
+        unsigned int previousSize = levelSize * 2;
+        for (unsigned int y = 0; y < levelSize; y++) {
+            const float* row0 = &previous[(y * 2) * previousSize];
+            const float* row1 = row0 + previousSize;
+            for (unsigned int x = 0; x < levelSize; x++) {
+                level[y * levelSize + x] = glm::max(glm::max(row0[x * 2], row0[x * 2 + 1]), glm::max(row1[x * 2], row1[x * 2 + 1]));
+            }
+        }
+        levels_.push_back(std::move(level));
+    }
+}
+
+/**
+    Checks whether a box is completely hidden behind the captured depths. The box's screen rectangle is
+    looked up on the finest level where it covers at most two texels in each direction, and the box is
+    occluded if its nearest point is farther than every depth under that rectangle.
+
+    @param bounds the world space box to test.
+    @return true only if the box is certainly hidden. Boxes that can't be tested reliably, such as
+    those crossing the near plane or lying outside the view, are reported as not occluded.
+*/
+bool ZOcclusionCuller::Occluded(const ZAABBox& bounds) const
+{
+    if (levels_.empty()) return false;
+
+    glm::vec2 ndcMin(std::numeric_limits<float>::max()), ndcMax(std::numeric_limits<float>::lowest());
+    float nearest = 1.f;
+    for (int i = 0; i < 8; i++) {
+        glm::vec4 corner(
+            (i & 1) ? bounds.maximum.x : bounds.minimum.x,
+            (i & 2) ? bounds.maximum.y : bounds.minimum.y,
+            (i & 4) ? bounds.maximum.z : bounds.minimum.z,
+            1.f
+        );
+        glm::vec4 clip = viewProjection_ * corner;
+        if (clip.w <= std::numeric_limits<float>::epsilon()) return false;
+
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        ndcMin = glm::min(ndcMin, glm::vec2(ndc));
+        ndcMax = glm::max(ndcMax, glm::vec2(ndc));
+        nearest = glm::min(nearest, ndc.z * 0.5f + 0.5f);
+    }
+
+    if (nearest <= 0.f) return false;
+    if (ndcMax.x < -1.f || ndcMax.y < -1.f || ndcMin.x > 1.f || ndcMin.y > 1.f) return false;
+
+    const glm::ivec2 last(size_ - 1);
+    glm::ivec2 low = glm::clamp(glm::ivec2((glm::clamp(ndcMin, -1.f, 1.f) * 0.5f + 0.5f) * static_cast<float>(size_)), glm::ivec2(0), last);
+    glm::ivec2 high = glm::clamp(glm::ivec2((glm::clamp(ndcMax, -1.f, 1.f) * 0.5f + 0.5f) * static_cast<float>(size_)), glm::ivec2(0), last);
+
+    size_t level = 0;
+    while ((high.x - low.x > 1 || high.y - low.y > 1) && level + 1 < levels_.size()) {
+        low /= 2;
+        high /= 2;
+        ++level;
+    }
+
+    const std::vector<float>& depth = levels_[level];
+    const int levelSize = static_cast<int>(size_ >> level);
+    float farthest = 0.f;
+    for (int y = low.y; y <= high.y; y++) {
+        for (int x = low.x; x <= high.x; x++) {
+            farthest = glm::max(farthest, depth[y * levelSize + x]);
+        }
+    }
+
+    return nearest > farthest;
+}
@@ -63,13 +63,15 @@ void ZModel::Initialize()
     }
 
     ComputeBounds();
+    CompileAnimations();
 
     bool isRigged = !bonesMap_.empty();
     uniformBuffer_ = ZUniformBuffer::Create(ZUniformBufferType::Model, sizeof(ZModelUniforms));
     uniformBuffer_->Update(offsetof(ZModelUniforms, rigged), sizeof(isRigged), &isRigged);
 
-    for (auto i = 0; i < bones_.size(); i++) {
-        uniformBuffer_->Update(offsetof(ZModelUniforms, bones) + sizeof(glm::mat4) * i, sizeof(glm::mat4), glm::value_ptr(bones_[i]->transformation));
+    if (!bonePalette_.empty())
+    {
+        uniformBuffer_->Update(offsetof(ZModelUniforms, bones), sizeof(glm::mat4) * bonePalette_.size(), bonePalette_.data());
     }
 
     ZRenderStateGroupWriter writer;
@@ -120,6 +122,24 @@ void ZModel::SetInstanceData(const ZInstancedDataOptions& instanceData)
     }
 }
 
+void ZModel::UpdateInstances(const glm::mat4* transforms, unsigned int count)
+{
+    bool wasInstanced = instanceData_.count > 1;
+    instanceData_.count = count;
+    instanceData_.translations.clear();
+
+    bool isInstanced = instanceData_.count > 1;
+    if (isInstanced != wasInstanced)
+    {
+        uniformBuffer_->Update(offsetof(ZModelUniforms, instanced), sizeof(isInstanced), &isInstanced);
+    }
+
+    for (auto it = meshes_.begin(); it != meshes_.end(); it++)
+    {
+        it->second->UpdateInstances(transforms, count);
+    }
+}
+
 void ZModel::ComputeBounds()
 {
     bounds_ = ZAABBox();
@@ -135,138 +155,172 @@ void ZModel::ComputeBounds()
     }
 }
 
-void ZModel::BoneTransform(const std::string& anim, double secondsTime)
+void ZModel::CompileAnimations()
 {
-    if (animations_.find(anim) != animations_.end())
+    joints_.clear();
+    compiledAnimations_.clear();
+
+    bonePalette_.resize(std::min<size_t>(bones_.size(), BONES_PER_MODEL));
+    for (size_t i = 0; i < bonePalette_.size(); i++)
     {
-        double ticksPerSecond = animations_[anim]->ticksPerSecond != 0 ? animations_[anim]->ticksPerSecond : 25.0;
-        double timeInTicks = secondsTime * ticksPerSecond;
-        double animationTime = fmod(timeInTicks, animations_[anim]->duration);
+        bonePalette_[i] = bones_[i]->transformation;
+    }
 
-        glm::mat4 rootTransform = glm::rotate(glm::mat4(1.f), glm::radians(0.f), glm::vec3(1.f, 0.f, 0.f));
+    if (!skeleton_ || !skeleton_->rootJoint) return;
 
-        CalculateTransformsInHierarchy(anim, animationTime, skeleton_->rootJoint, rootTransform);
+    std::unordered_map<std::string, unsigned int> jointIndices;
+    FlattenSkeleton(skeleton_->rootJoint, -1, jointIndices);
+
+    for (const auto& [name, animation] : animations_)
+    {
+        ZCompiledAnimation compiled;
+        compiled.ticksPerSecond = animation->ticksPerSecond != 0 ? animation->ticksPerSecond : 25.0;
+        compiled.duration = animation->duration;
+        compiled.channels.resize(joints_.size());
+        for (const auto& channel : animation->channels)
+        {
+            auto index = jointIndices.find(channel->jointName);
+            if (index != jointIndices.end() && !compiled.channels[index->second])
+            {
+                compiled.channels[index->second] = channel;
+            }
+        }
+        compiledAnimations_[name] = std::move(compiled);
     }
 }
 
-void ZModel::CalculateTransformsInHierarchy(const std::string& animName, double animTime, const std::shared_ptr<ZJoint> joint, const glm::mat4& parentTransform)
+void ZModel::FlattenSkeleton(const std::shared_ptr<ZJoint>& joint, int parent, std::unordered_map<std::string, unsigned int>& outIndices)
 {
-    std::shared_ptr<ZAnimation> animation = animations_[animName];
-    glm::mat4 jointTransform = joint->transform;
+    // Pre-order traversal, so every joint lands after its parent and can be evaluated in a single forward pass
+    ZSkeletonJoint flatJoint;
+    flatJoint.parent = parent;
+    flatJoint.transform = joint->transform;
 
-    std::shared_ptr<ZJointAnimation> jointAnimation;
-    for (unsigned int i = 0, j = animation->channels.size(); i < j; i++)
+    auto bone = bonesMap_.find(joint->name);
+    if (bone != bonesMap_.end() && bone->second < bones_.size())
     {
-        std::shared_ptr<ZJointAnimation> anim = animation->channels[i];
-        if (anim->jointName == joint->name)
-        {
-            jointAnimation = anim; break;
-        }
+        flatJoint.bone = bone->second;
+        flatJoint.offset = bones_[bone->second]->offset;
     }
 
-    if (jointAnimation)
-    {
-        glm::vec3 scale = CalculateInterpolatedScaling(animTime, jointAnimation);
-        glm::quat rotation = CalculateInterpolatedRotation(animTime, jointAnimation);
-        glm::vec3 position = CalculateInterpolatedPosition(animTime, jointAnimation);
+    int index = joints_.size();
+    joints_.push_back(flatJoint);
+    outIndices.emplace(joint->name, index);
 
-        glm::mat4 rotationM(1.f), scalingM(1.f), translationM(1.f);
+    for (const auto& child : joint->children)
+    {
+        FlattenSkeleton(child, index, outIndices);
+    }
+}
 
-        rotationM = glm::mat4_cast(rotation);
-        scalingM = glm::scale(scalingM, scale);
-        translationM = glm::translate(translationM, position);
+void ZModel::BoneTransform(const std::string& anim, double secondsTime, ZAnimationClipState& clipState)
+{
+    auto it = compiledAnimations_.find(anim);
+    if (it == compiledAnimations_.end()) return;
 
-        jointTransform = translationM * rotationM * scalingM;
+    if (clipState.animation != anim || clipState.cursors.size() != joints_.size())
+    {
+        clipState.animation = anim;
+        clipState.cursors.assign(joints_.size(), ZAnimationCursor());
+        clipState.jointTransforms.resize(joints_.size());
     }
 
-    glm::mat4 globalTransform = parentTransform * jointTransform;
+    std::vector<glm::mat4>& jointTransforms = clipState.jointTransforms;
+    const ZCompiledAnimation& animation = it->second;
+    double timeInTicks = secondsTime * animation.ticksPerSecond;
+    double animationTime = animation.duration > 0 ? fmod(timeInTicks, animation.duration) : 0.0;
 
-    if (bonesMap_.find(joint->name) != bonesMap_.end())
+    for (size_t i = 0, j = joints_.size(); i < j; i++)
     {
-        unsigned int index = bonesMap_[joint->name];
-        bones_[index]->transformation = globalInverseTransform_ * globalTransform * bones_[index]->offset;
-        uniformBuffer_->Update(offsetof(ZModelUniforms, bones) + sizeof(glm::mat4) * index, sizeof(glm::mat4), glm::value_ptr(bones_[index]->transformation));
+        const ZSkeletonJoint& joint = joints_[i];
+        glm::mat4 jointTransform = joint.transform;
+
+        if (const ZJointAnimation* jointAnimation = animation.channels[i].get())
+        {
+            ZAnimationCursor& cursor = clipState.cursors[i];
+            glm::vec3 scale = CalculateInterpolatedScaling(animationTime, *jointAnimation, cursor.scaling);
+            glm::quat rotation = CalculateInterpolatedRotation(animationTime, *jointAnimation, cursor.rotation);
+            glm::vec3 position = CalculateInterpolatedPosition(animationTime, *jointAnimation, cursor.position);
+
+            jointTransform = glm::translate(glm::mat4(1.f), position) * glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.f), scale);
+        }
+
+        jointTransforms[i] = joint.parent >= 0 ? jointTransforms[joint.parent] * jointTransform : jointTransform;
+
+        if (joint.bone >= 0)
+        {
+            glm::mat4& transformation = bones_[joint.bone]->transformation;
+            transformation = globalInverseTransform_ * jointTransforms[i] * joint.offset;
+            if (static_cast<size_t>(joint.bone) < bonePalette_.size()) bonePalette_[joint.bone] = transformation;
+        }
     }
 
-    for (unsigned int i = 0; i < joint->children.size(); i++)
+    if (!bonePalette_.empty())
     {
-        CalculateTransformsInHierarchy(animName, animTime, joint->children[i], globalTransform);
+        uniformBuffer_->Update(offsetof(ZModelUniforms, bones), sizeof(glm::mat4) * bonePalette_.size(), bonePalette_.data());
     }
 }
 
-glm::vec3 ZModel::CalculateInterpolatedScaling(double animationTime, std::shared_ptr<ZJointAnimation> jointAnim)
+// Returns the index of the key that starts the interval containing time. The cursor from the previous
+// evaluation is tried first since playback mostly advances by less than a key per frame.
+template<class T>
+static unsigned int FindKeyIndex(const std::vector<ZAnimationKey<T>>& keys, double time, unsigned int cursor)
 {
-    if (jointAnim->scalingKeys.size() == 1)
+    unsigned int last = keys.size() - 1;
+    if (cursor < last && keys[cursor].time <= time)
     {
-        return jointAnim->scalingKeys[0].value;
+        if (time < keys[cursor + 1].time) return cursor;
+        if (cursor + 1 < last && time < keys[cursor + 2].time) return cursor + 1;
     }
 
-    unsigned int scalingIndex = 0;
-    for (unsigned int i = 0, j = jointAnim->scalingKeys.size() - 1; i < j; i++)
-    {
-        if (animationTime < jointAnim->scalingKeys[i + 1].time)
-        {
-            scalingIndex = i; break;
-        }
-    }
-    unsigned int nextScalingIndex = scalingIndex + 1;
-    double deltaTime = jointAnim->scalingKeys[nextScalingIndex].time - jointAnim->scalingKeys[scalingIndex].time;
-    double factor = (animationTime - jointAnim->scalingKeys[scalingIndex].time) / deltaTime;
-    glm::vec3 start = jointAnim->scalingKeys[scalingIndex].value;
-    glm::vec3 end = jointAnim->scalingKeys[nextScalingIndex].value;
-    glm::vec3 delta = end - start;
-
-    return start + (float) factor * delta;
+    auto it = std::upper_bound(keys.begin() + 1, keys.end(), time,
+        [](double t, const ZAnimationKey<T>& key) { return t < key.time; });
+    return std::min<unsigned int>(it - keys.begin() - 1, last - 1);
 }
 
-glm::quat ZModel::CalculateInterpolatedRotation(double animationTime, std::shared_ptr<ZJointAnimation> jointAnim)
+template<class T>
+static float InterpolationFactor(const std::vector<ZAnimationKey<T>>& keys, double time, unsigned int& cursor)
 {
-    if (jointAnim->rotationKeys.size() == 1)
-    {
-        return jointAnim->rotationKeys[0].value;
-    }
+    cursor = FindKeyIndex(keys, time, cursor);
+    double deltaTime = keys[cursor + 1].time - keys[cursor].time;
+    double factor = deltaTime > 0 ? (time - keys[cursor].time) / deltaTime : 0.0;
+    return glm::clamp((float) factor, 0.f, 1.f);
+}
 
-    unsigned int rotationIndex = 0;
-    for (unsigned int i = 0, j = jointAnim->rotationKeys.size() - 1; i < j; i++)
-    {
-        if (animationTime < jointAnim->rotationKeys[i + 1].time)
-        {
-            rotationIndex = i; break;
-        }
-    }
-    unsigned int nextRotationIndex = rotationIndex + 1;
-    double deltaTime = jointAnim->rotationKeys[nextRotationIndex].time - jointAnim->rotationKeys[rotationIndex].time;
-    double factor = (animationTime - jointAnim->rotationKeys[rotationIndex].time) / deltaTime;
-    glm::quat start = jointAnim->rotationKeys[rotationIndex].value;
-    glm::quat end = jointAnim->rotationKeys[nextRotationIndex].value;
-    glm::quat out = glm::mix(start, end, (float) factor);
-
-    return glm::normalize(out);
+glm::vec3 ZModel::CalculateInterpolatedScaling(double animationTime, const ZJointAnimation& jointAnim, unsigned int& cursor)
+{
+    if (jointAnim.scalingKeys.empty()) return glm::vec3(1.f);
+    if (jointAnim.scalingKeys.size() == 1) return jointAnim.scalingKeys[0].value;
+
+    float factor = InterpolationFactor(jointAnim.scalingKeys, animationTime, cursor);
+    glm::vec3 start = jointAnim.scalingKeys[cursor].value;
+    glm::vec3 end = jointAnim.scalingKeys[cursor + 1].value;
+
+    return start + factor * (end - start);
 }
 
-glm::vec3 ZModel::CalculateInterpolatedPosition(double animationTime, std::shared_ptr<ZJointAnimation> jointAnim)
+glm::quat ZModel::CalculateInterpolatedRotation(double animationTime, const ZJointAnimation& jointAnim, unsigned int& cursor)
 {
-    if (jointAnim->positionKeys.size() == 1)
-    {
-        return jointAnim->positionKeys[0].value;
-    }
+    if (jointAnim.rotationKeys.empty()) return glm::quat(1.f, 0.f, 0.f, 0.f);
+    if (jointAnim.rotationKeys.size() == 1) return jointAnim.rotationKeys[0].value;
 
-    unsigned int positionIndex = 0;
-    for (unsigned int i = 0, j = jointAnim->positionKeys.size() - 1; i < j; i++)
-    {
-        if (animationTime < jointAnim->positionKeys[i + 1].time)
-        {
-            positionIndex = i; break;
-        }
-    }
-    unsigned int nextPositionIndex = positionIndex + 1;
-    double deltaTime = jointAnim->positionKeys[nextPositionIndex].time - jointAnim->positionKeys[positionIndex].time;
-    double factor = (animationTime - jointAnim->positionKeys[positionIndex].time) / deltaTime;
-    glm::vec3 start = jointAnim->positionKeys[positionIndex].value;
-    glm::vec3 end = jointAnim->positionKeys[nextPositionIndex].value;
-    glm::vec3 delta = end - start;
-
-    return start + (float) factor * delta;
+    float factor = InterpolationFactor(jointAnim.rotationKeys, animationTime, cursor);
+    glm::quat start = jointAnim.rotationKeys[cursor].value;
+    glm::quat end = jointAnim.rotationKeys[cursor + 1].value;
+
+    return glm::normalize(glm::mix(start, end, factor));
+}
+
+glm::vec3 ZModel::CalculateInterpolatedPosition(double animationTime, const ZJointAnimation& jointAnim, unsigned int& cursor)
+{
+    if (jointAnim.positionKeys.empty()) return glm::vec3(0.f);
+    if (jointAnim.positionKeys.size() == 1) return jointAnim.positionKeys[0].value;
+
+    float factor = InterpolationFactor(jointAnim.positionKeys, animationTime, cursor);
+    glm::vec3 start = jointAnim.positionKeys[cursor].value;
+    glm::vec3 end = jointAnim.positionKeys[cursor + 1].value;
+
+    return start + factor * (end - start);
 }
 
 void ZModel::HandleModelLoaded(const std::shared_ptr<ZResourceLoadedEvent>& event)
@@ -77,8 +77,9 @@ void ZGLDomain::SwapBuffers()
 
 void ZGLDomain::CreateWindow(int width, int height, bool maximized, bool visible, void* sharedContext)
 {
+    // Shader storage buffers (i.e. the clustered light grid) need at least a 4.3 context
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #ifdef __APPLE__
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
@@ -105,6 +106,7 @@ void ZGLDomain::CreateWindow(int width, int height, bool maximized, bool visible
 
     if (window == NULL)
     {
+        LOG("Could not create an OpenGL 4.3 core context. Zenith needs OpenGL 4.3 for shader storage buffers.", ZSeverity::Error);
         glfwTerminate();
         return;
     }
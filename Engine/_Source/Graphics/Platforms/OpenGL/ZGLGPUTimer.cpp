@@ -0,0 +1,136 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZGLGPUTimer.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZGLGPUTimer.hpp"
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+ZGLGPUTimer::~ZGLGPUTimer()
+{
+    for (auto& frame : frames_) {
+        if (!frame.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+        }
+    }
+}
+
+bool ZGLGPUTimer::Supported()
+{
+    return GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+}
+
+void ZGLGPUTimer::BeginFrame()
+{
+    if (frameDepth_++ > 0) return;
+
+    currentFrame_ = (currentFrame_ + 1) % frameLatency;
+    ZGLTimerFrame& frame = frames_[currentFrame_];
+
+    // If the GPU is more than frameLatency frames behind, skip this frame rather than wait on the
+    // queries we would otherwise overwrite
+    recording_ = !frame.pending || Resolve(frame);
+    if (recording_) {
+        frame.scopes.clear();
+        frame.usedQueries = 0;
+    }
+    openScopes_.clear();
+}
+
+void ZGLGPUTimer::EndFrame()
+{
+    if (frameDepth_ == 0 || --frameDepth_ > 0) return;
+
+    while (!openScopes_.empty()) End();
+
+    ZGLTimerFrame& frame = frames_[currentFrame_];
+    if (recording_) {
+        frame.pending = !frame.scopes.empty();
+    }
+    recording_ = false;
+}
+
+void ZGLGPUTimer::Begin(const std::string& name)
+{
+    if (!recording_) return;
+
+    ZGLTimerFrame& frame = frames_[currentFrame_];
+    ZGLTimerScope scope;
+    scope.name = name;
+    scope.depth = static_cast<unsigned int>(openScopes_.size());
+    scope.beginQuery = AcquireQuery(frame);
+    glQueryCounter(scope.beginQuery, GL_TIMESTAMP);
+
+    openScopes_.push_back(static_cast<unsigned int>(frame.scopes.size()));
+    frame.scopes.push_back(scope);
+}
+
+void ZGLGPUTimer::End()
+{
+    if (!recording_ || openScopes_.empty()) return;
+
+    ZGLTimerFrame& frame = frames_[currentFrame_];
+    ZGLTimerScope& scope = frame.scopes[openScopes_.back()];
+    scope.endQuery = AcquireQuery(frame);
+    glQueryCounter(scope.endQuery, GL_TIMESTAMP);
+
+    openScopes_.pop_back();
+}
+
+unsigned int ZGLGPUTimer::AcquireQuery(ZGLTimerFrame& frame)
+{
+    if (frame.usedQueries == frame.queries.size()) {
+        GLuint query;
+        glGenQueries(1, &query);
+        frame.queries.push_back(query);
+    }
+    return frame.queries[frame.usedQueries++];
+}
+
+bool ZGLGPUTimer::Resolve(ZGLTimerFrame& frame)
+{
+    // Timestamps complete in submission order, so once the last query is available all of them are
+    GLint available = 0;
+    glGetQueryObjectiv(frame.queries[frame.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return false;
+
+    timings_.clear();
+    for (const auto& scope : frame.scopes) {
+        if (scope.endQuery == 0) continue;
+
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(scope.beginQuery, GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(scope.endQuery, GL_QUERY_RESULT, &end);
+        timings_.push_back({ scope.name, (end - begin) * 1e-6, scope.depth });
+    }
+    frame.pending = false;
+
+    ZFrameProfiler::CollectGPUTimings(timings_);
+    return true;
+}
@@ -270,13 +270,18 @@ void ZGLGraphics::SetBlending(ZBlendMode blendMode)
 }
 
 void ZGLGraphics::Draw(const std::shared_ptr<ZVertexBuffer>& bufferData, ZMeshDrawStyle drawStyle)
+{
+    DrawInstanced(bufferData, bufferData->instanceCount, drawStyle);
+}
+
+void ZGLGraphics::DrawInstanced(const std::shared_ptr<ZVertexBuffer>& bufferData, unsigned int instanceCount, ZMeshDrawStyle drawStyle)
 {
     bufferData->Bind();
     if (bufferData->indexCount > 0)
     {
-        if (bufferData->instanceCount > 1)
+        if (instanceCount > 1)
         {
-            glDrawElementsInstanced(drawingStylesMap_[drawStyle], bufferData->indexCount, GL_UNSIGNED_INT, 0, bufferData->instanceCount);
+            glDrawElementsInstanced(drawingStylesMap_[drawStyle], bufferData->indexCount, GL_UNSIGNED_INT, 0, instanceCount);
         }
         else
         {
@@ -285,9 +290,9 @@ void ZGLGraphics::Draw(const std::shared_ptr<ZVertexBuffer>& bufferData, ZMeshDr
     }
     else
     {
-        if (bufferData->instanceCount > 1)
+        if (instanceCount > 1)
         {
-            glDrawArraysInstanced(drawingStylesMap_[drawStyle], 0, bufferData->vertexCount, bufferData->instanceCount);
+            glDrawArraysInstanced(drawingStylesMap_[drawStyle], 0, bufferData->vertexCount, instanceCount);
         }
         else
         {
@@ -0,0 +1,163 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZGLOcclusionBuffer.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZServices.hpp"
+#include "ZGLOcclusionBuffer.hpp"
+#include "ZShader.hpp"
+#include "ZTexture.hpp"
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+ZGLOcclusionBuffer::~ZGLOcclusionBuffer()
+{
+    for (auto& frame : frames_) {
+        if (frame.fence) glDeleteSync(static_cast<GLsync>(frame.fence));
+        if (frame.pbo) glDeleteBuffers(1, &frame.pbo);
+    }
+    if (vao_) glDeleteVertexArrays(1, &vao_);
+    if (target_) glDeleteTextures(1, &target_);
+    if (fbo_) glDeleteFramebuffers(1, &fbo_);
+}
+
+bool ZGLOcclusionBuffer::Supported()
+{
+    return GLEW_VERSION_3_2 || GLEW_ARB_sync;
+}
+
+void ZGLOcclusionBuffer::Initialize()
+{
+    shader_ = ZShader::Create("/Shaders/Vertex/depth_reduce.vert", "/Shaders/Pixel/depth_reduce.frag");
+
+    glGenTextures(1, &target_);
+    glBindTexture(GL_TEXTURE_2D, target_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, resolution, resolution, 0, GL_RED, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGenFramebuffers(1, &fbo_);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target_, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        LOG("Occlusion buffer framebuffer is not complete", ZSeverity::Error);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+
+    // The reduction draws a single full screen triangle generated from gl_VertexID, so the vertex array stays empty
+    glGenVertexArrays(1, &vao_);
+
+    for (auto& frame : frames_) {
+        glGenBuffers(1, &frame.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, frame.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, resolution * resolution * sizeof(float), NULL, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void ZGLOcclusionBuffer::Capture(const std::shared_ptr<ZTexture>& depth, const glm::mat4& viewProjection)
+{
+    if (!depth) return;
+    if (fbo_ == 0) Initialize();
+
+    // If the GPU is more than frameLatency captures behind, drop this one rather than wait on the buffer it would overwrite
+    ZGLOcclusionFrame& frame = frames_[currentFrame_];
+    if (frame.pending) return;
+
+    GLint previousDrawFramebuffer = 0, previousReadFramebuffer = 0, previousVertexArray = 0;
+    GLint previousViewport[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousDrawFramebuffer);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFramebuffer);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previousVertexArray);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+    GLboolean blend = glIsEnabled(GL_BLEND), cullFace = glIsEnabled(GL_CULL_FACE), depthTest = glIsEnabled(GL_DEPTH_TEST);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glViewport(0, 0, resolution, resolution);
+    glDisable(GL_BLEND);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_DEPTH_TEST);
+
+    shader_->Activate();
+    shader_->BindSampler("depth", 0, depth);
+    shader_->SetVec2("targetSize", glm::vec2(resolution));
+    glBindVertexArray(vao_);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    shader_->ClearAttachments();
+
+    // Queue the copy into the pixel buffer now and only map it once the fence says the GPU is done with it
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, frame.pbo);
+    glReadPixels(0, 0, resolution, resolution, GL_RED, GL_FLOAT, NULL);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frame.viewProjection = viewProjection;
+    frame.pending = true;
+    currentFrame_ = (currentFrame_ + 1) % frameLatency;
+
+    glBindVertexArray(previousVertexArray);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, previousDrawFramebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, previousReadFramebuffer);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    if (blend) glEnable(GL_BLEND);
+    if (cullFace) glEnable(GL_CULL_FACE);
+    if (depthTest) glEnable(GL_DEPTH_TEST);
+}
+
+bool ZGLOcclusionBuffer::Read(std::vector<float>& outDepth, glm::mat4& outViewProjection)
+{
+    // The slot that will be written next holds the oldest capture. Fences signal in submission order,
+    // so walking forward from it and stopping at the first unsignaled fence yields the newest finished capture.
+    ZGLOcclusionFrame* newest = nullptr;
+    for (unsigned int i = 0; i < frameLatency; i++) {
+        ZGLOcclusionFrame& frame = frames_[(currentFrame_ + i) % frameLatency];
+        if (!frame.pending) continue;
+
+        GLenum status = glClientWaitSync(static_cast<GLsync>(frame.fence), 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break;
+
+        glDeleteSync(static_cast<GLsync>(frame.fence));
+        frame.fence = nullptr;
+        frame.pending = false;
+        newest = &frame;
+    }
+    if (!newest) return false;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, newest->pbo);
+    const float* data = static_cast<const float*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, resolution * resolution * sizeof(float), GL_MAP_READ_BIT));
+    bool read = data != nullptr;
+    if (read) {
+        outDepth.assign(data, data + resolution * resolution);
+        outViewProjection = newest->viewProjection;
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return read;
+}
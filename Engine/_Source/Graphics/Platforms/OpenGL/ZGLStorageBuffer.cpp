@@ -0,0 +1,79 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZGLStorageBuffer.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZGLStorageBuffer.hpp"
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+void ZGLStorageBuffer::Bind()
+{
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index_, ssbo_);
+}
+
+void ZGLStorageBuffer::Unbind()
+{
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void ZGLStorageBuffer::Load(unsigned int size)
+{
+    size_ = size;
+    if (ssbo_ == 0) glGenBuffers(1, &ssbo_);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void ZGLStorageBuffer::Update(unsigned int offset, unsigned int size, const void* data)
+{
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo_);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, data);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void ZGLStorageBuffer::Upload(unsigned int size, const void* data)
+{
+    // Grow geometrically so that a slowly rising light count doesn't reallocate every frame
+    if (size > size_) {
+        Load(glm::max(size, size_ * 2));
+    }
+    if (size > 0) {
+        Update(0, size, data);
+    }
+}
+
+void ZGLStorageBuffer::Delete()
+{
+    if (ssbo_ == 0) return;
+    glDeleteBuffers(1, &ssbo_);
+    ssbo_ = 0;
+    size_ = 0;
+}
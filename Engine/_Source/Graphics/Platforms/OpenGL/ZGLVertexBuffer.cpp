@@ -219,6 +219,63 @@ void ZGLVertexBuffer::Update(const ZVertex2DDataOptions& vertexData)
     glBindVertexArray(0);
 }
 
+void ZGLVertexBuffer::Load(const ZDebugVertexDataOptions& options)
+{
+    vertexCount = options.vertices.size();
+    instanceCount = 1;
+    vertexCapacity_ = options.vertices.size();
+
+    std::lock_guard<std::mutex> lock(glMutexes_.state);
+
+    glGenVertexArrays(1, &vao_);
+    glGenBuffers(1, &vbo_);
+
+    glBindVertexArray(vao_);
+
+    // Debug geometry is rewritten every frame, so the storage is allocated for streaming
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    glBufferData(GL_ARRAY_BUFFER, vertexCapacity_ * sizeof(ZDebugVertex), options.vertices.empty() ? NULL : &options.vertices[0], GL_STREAM_DRAW);
+
+    // Vertex position vector
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ZDebugVertex), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // Vertex color
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(ZDebugVertex), (void*)offsetof(ZDebugVertex, color));
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void ZGLVertexBuffer::Update(const ZDebugVertexDataOptions& vertexData)
+{
+    vertexCount = vertexData.vertices.size();
+    if (vertexData.vertices.empty()) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    // Only reallocate when the stream outgrows the buffer, and then with some headroom so
+    // that a slowly growing stream doesn't reallocate every frame
+    if (vertexData.vertices.size() > vertexCapacity_)
+    {
+        vertexCapacity_ = std::max(vertexData.vertices.size(), vertexCapacity_ * 2);
+        glBufferData(GL_ARRAY_BUFFER, vertexCapacity_ * sizeof(ZDebugVertex), NULL, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertexData.vertices.size() * sizeof(ZDebugVertex), &vertexData.vertices[0]);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void ZGLVertexBuffer::UpdateInstances(const glm::mat4* transforms, unsigned int count)
+{
+    // Orphan the instance buffer before uploading, since the same buffer can be
+    // streamed to several times per frame (once per pass or shadow cascade)
+    std::lock_guard<std::mutex> lock(glMutexes_.state);
+    glBindBuffer(GL_ARRAY_BUFFER, ivbo_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(glm::mat4) * count, NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(glm::mat4) * count, transforms);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
 void ZGLVertexBuffer::Delete()
 {
     std::lock_guard<std::mutex> lock(glMutexes_.state);
@@ -0,0 +1,187 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZDebugDraw.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZDebugDraw.hpp"
+#include "ZServices.hpp"
+#include "ZScene.hpp"
+#include "ZCamera.hpp"
+#include "ZFrustum.hpp"
+#include "ZAABBox.hpp"
+#include "ZAssetStore.hpp"
+#include "ZVertexBuffer.hpp"
+#include "ZRenderTask.hpp"
+#include "ZRenderPass.hpp"
+#include "ZRenderStateGroup.hpp"
+
+void ZDebugDraw::Line(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, ZDebugDepthMode depthMode)
+{
+    auto& stream = Stream(depthMode);
+    stream.emplace_back(from, color);
+    stream.emplace_back(to, color);
+}
+
+void ZDebugDraw::Box(const ZAABBox& aabb, const glm::vec4& color, ZDebugDepthMode depthMode)
+{
+    glm::vec3 corners[8];
+    for (unsigned int i = 0; i < 8; i++) {
+        corners[i] = glm::vec3(
+            (i & 1) ? aabb.maximum.x : aabb.minimum.x,
+            (i & 2) ? aabb.maximum.y : aabb.minimum.y,
+            (i & 4) ? aabb.maximum.z : aabb.minimum.z
+        );
+    }
+
+    // Each edge connects two corners whose indices differ in a single bit
+    auto& stream = Stream(depthMode);
+    stream.reserve(stream.size() + 24);
+    for (unsigned int i = 0; i < 8; i++) {
+        for (unsigned int axis = 1; axis < 8; axis <<= 1) {
+            if (i & axis) continue;
+            stream.emplace_back(corners[i], color);
+            stream.emplace_back(corners[i | axis], color);
+        }
+    }
+}
+
+void ZDebugDraw::Sphere(const glm::vec3& center, float radius, const glm::vec4& color, ZDebugDepthMode depthMode, unsigned int segments)
+{
+    if (segments < 3) return;
+
+    // Three orthogonal great circles
+    auto& stream = Stream(depthMode);
+    stream.reserve(stream.size() + segments * 6);
+    float step = 2.f * PI / static_cast<float>(segments);
+    for (unsigned int i = 0; i < segments; i++) {
+        float a0 = step * i, a1 = step * (i + 1);
+        glm::vec2 p0(glm::cos(a0) * radius, glm::sin(a0) * radius);
+        glm::vec2 p1(glm::cos(a1) * radius, glm::sin(a1) * radius);
+        stream.emplace_back(center + glm::vec3(p0.x, p0.y, 0.f), color);
+        stream.emplace_back(center + glm::vec3(p1.x, p1.y, 0.f), color);
+        stream.emplace_back(center + glm::vec3(p0.x, 0.f, p0.y), color);
+        stream.emplace_back(center + glm::vec3(p1.x, 0.f, p1.y), color);
+        stream.emplace_back(center + glm::vec3(0.f, p0.x, p0.y), color);
+        stream.emplace_back(center + glm::vec3(0.f, p1.x, p1.y), color);
+    }
+}
+
+void ZDebugDraw::Frustum(const ZFrustum& frustum, const glm::vec4& color, ZDebugDepthMode depthMode)
+{
+    auto& stream = Stream(depthMode);
+    stream.reserve(stream.size() + 24);
+    for (unsigned int i = 0; i < 4; i++) {
+        unsigned int next = (i + 1) % 4;
+        // Near plane, far plane and the edge connecting them
+        stream.emplace_back(frustum.corners[i], color);
+        stream.emplace_back(frustum.corners[next], color);
+        stream.emplace_back(frustum.corners[i + 4], color);
+        stream.emplace_back(frustum.corners[next + 4], color);
+        stream.emplace_back(frustum.corners[i], color);
+        stream.emplace_back(frustum.corners[i + 4], color);
+    }
+}
+
+void ZDebugDraw::Grid(unsigned int size, float cellSize, const glm::vec4& color, ZDebugDepthMode depthMode)
+{
+    if (cellSize <= 0.f) return;
+
+    auto& stream = Stream(depthMode);
+    float halfSize = static_cast<float>(size) / 2.f;
+    float spacing = cellSize * 2.f;
+    // Count the lines up front so that large grids don't accumulate float error in the loop counter
+    unsigned int lineCount = static_cast<unsigned int>(std::ceil(static_cast<float>(size) / spacing));
+    stream.reserve(stream.size() + lineCount * 4);
+    for (unsigned int k = 0; k < lineCount; k++) {
+        float offset = -halfSize + static_cast<float>(k) * spacing;
+        stream.emplace_back(glm::vec3(-halfSize, 0.f, offset), color);
+        stream.emplace_back(glm::vec3(halfSize, 0.f, offset), color);
+        stream.emplace_back(glm::vec3(offset, 0.f, -halfSize), color);
+        stream.emplace_back(glm::vec3(offset, 0.f, halfSize), color);
+    }
+}
+
+/**
+    Uploads the debug geometry accumulated this frame and submits one line draw per depth mode
+    to the color pass. The vertex buffers rotate every frame so that we never write into a buffer
+    the GPU might still be reading from.
+
+    @param scene the scene whose active camera the geometry is drawn with.
+*/
+void ZDebugDraw::Submit(const std::shared_ptr<ZScene>& scene)
+{
+    auto camera = scene ? scene->ActiveCamera() : nullptr;
+    if (!camera) {
+        Clear();
+        return;
+    }
+
+    auto& vertexBuffers = vertexBuffers_[frameIndex_];
+    for (size_t mode = 0; mode < streams_.size(); mode++)
+    {
+        auto& stream = streams_[mode];
+        if (stream.vertices.empty()) continue;
+
+        ZPR_SESSION_COLLECT_VERTICES(stream.vertices.size());
+
+        if (!vertexBuffers[mode]) {
+            vertexBuffers[mode] = ZVertexBuffer::Create(stream);
+        } else {
+            vertexBuffers[mode]->Update(stream);
+        }
+
+        bool overlay = mode == static_cast<size_t>(ZDebugDepthMode::Overlay);
+        ZRenderStateGroupWriter writer;
+        writer.Begin();
+        writer.SetShader(ZServices::AssetStore()->DebugShader());
+        writer.BindVertexBuffer(vertexBuffers[mode]);
+        writer.SetRenderLayer(ZRenderLayer::Debug);
+        writer.SetDepthStencilState({ overlay ? ZDepthStencilState::None : ZDepthStencilState::Depth });
+        // Overlay lines are blended, which puts them on the translucent side of the sort key so they always
+        // draw after the depth tested ones and end up on top
+        if (overlay) writer.SetBlending(ZBlendMode::Transluscent);
+        auto lineState = writer.End();
+
+        ZDrawCall drawCall = ZDrawCall::Create(ZMeshDrawStyle::Line);
+        auto renderTask = ZRenderTask::Compile(drawCall,
+            { camera->RenderState(), lineState },
+            ZRenderPass::Color()
+        );
+        renderTask->Submit({ ZRenderPass::Color() });
+    }
+
+    frameIndex_ = (frameIndex_ + 1) % frameLatency;
+    Clear();
+}
+
+void ZDebugDraw::Clear()
+{
+    // Keep the capacity around, since roughly the same amount of debug geometry is drawn every frame
+    for (auto& stream : streams_) {
+        stream.vertices.clear();
+    }
+}
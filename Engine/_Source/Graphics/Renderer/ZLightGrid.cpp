@@ -0,0 +1,232 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZLightGrid.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZServices.hpp"
+#include "ZLightGrid.hpp"
+#include "ZLight.hpp"
+#include "ZCamera.hpp"
+#include "ZStorageBuffer.hpp"
+
+/**
+    Rebuilds the light lists for the camera's current view and uploads them.
+
+    @param camera the camera whose view the clusters are laid out in.
+    @param lights the lights in the scene.
+    @param excluded a light that is shaded separately, i.e. the shadow casting main light.
+*/
+void ZLightGrid::Build(const std::shared_ptr<ZCamera>& camera, const ZLightList& lights, const std::shared_ptr<ZLight>& excluded)
+{
+    ZPR_FUNCTION_ZONE()
+
+    candidates_.clear();
+    if (camera) {
+        for (const auto& light : lights) {
+            if (light == excluded || !light->properties.isEnabled) continue;
+
+            Light properties = light->properties;
+            properties.lightType = static_cast<unsigned int>(light->type);
+            properties.position = glm::vec4(light->Position(), 1.f);
+            candidates_.push_back(properties);
+        }
+        Cluster(camera->ViewMatrix(), camera->ProjectionMatrix(), camera->NearField(), camera->FarField(), candidates_);
+    }
+    else {
+        lights_.clear();
+        indices_.clear();
+        clusters_.assign(clusterCount, glm::uvec2(0));
+        uniforms_.dimensions.w = 0;
+    }
+
+    Upload();
+}
+
+/**
+    Assigns lights to clusters on the CPU without touching any GPU buffers.
+
+    @param view the view matrix the clusters are laid out in.
+    @param projection the perspective projection the screen tiles are derived from.
+    @param near the near clipping plane distance.
+    @param far the far clipping plane distance.
+    @param lights world space light properties, with the light type and position already filled in.
+*/
+void ZLightGrid::Cluster(const glm::mat4& view, const glm::mat4& projection, float near, float far, const std::vector<Light>& lights)
+{
+    lights_.clear();
+    assignments_.clear();
+    clusters_.assign(clusterCount, glm::uvec2(0));
+
+    float logRange = glm::log(far / near);
+    uniforms_.sliceScale = glm::vec4(slices / logRange, -static_cast<float>(slices) * glm::log(near) / logRange, near, far);
+
+    // Lights with an unbounded range go first so the shader can loop over them without a cluster lookup
+    std::vector<std::pair<const Light*, float>> localLights;
+    for (const auto& light : lights) {
+        float range = Range(light);
+        if (range <= 0.f) continue;
+        if (std::isinf(range)) lights_.push_back(light);
+        else localLights.emplace_back(&light, range);
+    }
+    uniforms_.dimensions.w = static_cast<unsigned int>(lights_.size());
+
+    static bool warned = false;
+    if (localLights.size() > MAX_LOCAL_LIGHTS && !warned) {
+        warned = true;
+        LOG("Too many local lights, only the first " + std::to_string(MAX_LOCAL_LIGHTS) + " will be shaded", ZSeverity::Warning);
+    }
+    if (localLights.size() > MAX_LOCAL_LIGHTS) localLights.resize(MAX_LOCAL_LIGHTS);
+
+    for (const auto& [light, range] : localLights) {
+        glm::vec3 center(view * light->position);
+        Assign(static_cast<uint32_t>(lights_.size()), center, range, projection, near, far);
+        lights_.push_back(*light);
+    }
+
+    // Counting sort the (cluster, light) pairs into one contiguous index list
+    for (const auto& assignment : assignments_) {
+        ++clusters_[assignment.x].y;
+    }
+    uint32_t offset = 0;
+    for (auto& cluster : clusters_) {
+        cluster.x = offset;
+        offset += cluster.y;
+    }
+    indices_.resize(assignments_.size());
+    cursors_.assign(clusterCount, 0);
+    for (const auto& assignment : assignments_) {
+        indices_[clusters_[assignment.x].x + cursors_[assignment.x]++] = assignment.y;
+    }
+}
+
+/**
+    Adds a light to every cluster its bounding sphere may touch. For each depth slice the sphere overlaps,
+    the sphere's view space box is clipped to the slice and projected to find the tiles it covers.
+*/
+void ZLightGrid::Assign(uint32_t lightIndex, const glm::vec3& center, float range, const glm::mat4& projection, float near, float far)
+{
+    float depth = -center.z;
+    float nearest = glm::max(depth - range, near), farthest = glm::min(depth + range, far);
+    if (nearest > farthest) return;
+
+    auto slice = [this](float viewDepth) {
+        return glm::clamp(static_cast<int>(glm::floor(glm::log(viewDepth) * uniforms_.sliceScale.x + uniforms_.sliceScale.y)), 0, static_cast<int>(slices) - 1);
+    };
+    auto sliceDepth = [near, far](int slice) {
+        return near * glm::pow(far / near, static_cast<float>(slice) / slices);
+    };
+
+    for (int s = slice(nearest), last = slice(farthest); s <= last; s++) {
+        float sliceNear = glm::max(nearest, sliceDepth(s)), sliceFar = glm::min(farthest, sliceDepth(s + 1));
+        if (sliceNear > sliceFar) continue;
+
+        glm::vec2 ndcMin(std::numeric_limits<float>::max()), ndcMax(std::numeric_limits<float>::lowest());
+        for (int i = 0; i < 8; i++) {
+            glm::vec4 corner(
+                center.x + ((i & 1) ? range : -range),
+                center.y + ((i & 2) ? range : -range),
+                -((i & 4) ? sliceFar : sliceNear),
+                1.f
+            );
+            glm::vec4 clip = projection * corner;
+            glm::vec2 ndc = glm::vec2(clip) / clip.w;
+            ndcMin = glm::min(ndcMin, ndc);
+            ndcMax = glm::max(ndcMax, ndc);
+        }
+        if (ndcMax.x < -1.f || ndcMax.y < -1.f || ndcMin.x > 1.f || ndcMin.y > 1.f) continue;
+
+        const glm::ivec2 tiles(tilesX, tilesY);
+        glm::ivec2 low = glm::clamp(glm::ivec2(glm::floor((ndcMin * 0.5f + 0.5f) * glm::vec2(tiles))), glm::ivec2(0), tiles - 1);
+        glm::ivec2 high = glm::clamp(glm::ivec2(glm::floor((ndcMax * 0.5f + 0.5f) * glm::vec2(tiles))), glm::ivec2(0), tiles - 1);
+        for (int y = low.y; y <= high.y; y++) {
+            for (int x = low.x; x <= high.x; x++) {
+                assignments_.emplace_back(x + tilesX * (y + tilesY * s), lightIndex);
+            }
+        }
+    }
+}
+
+void ZLightGrid::Upload()
+{
+    if (!clusterBuffer_) {
+        lightBuffer_ = ZStorageBuffer::Create(ZStorageBufferType::Lights, sizeof(Light));
+        clusterBuffer_ = ZStorageBuffer::Create(ZStorageBufferType::LightClusters, sizeof(ZLightClusterUniforms) + clusterCount * sizeof(glm::uvec2));
+        indexBuffer_ = ZStorageBuffer::Create(ZStorageBufferType::LightIndices, sizeof(uint32_t));
+    }
+
+    lightBuffer_->Upload(static_cast<unsigned int>(lights_.size() * sizeof(Light)), lights_.data());
+    clusterBuffer_->Update(0, sizeof(ZLightClusterUniforms), &uniforms_);
+    if (!clusters_.empty()) {
+        clusterBuffer_->Update(sizeof(ZLightClusterUniforms), static_cast<unsigned int>(clusters_.size() * sizeof(glm::uvec2)), clusters_.data());
+    }
+    indexBuffer_->Upload(static_cast<unsigned int>(indices_.size() * sizeof(uint32_t)), indices_.data());
+}
+
+void ZLightGrid::Bind()
+{
+    // Keeps the bindings valid even before the first build, so shaders never read from an unbound buffer
+    if (!clusterBuffer_) {
+        clusters_.assign(clusterCount, glm::uvec2(0));
+        Upload();
+    }
+
+    lightBuffer_->Bind();
+    clusterBuffer_->Bind();
+    indexBuffer_->Bind();
+}
+
+/**
+    Computes the distance beyond which a light contributes less than one step of an 8 bit color channel,
+    for both the polynomial falloff of the Blinn-Phong shader and the inverse square falloff of the PBR shader.
+
+    @param light the light properties.
+    @return the range in world units, infinity for lights that never fall off, or zero for lights that
+    are too dim to ever be seen.
+*/
+float ZLightGrid::Range(const Light& light)
+{
+    if (light.lightType == static_cast<unsigned int>(ZLightType::Directional)) {
+        return std::numeric_limits<float>::infinity();
+    }
+
+    float threshold = 256.f * glm::max(light.color.r, glm::max(light.color.g, light.color.b));
+    if (threshold <= 0.f) return 0.f;
+
+    float c = light.constantAttenuation, l = light.linearAttenuation, q = light.quadraticAttenuation;
+    // Without any attenuation terms the Blinn-Phong shader doesn't attenuate at all
+    if (c + l + q <= 0.f) {
+        return std::numeric_limits<float>::infinity();
+    }
+
+    float range = 0.f;
+    if (c < threshold) {
+        if (q > 0.f) range = (-l + glm::sqrt(l * l + 4.f * q * (threshold - c))) / (2.f * q);
+        else if (l > 0.f) range = (threshold - c) / l;
+        else return std::numeric_limits<float>::infinity();
+    }
+    return glm::max(range, glm::sqrt(threshold));
+}
@@ -38,6 +38,8 @@
 #include "ZRenderQueue.hpp"
 #include "ZRenderStateGroup.hpp"
 #include "ZUniformBuffer.hpp"
+#include "ZGPUTimer.hpp"
+#include "ZOcclusionBuffer.hpp"
 
 // TODO: Figure out how to move engine passes outside of static scope so the
 // we can use ZServices::AssetStore shaders and other renderpasses without issue, otherwise, we face
@@ -149,20 +151,26 @@ void ZRenderPass::Initialize()
     clearFlags_ |= (static_cast<uint8_t>(ZClearFlags::Color) | static_cast<uint8_t>(ZClearFlags::Depth) | static_cast<uint8_t>(ZClearFlags::Stencil));
 }
 
-void ZRenderPass::Submit(const std::shared_ptr<ZRenderTask>& task)
+void ZRenderPass::Submit(ZRenderTask* task)
 {
     renderQueue_->Add(task);
 }
 
 void ZRenderPass::Render(double deltaTime, const std::shared_ptr<ZScene>& scene, const std::shared_ptr<ZFramebuffer>& target)
 {
-    if (renderQueue_->Empty()) return;
+    if (!NeedsRender(scene)) return;
 
+    ZPR_ZONE(Name())
     Prepare(scene);
     Perform(deltaTime, scene);
     Resolve(target);
 }
 
+bool ZRenderPass::NeedsRender(const std::shared_ptr<ZScene>&)
+{
+    return !renderQueue_->Empty();
+}
+
 void ZRenderPass::Prepare(const std::shared_ptr<ZScene>& scene)
 {
     ZServices::Graphics()->ClearViewport(scene->GameConfig().graphics.clearColor, clearFlags_);
@@ -189,6 +197,11 @@ void ZDepthPass::Prepare(const std::shared_ptr<ZScene>& scene)
 void ZDepthPass::Perform(double deltaTime, const std::shared_ptr<ZScene>& scene)
 {
     renderQueue_->Submit();
+
+    // The scene tests next frame's objects against this depth once it has been read back
+    if (ZServices::Graphics()->HasOcclusionCulling() && scene->ActiveCamera()) {
+        ZServices::Graphics()->OcclusionBuffer()->Capture(framebuffer_->BoundAttachment(), scene->ActiveCamera()->ViewProjectionMatrix());
+    }
 }
 
 /****************** Shadow Pass ***********************/
@@ -206,26 +219,60 @@ void ZShadowPass::Initialize()
     renderState_ = writer.End();
 }
 
+bool ZShadowPass::NeedsRender(const std::shared_ptr<ZScene>& scene)
+{
+    if (cachedScene_.lock() != scene) {
+        cachedScene_ = scene;
+        cachedCascades_ = 0;
+    }
+
+    // Dirty cascades are rendered even when nothing casts into them, since their old contents must be cleared
+    dirtyCascades_ = scene->DynamicShadowCascades();
+    for (unsigned int j = 0; j < NUM_SHADOW_CASCADES; j++) {
+        uint8_t cascade = static_cast<uint8_t>(1 << j);
+        if (!(cachedCascades_ & cascade) || cachedSignatures_[j] != scene->ShadowCascadeSignature(j)) {
+            dirtyCascades_ |= cascade;
+        }
+    }
+    return dirtyCascades_ != 0;
+}
+
 void ZShadowPass::Prepare(const std::shared_ptr<ZScene>& scene)
 {
     framebuffer_->Bind();
     framebuffer_->BindAttachment();
 
-    ZRenderPass::Prepare(scene);
+    // Layers are cleared individually in Perform so that cached cascades keep their depth
+    ZServices::Graphics()->UpdateViewport(size_);
 }
 
 void ZShadowPass::Perform(double deltaTime, const std::shared_ptr<ZScene>& scene)
 {
     clearFlags_ = static_cast<uint8_t>(ZClearFlags::Depth);
     auto lights = scene->GameLights();
+    auto gpuTimer = ZServices::Graphics()->GPUTimer();
+    static const std::vector<std::string> cascadeNames = [] {
+        std::vector<std::string> names;
+        for (unsigned int j = 0; j < NUM_SHADOW_CASCADES; j++) names.push_back("Cascade " + std::to_string(j));
+        return names;
+    }();
     for (int j = 0; j < NUM_SHADOW_CASCADES; j++) {
+        uint8_t cascade = static_cast<uint8_t>(1 << j);
+        if (!(dirtyCascades_ & cascade)) continue;
+
+        gpuTimer->Begin(cascadeNames[j]);
         if (!lights.empty()) {
             auto lightspaceMatrix = (*lights.begin())->LightSpaceMatrices()[j];
             uniformBuffer_->Update(offsetof(ZLightUniforms, ViewProjectionLightSpace), sizeof(lightspaceMatrix), glm::value_ptr(lightspaceMatrix));
         }
         framebuffer_->BindAttachmentLayer(j);
         ZServices::Graphics()->ClearViewport(scene->GameConfig().graphics.clearColor, clearFlags_);
-        renderQueue_->Submit(j == NUM_SHADOW_CASCADES - 1);
+        // The queue is flushed after the last cascade that is drawn this frame
+        renderQueue_->Submit(dirtyCascades_ < (cascade << 1), cascade);
+        gpuTimer->End();
+
+        cachedSignatures_[j] = scene->ShadowCascadeSignature(j);
+        cachedCascades_ |= cascade;
     }
 }
 
@@ -252,6 +299,8 @@ void ZColorPass::Prepare(const std::shared_ptr<ZScene>& scene)
     }
     framebuffer_->Resize(size_.x, size_.y);
 
+    scene->LightGrid().Bind();
+
     ZRenderPass::Prepare(scene);
 }
 
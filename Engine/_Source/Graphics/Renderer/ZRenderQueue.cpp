@@ -34,29 +34,137 @@
 #include "ZShader.hpp"
 #include "ZVertexBuffer.hpp"
 
+// Opaque keys hold the shader in bits 24-39, a per frame vertex buffer id in bits 14-23 and the render depth in bits 0-13
+constexpr uint64_t RENDER_KEY_DEPTH_BITS = 14;
+constexpr uint64_t RENDER_KEY_DEPTH_MASK = (1ull << RENDER_KEY_DEPTH_BITS) - 1;
+constexpr uint64_t RENDER_KEY_VERTEX_BUFFER_MASK = (1ull << (24 - RENDER_KEY_DEPTH_BITS)) - 1;
+// Mantissa bits kept by the log encoded depth, which leaves 5 bits of exponent for the full uint32_t depth range
+constexpr uint32_t RENDER_KEY_DEPTH_MANTISSA_BITS = RENDER_KEY_DEPTH_BITS - 5;
+
+size_t ZRenderQueue::vertexBufferGeneration_ = 0;
+uint32_t ZRenderQueue::nextVertexBufferId_ = 0;
+
 void ZRenderQueue::Initialize()
 {
     executor_ = ZServices::Graphics()->Executor();
 }
 
-void ZRenderQueue::Add(const std::shared_ptr<ZRenderTask>& task)
+bool ZRenderQueue::Empty()
+{
+    ReleaseStaleTasks();
+    return tasks_.empty();
+}
+
+void ZRenderQueue::Add(ZRenderTask* task)
 {
-    queue_.emplace_back( GenerateKey(task), task );
+    ReleaseStaleTasks();
+
+    keys_.push_back(GenerateKey(task));
+    tasks_.push_back(task);
+    sorted_ = false;
 }
 
-void ZRenderQueue::Submit(bool flush)
+void ZRenderQueue::Submit(bool flush, uint8_t viewMask)
 {
-    ZPR_SESSION_COLLECT_DRAWS(queue_.size());
+    // Queues that are submitted several times per frame (i.e. once per shadow cascade) only need to be sorted once
+    if (!sorted_) Sort();
 
-    std::sort(queue_.begin(), queue_.end());
-    for (const auto& [key, task] : queue_) {
-        Execute(task);
+    // Tasks that were culled from the submitted view are filtered out ahead of instancing, so that
+    // the remaining tasks can still be batched together
+    const std::vector<uint32_t>* order = &order_;
+    if (viewMask != 0xff) {
+        viewOrder_.clear();
+        for (auto index : order_) {
+            if (tasks_[index]->viewMask_ & viewMask) viewOrder_.push_back(index);
+        }
+        order = &viewOrder_;
+    }
+
+    ZPR_SESSION_COLLECT_DRAWS(order->size());
+
+    uint32_t count = static_cast<uint32_t>(order->size());
+    const uint32_t* indices = order->data();
+    for (uint32_t i = 0; i < count;) {
+        // Consecutive tasks that only differ by their model matrix are collapsed into a single instanced draw
+        uint32_t end = i + 1;
+        if (instancingEnabled_ && Instanceable(tasks_[indices[i]])) {
+            while (end < count && CanInstance(indices[i], indices[end])) ++end;
+        }
+
+        if (end - i > 1)
+            ExecuteInstanced(&indices[i], end - i);
+        else
+            Execute(tasks_[indices[i]]);
+        i = end;
     }
     if (flush)
-        queue_.clear();
+        Clear();
+}
+
+void ZRenderQueue::Sort()
+{
+    constexpr int radixBits = 8;
+    constexpr int radixSize = 1 << radixBits;
+    constexpr int passCount = sizeof(uint64_t) * 8 / radixBits;
+
+    uint32_t count = static_cast<uint32_t>(keys_.size());
+    sorted_ = true;
+    if (count == 0) return;
+
+    order_.resize(count);
+    orderScratch_.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        order_[i] = i;
+    }
+
+    // Build the histograms for every digit in a single sweep over the keys
+    uint32_t histograms[passCount][radixSize] = {};
+    for (auto key : keys_) {
+        for (auto pass = 0; pass < passCount; ++pass) {
+            histograms[pass][(key >> (pass * radixBits)) & (radixSize - 1)]++;
+        }
+    }
+
+    // LSD radix sort over indices into the key array. Each pass is stable, so tasks with equal keys keep
+    // their submission order. Digits that are the same for every key are skipped, which is most of the
+    // upper bits since GenerateKey only uses the low 51.
+    for (auto pass = 0; pass < passCount; ++pass) {
+        uint32_t* histogram = histograms[pass];
+        int shift = pass * radixBits;
+        if (histogram[(keys_[0] >> shift) & (radixSize - 1)] == count) continue;
+
+        uint32_t offset = 0;
+        for (auto digit = 0; digit < radixSize; ++digit) {
+            uint32_t digitCount = histogram[digit];
+            histogram[digit] = offset;
+            offset += digitCount;
+        }
+        for (auto index : order_) {
+            orderScratch_[histogram[(keys_[index] >> shift) & (radixSize - 1)]++] = index;
+        }
+        order_.swap(orderScratch_);
+    }
+}
+
+void ZRenderQueue::Clear()
+{
+    keys_.clear();
+    tasks_.clear();
+    order_.clear();
+    sorted_ = false;
+}
+
+void ZRenderQueue::ReleaseStaleTasks()
+{
+    // Tasks left over from a previous frame point into recycled frame memory, so we drop them
+    size_t generation = ZRenderTask::FrameAllocator().Generation();
+    if (generation != frameGeneration_) {
+        Clear();
+        frameGeneration_ = generation;
+    }
 }
 
-void ZRenderQueue::Execute(const std::shared_ptr<ZRenderTask>& task)
+void ZRenderQueue::Execute(ZRenderTask* task)
 {
     if (executor_) {
         (*executor_)(task->pipelineState_);
@@ -65,7 +173,65 @@ void ZRenderQueue::Execute(const std::shared_ptr<ZRenderTask>& task)
     }
 }
 
-uint64_t ZRenderQueue::GenerateKey(const std::shared_ptr<ZRenderTask>& task)
+void ZRenderQueue::ExecuteInstanced(const uint32_t* indices, uint32_t count)
+{
+    if (!executor_) return;
+
+    instanceTransforms_.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        instanceTransforms_[i] = tasks_[indices[i]]->instanceTransform_;
+    }
+
+    // Every task in the batch shares the same model uniform buffer, so we flip its instanced flag for the
+    // duration of the draw. The object uniform buffer of the first task stays bound but is ignored by the shader.
+    ZRenderTask* task = tasks_[indices[0]];
+    auto& modelBuffer = task->resourceState_.uniformBuffers[static_cast<uint16_t>(ZUniformBufferType::Model)];
+
+    bool instanced = true;
+    modelBuffer->Update(offsetof(ZModelUniforms, instanced), sizeof(instanced), &instanced);
+
+    (*executor_)(task->pipelineState_);
+    (*executor_)(task->resourceState_);
+    (*executor_)(task->drawCall_, task->resourceState_.vertexBuffer, instanceTransforms_);
+
+    instanced = false;
+    modelBuffer->Update(offsetof(ZModelUniforms, instanced), sizeof(instanced), &instanced);
+}
+
+bool ZRenderQueue::Instanceable(ZRenderTask* task)
+{
+    // Meshes that already carry their own instance data (i.e. grass) use the instance buffer themselves
+    return task->hasInstanceTransform_ &&
+        task->pipelineState_.blendState == ZBlendMode::Opaque &&
+        task->resourceState_.shader && task->resourceState_.shader->Instanceable() &&
+        task->resourceState_.vertexBuffer && task->resourceState_.vertexBuffer->instanceCount <= 1 &&
+        task->resourceState_.uniformBuffers[static_cast<uint16_t>(ZUniformBufferType::Model)];
+}
+
+bool ZRenderQueue::CanInstance(uint32_t first, uint32_t second)
+{
+    if ((keys_[first] & ~RENDER_KEY_DEPTH_MASK) != (keys_[second] & ~RENDER_KEY_DEPTH_MASK)) return false;
+
+    ZRenderTask* a = tasks_[first];
+    ZRenderTask* b = tasks_[second];
+    if (!b->hasInstanceTransform_) return false;
+    if (a->resourceState_.vertexBuffer != b->resourceState_.vertexBuffer ||
+        a->resourceState_.shader != b->resourceState_.shader ||
+        a->drawCall_.drawStyle_ != b->drawCall_.drawStyle_) return false;
+    if (a->pipelineState_.depthStencilState != b->pipelineState_.depthStencilState ||
+        a->pipelineState_.faceCullState != b->pipelineState_.faceCullState ||
+        a->pipelineState_.clearState != b->pipelineState_.clearState) return false;
+    if (a->resourceState_.textures != b->resourceState_.textures) return false;
+
+    // The object uniform buffer holds the per object model matrix, which is replaced by the instance transform
+    for (unsigned int i = 0; i < MAX_UBO_SLOTS; i++) {
+        if (i == static_cast<unsigned int>(ZUniformBufferType::Object)) continue;
+        if (a->resourceState_.uniformBuffers[i] != b->resourceState_.uniformBuffers[i]) return false;
+    }
+    return true;
+}
+
+uint64_t ZRenderQueue::GenerateKey(ZRenderTask* task)
 {
     uint64_t key = 0;
     key |= static_cast<uint64_t>(task->fullscreenLayer_ & 0x0f) << 47;
@@ -73,7 +239,9 @@ uint64_t ZRenderQueue::GenerateKey(const std::shared_ptr<ZRenderTask>& task)
     key |= static_cast<uint64_t>((static_cast<uint8_t>(task->pipelineState_.blendState) & 0x07)) << 40;
     if (task->pipelineState_.blendState == ZBlendMode::Opaque) {
         key |= static_cast<uint64_t>(static_cast<uint16_t>(task->resourceState_.shader->ID())) << 24;
-        key |= static_cast<uint64_t>((task->renderDepth_ & 0xffffff));
+        // Draws of the same mesh sort next to each other so they can be instanced, and front to back within that
+        key |= static_cast<uint64_t>(VertexBufferId(task)) << RENDER_KEY_DEPTH_BITS;
+        key |= EncodeDepth(task->renderDepth_);
     } else {
 
         if (task->fullscreenLayer_ & static_cast<uint8_t>(ZFullScreenLayer::UI)) {
@@ -91,6 +259,37 @@ uint64_t ZRenderQueue::GenerateKey(const std::shared_ptr<ZRenderTask>& task)
     return key;
 }
 
+uint32_t ZRenderQueue::VertexBufferId(ZRenderTask* task)
+{
+    // Vertex buffers are numbered in the order they are first added each frame, and the number is stamped on
+    // the buffer itself so every queue sees the same id without a lookup. Ids wrap once a frame uses more
+    // meshes than the key has room for, which only costs batching since CanInstance still compares the buffers.
+    ZVertexBuffer* vertexBuffer = task->resourceState_.vertexBuffer.get();
+    if (!vertexBuffer) return 0;
+
+    size_t generation = ZRenderTask::FrameAllocator().Generation();
+    if (vertexBufferGeneration_ != generation) {
+        vertexBufferGeneration_ = generation;
+        nextVertexBufferId_ = 0;
+    }
+    if (vertexBuffer->sortGeneration != generation) {
+        vertexBuffer->sortId = nextVertexBufferId_++ & RENDER_KEY_VERTEX_BUFFER_MASK;
+        vertexBuffer->sortGeneration = generation;
+    }
+    return vertexBuffer->sortId;
+}
+
+uint64_t ZRenderQueue::EncodeDepth(uint32_t depth)
+{
+    // The bits of a positive float grow monotonically with its value, so the exponent and the top of the
+    // mantissa give a log scale depth that keeps close objects finely ordered and still covers the whole range
+    float value = static_cast<float>(depth) + 1.f;
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bits -= 0x3f800000;
+    return std::min(static_cast<uint64_t>(bits >> (23 - RENDER_KEY_DEPTH_MANTISSA_BITS)), RENDER_KEY_DEPTH_MASK);
+}
+
 std::shared_ptr<ZRenderQueue> ZRenderQueue::Create()
 {
     auto queue = std::make_shared<ZRenderQueue>();
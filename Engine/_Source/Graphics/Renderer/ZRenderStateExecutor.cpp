@@ -32,6 +32,7 @@
 #include "ZTexture.hpp"
 #include "ZUniformBuffer.hpp"
 #include "ZServices.hpp"
+#include "ZVertexBuffer.hpp"
 
 void ZRenderStateExecutor::operator()(const ZRenderPipelineState& pipelineState)
 {
@@ -65,11 +66,21 @@ void ZRenderStateExecutor::operator()(const ZRenderResourceState& resourceState)
         cachedState_->resourceState_.uniformBuffers.fill(nullptr);
     }
 
-    std::unordered_map<std::string, unsigned int> attachmentCount;
+    // Count textures per type so each one maps to its <type>Sampler<index> slot. There are only ever
+    // a handful of slots, so a linear scan over the types seen so far beats hashing the type names.
+    std::array<const std::string*, MAX_TEXTURE_SLOTS> attachmentTypes;
+    std::array<unsigned int, MAX_TEXTURE_SLOTS> attachmentCount;
+    unsigned int typeCount = 0;
     for (auto i = 0; i < MAX_TEXTURE_SLOTS; i++) {
         if (resourceState.textures[i] && resourceState.textures[i] != cachedState_->resourceState_.textures[i]) {
-            std::string uniformName = resourceState.textures[i]->type + "Sampler" + std::to_string(attachmentCount[resourceState.textures[i]->type]++);
-            cachedState_->resourceState_.shader->BindAttachment(uniformName, resourceState.textures[i]);
+            const std::string& type = resourceState.textures[i]->type;
+            unsigned int t = 0;
+            while (t < typeCount && *attachmentTypes[t] != type) ++t;
+            if (t == typeCount) {
+                attachmentTypes[typeCount] = &type;
+                attachmentCount[typeCount++] = 0;
+            }
+            cachedState_->resourceState_.shader->BindSampler(type, attachmentCount[t]++, resourceState.textures[i]);
             cachedState_->resourceState_.textures[i] = resourceState.textures[i];
         }
     }
@@ -87,6 +98,13 @@ void ZRenderStateExecutor::operator()(ZDrawCall drawCall, const std::shared_ptr<
     ZServices::Graphics()->Draw(vertexBuffer, drawCall.drawStyle_);
 }
 
+void ZRenderStateExecutor::operator()(ZDrawCall drawCall, const std::shared_ptr<ZVertexBuffer>& vertexBuffer, const std::vector<glm::mat4>& instanceTransforms)
+{
+    auto instanceCount = static_cast<unsigned int>(instanceTransforms.size());
+    vertexBuffer->UpdateInstances(instanceTransforms.data(), instanceCount);
+    ZServices::Graphics()->DrawInstanced(vertexBuffer, instanceCount, drawCall.drawStyle_);
+}
+
 std::shared_ptr<ZRenderStateExecutor> ZRenderStateExecutor::Create()
 {
     auto executor = std::make_shared<ZRenderStateExecutor>();
@@ -134,6 +134,12 @@ void ZRenderStateGroupWriter::SetRenderDepth(uint32_t depth)
     currentStateGroup_->renderDepth_ = depth;
 }
 
+void ZRenderStateGroupWriter::SetInstanceTransform(const glm::mat4& transform)
+{
+    currentStateGroup_->instanceTransform_ = transform;
+    currentStateGroup_->hasInstanceTransform_ = true;
+}
+
 std::shared_ptr<ZRenderStateGroup> ZRenderStateGroupWriter::End()
 {
     auto stateGroup = currentStateGroup_;
@@ -47,13 +47,13 @@ ZRenderTask::~ZRenderTask()
 void ZRenderTask::Submit(const std::initializer_list<std::shared_ptr<ZRenderPass>>& passes)
 {
     for (auto pass : passes) {
-        pass->Submit(shared_from_this());
+        pass->Submit(this);
     }
 }
 
-std::shared_ptr<ZRenderTask> ZRenderTask::Compile(ZDrawCall drawCall, const std::initializer_list<std::shared_ptr<ZRenderStateGroup>>& stateStack, const std::shared_ptr<ZRenderPass>& pass)
+ZRenderTask* ZRenderTask::Compile(ZDrawCall drawCall, const std::initializer_list<std::shared_ptr<ZRenderStateGroup>>& stateStack, const std::shared_ptr<ZRenderPass>& pass)
 {
-    auto renderTask = std::make_shared<ZRenderTask>();
+    auto renderTask = FrameAllocator().New<ZRenderTask>();
 
     renderTask->ApplyState(ZRenderStateGroup::Default());
 
@@ -69,6 +69,17 @@ std::shared_ptr<ZRenderTask> ZRenderTask::Compile(ZDrawCall drawCall, const std:
     return renderTask;
 }
 
+ZFrameAllocator& ZRenderTask::FrameAllocator()
+{
+    static ZFrameAllocator allocator(256 * 1024);
+    return allocator;
+}
+
+void ZRenderTask::ReleaseFrame()
+{
+    FrameAllocator().Reset();
+}
+
 void ZRenderTask::ApplyState(const std::shared_ptr<ZRenderStateGroup>& state)
 {
     if (state->renderLayer_ != static_cast<uint8_t>(ZRenderLayer::Null))
@@ -85,6 +96,10 @@ void ZRenderTask::ApplyState(const std::shared_ptr<ZRenderStateGroup>& state)
         pipelineState_.clearState = state->pipelineState_.clearState;
     if (state->renderDepth_ > 0)
         renderDepth_ = state->renderDepth_;
+    if (state->hasInstanceTransform_) {
+        instanceTransform_ = state->instanceTransform_;
+        hasInstanceTransform_ = true;
+    }
 
     if (state->resourceState_.shader)
         resourceState_.shader = state->resourceState_.shader;
@@ -28,14 +28,27 @@
 */
 
 #include "ZRenderer.hpp"
+#include "ZRenderTask.hpp"
+#include "ZServices.hpp"
+#include "ZGPUTimer.hpp"
 
 void ZRenderer::Render(double deltaTime)
 {
+    ZPR_ZONE("Render")
     ZPR_SESSION_COLLECT_RENDER_PASSES(passes_.size());
 
+    // Debug geometry gathered while preparing the scene goes out as part of the color pass
+    debugDraw_.Submit(scene_);
+
+    auto gpuTimer = ZServices::Graphics()->GPUTimer();
     for (auto pass : passes_) {
+        gpuTimer->Begin(pass->Name());
         pass->Render(deltaTime, scene_, target_);
+        gpuTimer->End();
     }
+
+    // Every pass has flushed its queue at this point, so this frame's render tasks can be recycled
+    ZRenderTask::ReleaseFrame();
 }
 
 void ZRenderer::AddPass(const ZRenderPass::ptr& pass)
@@ -104,6 +104,15 @@ void ZMesh3D::SetInstanceData(const ZInstancedDataOptions& data)
     bufferData_->Update(vertexData_);
 }
 
+void ZMesh3D::UpdateInstances(const glm::mat4* transforms, unsigned int count)
+{
+    // Streams per frame instance data without keeping a CPU side copy or re-uploading the vertices
+    vertexData_.instanced.count = count;
+    vertexData_.instanced.translations.clear();
+    bufferData_->UpdateInstances(transforms, count);
+    bufferData_->instanceCount = count;
+}
+
 void ZMesh3D::SetVertices(const ZVertex3DList& vertices)
 {
     vertexData_.vertices = vertices;
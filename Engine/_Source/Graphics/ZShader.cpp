@@ -29,6 +29,7 @@
 
 #include "ZServices.hpp"
 #include "ZShader.hpp"
+#include "ZShaderCache.hpp"
 #include "ZMaterial.hpp"
 #include "ZResource.hpp"
 #include "ZSkeleton.hpp"
@@ -55,12 +56,20 @@ ZShader::ZShader(const std::string& vertexShaderPath, const std::string& pixelSh
 }
 
 void ZShader::Initialize()
+{
+    LoadSources();
+    Compile();
+}
+
+/**
+    Loads the shader sources and resolves their includes. This doesn't touch the graphics
+    context, so it is safe to call from worker threads.
+*/
+void ZShader::LoadSources()
 {
     vertexShaderCode_ = GetShaderCode(vertexShaderPath_, ZShaderType::Vertex);
     pixelShaderCode_ = GetShaderCode(pixelShaderPath_, ZShaderType::Pixel);
     geometryShaderCode_ = GetShaderCode(geometryShaderPath_, ZShaderType::Geometry);
-
-    Compile();
 }
 
 void ZShader::InitializeAsync()
@@ -81,15 +90,34 @@ void ZShader::InitializeAsync()
 */
 void ZShader::Compile()
 {
-    int vShader = CompileShader(vertexShaderCode_, ZShaderType::Vertex);
-    int pShader = CompileShader(pixelShaderCode_, ZShaderType::Pixel);
-    int gShader = CompileShader(geometryShaderCode_, ZShaderType::Geometry);
+    ZPR_FUNCTION_ZONE()
+
+    // Try to reuse a program binary from a previous run before compiling from source
+    std::shared_ptr<ZShaderCache> cache = ZServices::Graphics()->ShaderCache();
+    std::string cacheKey;
+    unsigned int programId = 0;
+    if (cache->Enabled())
+    {
+        cacheKey = cache->Key(vertexShaderCode_, pixelShaderCode_, geometryShaderCode_);
+        programId = cache->Load(cacheKey);
+    }
 
-    id_ = CreateProgram(vShader, pShader, gShader);
+    if (programId == 0)
+    {
+        int vShader = CompileShader(vertexShaderCode_, ZShaderType::Vertex);
+        int pShader = CompileShader(pixelShaderCode_, ZShaderType::Pixel);
+        int gShader = CompileShader(geometryShaderCode_, ZShaderType::Geometry);
+
+        programId = CreateProgram(vShader, pShader, gShader, cache->Enabled());
+        if (cache->Enabled()) cache->Store(cacheKey, programId);
+
+        glDeleteShader(vShader);
+        glDeleteShader(pShader);
+        if (gShader != -1) glDeleteShader(gShader);
+    }
 
-    glDeleteShader(vShader);
-    glDeleteShader(pShader);
-    if (gShader != -1) glDeleteShader(gShader);
+    id_ = programId;
+    Reflect();
 }
 
 /**
@@ -134,23 +162,20 @@ std::string ZShader::GetShaderCode(const std::string& shaderPath, ZShaderType sh
 
 void ZShader::ProcessIncludes(std::string& shaderCode)
 {
-    std::vector<size_t> includePositions;
-    size_t pos = shaderCode.find("#include", 0);
-    while (pos != std::string::npos) {
-        includePositions.push_back(pos);
-        pos = shaderCode.find("#include", pos + 1);
-    }
-    std::regex includeRegex("^#include\\s+\"(\\S+)\".*$");
-    std::smatch match;
-    for (auto it = includePositions.rbegin(); it != includePositions.rend(); it++) {
-        size_t start = *it;
-        size_t end = shaderCode.find(NEWLINE, *it);
-        std::string includeLine = shaderCode.substr(start, (end - start));
-        if (std::regex_search(includeLine, match, includeRegex)) {
-            std::string includePath = (match[1].str().front() != '/' ? "/" : "") + match[1].str();
-            std::string includeContents = GetShaderCode(includePath, ZShaderType::Other);
-            shaderCode = shaderCode.replace(start, (end - start), includeContents);
+    // Directives are spliced in back to front so that replacing one doesn't move the ones before it.
+    // Included code has already had its own includes resolved by GetShaderCode.
+    size_t start = shaderCode.rfind("#include");
+    while (start != std::string::npos) {
+        size_t end = shaderCode.find(NEWLINE, start);
+        if (end == std::string::npos) end = shaderCode.size();
+        size_t pathStart = shaderCode.find('"', start);
+        size_t pathEnd = pathStart < end ? shaderCode.find('"', pathStart + 1) : std::string::npos;
+        if (pathEnd < end && pathEnd > pathStart + 1) {
+            std::string includePath = shaderCode.substr(pathStart + 1, pathEnd - pathStart - 1);
+            if (includePath.front() != '/') includePath.insert(includePath.begin(), '/');
+            shaderCode.replace(start, end - start, GetShaderCode(includePath, ZShaderType::Other));
         }
+        start = start > 0 ? shaderCode.rfind("#include", start - 1) : std::string::npos;
     }
 }
 
@@ -194,19 +219,79 @@ int ZShader::CompileShader(const std::string& shaderCode, ZShaderType shaderType
     @param vShader the vertex shader handle to link.
     @param pShader the pixel shader handle to link.
     @param gShader the geometry shader handle to link.
+    @param retrievable whether the linked binary will be read back for the shader cache.
     @return the unsigned integer id of the OpenGL created program.
 */
-unsigned int ZShader::CreateProgram(int vShader, int pShader, int gShader)
+unsigned int ZShader::CreateProgram(int vShader, int pShader, int gShader, bool retrievable)
 {
     unsigned int programId = glCreateProgram();
     if (vShader != -1) glAttachShader(programId, vShader);
     if (pShader != -1) glAttachShader(programId, pShader);
     if (gShader != -1) glAttachShader(programId, gShader);
+    if (retrievable) glProgramParameteri(programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(programId);
     CheckCompileErrors(programId, ZShaderType::Other, "Program");
     return programId;
 }
 
+/**
+    Builds the uniform reflection table for the linked program, so that uniform
+    lookups don't have to go through glGetUniformLocation on every Set call. Sampler
+    uniforms that follow the <type>Sampler<index> naming convention are additionally
+    indexed by texture type and slot so they can be bound without building names.
+*/
+void ZShader::Reflect()
+{
+    uniforms_.clear();
+    samplers_.clear();
+
+    // Only shaders that actually read the per-instance model matrix can have their draws batched by the
+    // render queue. The linker drops unused attributes, so this ignores comments and dead code.
+    instanceable_ = glGetAttribLocation(id_, "instanceM") >= 0;
+
+    GLint uniformCount = 0, maxNameLength = 0;
+    glGetProgramiv(id_, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(id_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+    if (uniformCount <= 0 || maxNameLength <= 0) return;
+
+    std::vector<GLchar> nameBuffer(maxNameLength);
+    for (GLint i = 0; i < uniformCount; i++)
+    {
+        GLint size = 0; GLenum type = 0; GLsizei length = 0;
+        glGetActiveUniform(id_, static_cast<GLuint>(i), maxNameLength, &length, &size, &type, nameBuffer.data());
+        std::string name(nameBuffer.data(), length);
+
+        // Members of uniform blocks have no location and are set through the block binding instead
+        GLint location = glGetUniformLocation(id_, name.c_str());
+        if (location == -1) continue;
+
+        // Arrays are reported as "name[0]", so we also register the base name and every other element
+        size_t arrayPos = name.rfind("[0]");
+        if (arrayPos != std::string::npos && arrayPos + 3 == name.size())
+        {
+            std::string baseName = name.substr(0, arrayPos);
+            uniforms_[baseName] = location;
+            for (GLint j = 1; j < size; j++)
+            {
+                std::string elementName = baseName + "[" + std::to_string(j) + "]";
+                uniforms_[elementName] = glGetUniformLocation(id_, elementName.c_str());
+            }
+        }
+        uniforms_[name] = location;
+
+        size_t samplerPos = name.rfind("Sampler");
+        if (samplerPos != std::string::npos && samplerPos > 0 && samplerPos + 7 < name.size() &&
+            name.find_first_not_of("0123456789", samplerPos + 7) == std::string::npos)
+        {
+            std::string samplerType = name.substr(0, samplerPos);
+            unsigned int slot = std::stoul(name.substr(samplerPos + 7));
+            auto& slots = samplers_[samplerType];
+            if (slots.size() <= slot) slots.resize(slot + 1);
+            slots[slot] = { name, location };
+        }
+    }
+}
+
 /**
     Helper method that checks for compilation errors, given a "compilation unit" id
     and it's type. The method does not return, but instead prints the error message
@@ -249,64 +334,72 @@ void ZShader::Validate()
     }
 }
 
+ZUniformHandle ZShader::Uniform(const std::string& name) const
+{
+    ZUniformHandle handle;
+    auto it = uniforms_.find(name);
+    if (it != uniforms_.end()) handle.location = it->second;
+    return handle;
+}
+
 void ZShader::SetBool(const std::string& name, bool value) const
 {
-    glUniform1i(glGetUniformLocation(id_, name.c_str()), (int) value);
+    SetBool(Uniform(name), value);
 }
 
 void ZShader::SetInt(const std::string& name, int value) const
 {
-    glUniform1i(glGetUniformLocation(id_, name.c_str()), (int) value);
+    SetInt(Uniform(name), value);
 }
 
 void ZShader::SetFloat(const std::string& name, float value) const
 {
-    glUniform1f(glGetUniformLocation(id_, name.c_str()), (float) value);
+    SetFloat(Uniform(name), value);
 }
 
 void ZShader::SetVec2(const std::string& name, const glm::vec2& value) const
 {
-    glUniform2fv(glGetUniformLocation(id_, name.c_str()), 1, &value[0]);
+    SetVec2(Uniform(name), value);
 }
 
 void ZShader::SetVec2(const std::string& name, float x, float y) const
 {
-    glUniform2f(glGetUniformLocation(id_, name.c_str()), x, y);
+    SetVec2(Uniform(name), glm::vec2(x, y));
 }
 
 void ZShader::SetVec3(const std::string& name, const glm::vec3& value) const
 {
-    glUniform3fv(glGetUniformLocation(id_, name.c_str()), 1, &value[0]);
+    SetVec3(Uniform(name), value);
 }
 
 void ZShader::SetVec3(const std::string& name, float x, float y, float z) const
 {
-    glUniform3f(glGetUniformLocation(id_, name.c_str()), x, y, z);
+    SetVec3(Uniform(name), glm::vec3(x, y, z));
 }
 
 void ZShader::SetVec4(const std::string& name, const glm::vec4& value) const
 {
-    glUniform4fv(glGetUniformLocation(id_, name.c_str()), 1, &value[0]);
+    SetVec4(Uniform(name), value);
 }
 
 void ZShader::SetVec4(const std::string& name, float x, float y, float z, float w) const
 {
-    glUniform4f(glGetUniformLocation(id_, name.c_str()), x, y, z, w);
+    SetVec4(Uniform(name), glm::vec4(x, y, z, w));
 }
 
 void ZShader::SetMat2(const std::string& name, const glm::mat2& value) const
 {
-    glUniformMatrix2fv(glGetUniformLocation(id_, name.c_str()), 1, GL_FALSE, &value[0][0]);
+    SetMat2(Uniform(name), value);
 }
 
 void ZShader::SetMat3(const std::string& name, const glm::mat3& value) const
 {
-    glUniformMatrix3fv(glGetUniformLocation(id_, name.c_str()), 1, GL_FALSE, &value[0][0]);
+    SetMat3(Uniform(name), value);
 }
 
 void ZShader::SetMat4(const std::string& name, const glm::mat4& value) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(id_, name.c_str()), 1, GL_FALSE, &value[0][0]);
+    SetMat4(Uniform(name), value);
 }
 
 void ZShader::SetUBO(const std::string& name, int index) const
@@ -316,16 +409,69 @@ void ZShader::SetUBO(const std::string& name, int index) const
 
 void ZShader::SetFloatList(const std::string& name, const std::vector<float>& value) const
 {
-    for (int i = 0; i < value.size(); i++) {
-        SetFloat(name + "[" + std::to_string(i) + "]", value[i]);
-    }
+    SetFloatList(Uniform(name), value);
 }
 
 void ZShader::SetMat4List(const std::string& name, const std::vector<glm::mat4>& value) const
 {
-    for (int i = 0; i < value.size(); i++) {
-        SetMat4(name + "[" + std::to_string(i) + "]", value[i]);
-    }
+    SetMat4List(Uniform(name), value);
+}
+
+void ZShader::SetBool(ZUniformHandle handle, bool value) const
+{
+    if (handle.Valid()) glUniform1i(handle.location, (int) value);
+}
+
+void ZShader::SetInt(ZUniformHandle handle, int value) const
+{
+    if (handle.Valid()) glUniform1i(handle.location, value);
+}
+
+void ZShader::SetFloat(ZUniformHandle handle, float value) const
+{
+    if (handle.Valid()) glUniform1f(handle.location, value);
+}
+
+void ZShader::SetVec2(ZUniformHandle handle, const glm::vec2& value) const
+{
+    if (handle.Valid()) glUniform2fv(handle.location, 1, &value[0]);
+}
+
+void ZShader::SetVec3(ZUniformHandle handle, const glm::vec3& value) const
+{
+    if (handle.Valid()) glUniform3fv(handle.location, 1, &value[0]);
+}
+
+void ZShader::SetVec4(ZUniformHandle handle, const glm::vec4& value) const
+{
+    if (handle.Valid()) glUniform4fv(handle.location, 1, &value[0]);
+}
+
+void ZShader::SetMat2(ZUniformHandle handle, const glm::mat2& value) const
+{
+    if (handle.Valid()) glUniformMatrix2fv(handle.location, 1, GL_FALSE, &value[0][0]);
+}
+
+void ZShader::SetMat3(ZUniformHandle handle, const glm::mat3& value) const
+{
+    if (handle.Valid()) glUniformMatrix3fv(handle.location, 1, GL_FALSE, &value[0][0]);
+}
+
+void ZShader::SetMat4(ZUniformHandle handle, const glm::mat4& value) const
+{
+    if (handle.Valid()) glUniformMatrix4fv(handle.location, 1, GL_FALSE, &value[0][0]);
+}
+
+void ZShader::SetFloatList(ZUniformHandle handle, const std::vector<float>& value) const
+{
+    if (handle.Valid() && !value.empty())
+        glUniform1fv(handle.location, static_cast<GLsizei>(value.size()), value.data());
+}
+
+void ZShader::SetMat4List(ZUniformHandle handle, const std::vector<glm::mat4>& value) const
+{
+    if (handle.Valid() && !value.empty())
+        glUniformMatrix4fv(handle.location, static_cast<GLsizei>(value.size()), GL_FALSE, &value[0][0][0]);
 }
 
 void ZShader::Use(const std::shared_ptr<ZMaterial>& material)
@@ -402,12 +548,12 @@ void ZShader::Use(const ZLightMap& lights)
 void ZShader::Use(const ZBoneList& bones)
 {
     Activate();
-    std::shared_ptr<ZBone> bone;
+    std::vector<glm::mat4> transforms(BONES_PER_MODEL);
     for (unsigned int i = 0; i < BONES_PER_MODEL; i++)
     {
-        bone = bones[i];
-        SetMat4("Bones[" + std::to_string(i) + "]", bone->transformation);
+        transforms[i] = bones[i]->transformation;
     }
+    SetMat4List("Bones", transforms);
 }
 
 void ZShader::HandleShaderCodeLoaded(const std::shared_ptr<ZResourceLoadedEvent>& event)
@@ -464,13 +610,36 @@ void ZShader::BindAttachments()
 }
 
 void ZShader::BindAttachment(const std::string& uniformName, const std::shared_ptr<ZTexture>& attachment)
+{
+    BindAttachment(uniformName, Uniform(uniformName), attachment);
+}
+
+void ZShader::BindAttachment(const std::string& uniformName, ZUniformHandle handle, const std::shared_ptr<ZTexture>& attachment)
 {
     attachments_[uniformName] = attachment;
     attachment->Bind(attachmentIndex_);
-    SetInt(uniformName, attachmentIndex_);
+    SetInt(handle, attachmentIndex_);
     ++attachmentIndex_;
 }
 
+/**
+    Binds a texture to the sampler uniform named <type>Sampler<index>, resolving the
+    uniform through the sampler table built when the program was linked.
+
+    @param type the texture type, i.e. the sampler name prefix.
+    @param index the sampler index for the given texture type.
+    @param attachment the texture to bind.
+*/
+void ZShader::BindSampler(const std::string& type, unsigned int index, const std::shared_ptr<ZTexture>& attachment)
+{
+    auto it = samplers_.find(type);
+    // Textures the program never samples don't need a texture unit
+    if (it == samplers_.end() || index >= it->second.size() || it->second[index].location == -1) return;
+
+    const ZSamplerSlot& slot = it->second[index];
+    BindAttachment(slot.name, ZUniformHandle{ slot.location }, attachment);
+}
+
 void ZShader::ClearAttachments()
 {
     for (const auto& [key, val] : attachments_) {
@@ -515,6 +684,7 @@ void ZShader::CreateAsync(std::shared_ptr<ZOFTree> data, ZShaderIDMap& outPendin
 void ZShader::Create(std::shared_ptr<ZOFTree> data, ZShaderMap& outShaderMap)
 {
     ZShaderMap shaders;
+    std::vector<std::shared_ptr<ZShader>> pending;
     for (ZOFChildMap::iterator it = data->children.begin(); it != data->children.end(); it++)
     {
         if (it->first.find("ZSH") == 0)
@@ -533,11 +703,28 @@ void ZShader::Create(std::shared_ptr<ZOFTree> data, ZShaderMap& outShaderMap)
                 else if (it->second->id == "geometry") geometryPath = str->value;
             }
 
-            auto shader = ZShader::Create(vertexPath, pixelPath, geometryPath);
+            auto shader = std::make_shared<ZShader>(vertexPath, pixelPath, geometryPath);
             shader->name_ = it->first;
             shaders[it->first] = shader;
+            pending.push_back(shader);
         }
     }
+
+    // Reading sources and resolving includes is spread over the job system, but the
+    // programs themselves have to be compiled on the thread that owns the context
+    std::vector<ZJob> loadJobs;
+    for (const auto& shader : pending) {
+        loadJobs.push_back([shader] { shader->LoadSources(); });
+    }
+    if (auto jobSystem = ZServices::JobSystem()) {
+        jobSystem->Wait(jobSystem->Schedule(loadJobs));
+    } else {
+        for (const auto& job : loadJobs) job();
+    }
+
+    for (const auto& shader : pending) {
+        shader->Compile();
+    }
     outShaderMap = shaders;
 }
 
@@ -0,0 +1,189 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZShaderCache.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZServices.hpp"
+#include "ZShaderCache.hpp"
+#include "ZHash.hpp"
+
+#include <GL/glew.h>
+#include <cppfs/fs.h>
+#include <cppfs/FileHandle.h>
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace
+{
+    constexpr uint32_t cProgramBinaryMagic = 0x4253505A; // "ZPSB"
+    constexpr uint32_t cProgramBinaryVersion = 1;
+}
+
+void ZShaderCache::Initialize()
+{
+    if (directory_.empty()) return;
+
+    // Program binaries are only useful if the driver can hand back at least one format
+    GLint formatCount = 0;
+    if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    }
+    if (formatCount <= 0) {
+        LOG("Program binaries are not supported by the driver. Shaders will be compiled from source.", ZSeverity::Info);
+        return;
+    }
+
+    auto glString = [](GLenum name) {
+        const GLubyte* value = glGetString(name);
+        return value ? std::string(reinterpret_cast<const char*>(value)) : std::string();
+    };
+    driverIdentity_ = glString(GL_VENDOR) + "|" + glString(GL_RENDERER) + "|" + glString(GL_VERSION) + "|" + glString(GL_SHADING_LANGUAGE_VERSION);
+
+    cppfs::FileHandle directory = cppfs::fs::open(directory_);
+    if (!directory.isDirectory() && !directory.createDirectory()) {
+        LOG("Could not create shader cache directory " + directory_, ZSeverity::Warning);
+        return;
+    }
+
+    enabled_ = true;
+}
+
+/**
+    Builds the cache key for a program from its preprocessed sources and the current driver.
+
+    @param vertexCode the preprocessed vertex shader code.
+    @param pixelCode the preprocessed pixel shader code.
+    @param geometryCode the preprocessed geometry shader code.
+    @return a hex string that uniquely identifies the program binary.
+*/
+std::string ZShaderCache::Key(const std::string& vertexCode, const std::string& pixelCode, const std::string& geometryCode) const
+{
+    uint64_t hash = zenith::hash::FNV1a(driverIdentity_);
+    // Hash the lengths as well so that moving code between stages changes the key
+    for (const std::string* code : { &vertexCode, &pixelCode, &geometryCode }) {
+        hash = zenith::hash::FNV1a(std::to_string(code->size()) + ":", hash);
+        hash = zenith::hash::FNV1a(*code, hash);
+    }
+
+    std::stringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return stream.str();
+}
+
+/**
+    Attempts to create a program from a cached binary.
+
+    @param key the cache key returned by Key().
+    @return the linked program id, or 0 if there is no valid binary for the key.
+*/
+unsigned int ZShaderCache::Load(const std::string& key)
+{
+    if (!enabled_) return 0;
+
+    std::ifstream input(PathForKey(key), std::ios::in | std::ios::binary);
+    if (!input) return 0;
+
+    ZProgramBinaryHeader header;
+    input.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!input || header.magic != cProgramBinaryMagic || header.version != cProgramBinaryVersion ||
+        header.key != std::stoull(key, nullptr, 16) || header.length == 0) {
+        return 0;
+    }
+
+    std::vector<char> binary(header.length);
+    input.read(binary.data(), header.length);
+    if (!input) return 0;
+
+    unsigned int programId = glCreateProgram();
+    glProgramBinary(programId, static_cast<GLenum>(header.format), binary.data(), static_cast<GLsizei>(header.length));
+
+    // The driver is free to reject a binary it produced itself (i.e. after an update that kept the
+    // same version string), in which case we drop the entry and compile from source
+    GLint success = GL_FALSE;
+    glGetProgramiv(programId, GL_LINK_STATUS, &success);
+    if (success == GL_FALSE) {
+        glDeleteProgram(programId);
+        input.close();
+        std::remove(PathForKey(key).c_str());
+        return 0;
+    }
+
+    return programId;
+}
+
+/**
+    Writes the binary of a linked program to the cache.
+
+    @param key the cache key returned by Key().
+    @param programId the linked program, which should have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+*/
+void ZShaderCache::Store(const std::string& key, unsigned int programId)
+{
+    if (!enabled_ || programId == 0) return;
+
+    GLint success = GL_FALSE;
+    glGetProgramiv(programId, GL_LINK_STATUS, &success);
+    if (success == GL_FALSE) return;
+
+    GLint length = 0;
+    glGetProgramiv(programId, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(programId, length, &length, &format, binary.data());
+    if (length <= 0) return;
+
+    ZProgramBinaryHeader header;
+    header.magic = cProgramBinaryMagic;
+    header.version = cProgramBinaryVersion;
+    header.format = static_cast<uint32_t>(format);
+    header.length = static_cast<uint32_t>(length);
+    header.key = std::stoull(key, nullptr, 16);
+
+    std::ofstream output(PathForKey(key), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output) {
+        LOG("Could not write program binary to shader cache " + directory_, ZSeverity::Warning);
+        return;
+    }
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(binary.data(), length);
+}
+
+std::string ZShaderCache::PathForKey(const std::string& key) const
+{
+    return directory_ + "/" + key + ".zpb";
+}
+
+std::shared_ptr<ZShaderCache> ZShaderCache::Create(const std::string& directory)
+{
+    auto cache = std::make_shared<ZShaderCache>(directory);
+    cache->Initialize();
+    return cache;
+}
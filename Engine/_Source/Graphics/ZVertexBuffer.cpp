@@ -43,4 +43,12 @@ std::shared_ptr<ZVertexBuffer> ZVertexBuffer::Create(const ZVertex2DDataOptions&
     auto buffer = std::make_shared<ZGLVertexBuffer>();
     buffer->Load(options);
     return buffer;
-}
\ No newline at end of file
+}
+
+std::shared_ptr<ZVertexBuffer> ZVertexBuffer::Create(const ZDebugVertexDataOptions& options)
+{
+    // TODO: Switch on contant, variable or define to choose implementation
+    auto buffer = std::make_shared<ZGLVertexBuffer>();
+    buffer->Load(options);
+    return buffer;
+}
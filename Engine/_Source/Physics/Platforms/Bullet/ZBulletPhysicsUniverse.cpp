@@ -36,29 +36,129 @@
 #include "ZRaycastEvent.hpp"
 #include "ZObjectSelectedEvent.hpp"
 #include "ZBulletRigidBody.hpp"
-#include "ZCollisionEvent.hpp"
-#include "ZCollisionEndEvent.hpp"
+#include "ZBulletTaskScheduler.hpp"
+#include "ZBulletMotionState.hpp"
+#include "ZCollisionBatchEvent.hpp"
+#include "BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h"
+#include "BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h"
+#include "BulletCollision/NarrowPhaseCollision/btPointCollector.h"
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
+#include "BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
+
+using ZBulletQueryShape = std::variant<std::monostate, btBoxShape, btSphereShape, btCapsuleShape, btCylinderShape, btConeShape>;
+
+static btVector3 ToBullet(const glm::vec3& v)
+{
+    return btVector3(v.x, v.y, v.z);
+}
+
+static glm::vec3 FromBullet(const btVector3& v)
+{
+    return glm::vec3(v.x(), v.y(), v.z());
+}
+
+static btTransform QueryTransform(const glm::vec3& position, const glm::quat& orientation)
+{
+    return btTransform(btQuaternion(orientation.x, orientation.y, orientation.z, orientation.w), ToBullet(position));
+}
+
+// Query shapes are built in place with the same extents convention as ZBulletCollider, so a batch doesn't allocate per query
+static const btConvexShape* MakeQueryShape(ZColliderType type, const glm::vec3& extents, ZBulletQueryShape& storage)
+{
+    switch (type) {
+    case ZColliderType::Box: return &storage.emplace<btBoxShape>(ToBullet(extents));
+    case ZColliderType::Sphere: return &storage.emplace<btSphereShape>(extents.x);
+    case ZColliderType::Capsule: return &storage.emplace<btCapsuleShape>(extents.x, extents.y);
+    case ZColliderType::Cylinder: return &storage.emplace<btCylinderShape>(ToBullet(extents));
+    case ZColliderType::Cone: return &storage.emplace<btConeShape>(extents.x, extents.y);
+    default: return nullptr;
+    }
+}
+
+static bool ConvexOverlap(const btConvexShape* shape, const btTransform& transform, const btCollisionShape* other, const btTransform& otherTransform, btPointCollector& output)
+{
+    // Rigid bodies hold their colliders in a compound shape, so we test against each child
+    if (other->isCompound()) {
+        const btCompoundShape* compound = static_cast<const btCompoundShape*>(other);
+        for (int i = 0; i < compound->getNumChildShapes(); i++) {
+            if (ConvexOverlap(shape, transform, compound->getChildShape(i), otherTransform * compound->getChildTransform(i), output))
+                return true;
+        }
+        return false;
+    }
+    if (!other->isConvex()) return false;
+
+    btVoronoiSimplexSolver simplexSolver;
+    btGjkEpaPenetrationDepthSolver penetrationSolver;
+    btGjkPairDetector detector(shape, static_cast<const btConvexShape*>(other), &simplexSolver, &penetrationSolver);
+    btGjkPairDetector::ClosestPointInput input;
+    input.m_transformA = transform;
+    input.m_transformB = otherTransform;
+    output = btPointCollector();
+    detector.getClosestPoints(input, output, nullptr);
+    return output.m_hasResult && output.m_distance <= btScalar(0.);
+}
 
 void ZBulletPhysicsUniverse::Initialize()
 {
     ZPhysicsUniverse::Initialize();
 
     collisionConfig_ = std::make_shared<btDefaultCollisionConfiguration>();
-    dispatcher_ = std::make_shared<btCollisionDispatcher>(collisionConfig_.get());
     overlappingPairCache_ = std::make_shared<btDbvtBroadphase>();
-    solver_ = std::make_shared<btSequentialImpulseConstraintSolver>();
-    dynamicsWorld_ = std::make_shared<btDiscreteDynamicsWorld>(dispatcher_.get(), overlappingPairCache_.get(), solver_.get(), collisionConfig_.get());
+
+#ifdef BT_THREADSAFE
+    bool multithreaded = options_.multithreaded;
+#else
+    // Without BT_THREADSAFE the Mt world compiles but runs every loop serially behind extra locking
+    bool multithreaded = false;
+    if (options_.multithreaded)
+    {
+        LOG("Multithreaded physics requested, but Bullet was not built with BT_THREADSAFE. Using the single threaded world.", ZSeverity::Warning);
+    }
+#endif
+
+    if (multithreaded && ZServices::JobSystem())
+    {
+        // Bullet's parallel loops go through a single global scheduler, which has to be set before any Mt class is created
+        taskScheduler_ = std::make_shared<ZBulletTaskScheduler>(options_.maxThreads);
+        btSetTaskScheduler(taskScheduler_.get());
+
+        auto solverPool = std::make_shared<btConstraintSolverPoolMt>(taskScheduler_->getNumThreads());
+        dispatcher_ = std::make_shared<btCollisionDispatcherMt>(collisionConfig_.get());
+        solver_ = solverPool;
+        dynamicsWorld_ = std::make_shared<btDiscreteDynamicsWorldMt>(dispatcher_.get(), overlappingPairCache_.get(), solverPool.get(), nullptr, collisionConfig_.get());
+    }
+    else
+    {
+        dispatcher_ = std::make_shared<btCollisionDispatcher>(collisionConfig_.get());
+        solver_ = std::make_shared<btSequentialImpulseConstraintSolver>();
+        dynamicsWorld_ = std::make_shared<btDiscreteDynamicsWorld>(dispatcher_.get(), overlappingPairCache_.get(), solver_.get(), collisionConfig_.get());
+    }
 
     dynamicsWorld_->setDebugDrawer(this);
     dynamicsWorld_->getDebugDrawer()->setDebugMode(btIDebugDraw::DBG_DrawWireframe);
     dynamicsWorld_->setInternalTickCallback(TickCallback);
+    if (options_.interpolate)
+        dynamicsWorld_->setInternalTickCallback(PreTickCallback, this, true);
     dynamicsWorld_->setWorldUserInfo(this);
 }
 
 void ZBulletPhysicsUniverse::Update(double deltaTime)
 {
+    ZPR_ZONE("Physics Step")
     ZPhysicsUniverse::Update(deltaTime);
     dynamicsWorld_->stepSimulation(deltaTime, MAX_FIXED_UPDATE_ITERATIONS, UPDATE_STEP_SIZE);
+
+    if (options_.interpolate)
+    {
+        // Mirrors the time Bullet carries over to the next step, which is how far past the latest step we are
+        stepRemainder_ += deltaTime;
+        if (stepRemainder_ >= UPDATE_STEP_SIZE)
+            stepRemainder_ -= std::floor(stepRemainder_ / UPDATE_STEP_SIZE) * UPDATE_STEP_SIZE;
+        InterpolateMotionStates(static_cast<float>(stepRemainder_ / UPDATE_STEP_SIZE));
+    }
+
+    SyncMovedBodies();
 }
 
 void ZBulletPhysicsUniverse::AddRigidBody(std::shared_ptr<ZRigidBody> body)
@@ -71,6 +171,14 @@ void ZBulletPhysicsUniverse::AddRigidBody(std::shared_ptr<ZRigidBody> body)
     }
 
     dynamicsWorld_->addRigidBody(ptr, (int) body->Type(), (int) ZPhysicsBodyType::All);
+
+    if (auto motionState = dynamic_cast<ZBulletMotionState*>(ptr->getMotionState()))
+        motionState->Attach(ptr, &movedMotionStates_, &queryTreeDirty_);
+
+    ptr->setUserIndex(nextBodyHandle_);
+    bodies_[nextBodyHandle_++] = ptr;
+    queryTreeDirty_ = true;
+    previousTransforms_.clear();
 }
 
 void ZBulletPhysicsUniverse::RemoveRigidBody(std::shared_ptr<ZRigidBody> body)
@@ -83,6 +191,18 @@ void ZBulletPhysicsUniverse::RemoveRigidBody(std::shared_ptr<ZRigidBody> body)
     }
 
     dynamicsWorld_->removeRigidBody(ptr);
+
+    if (auto motionState = dynamic_cast<ZBulletMotionState*>(ptr->getMotionState()))
+    {
+        if (motionState->Moved())
+            movedMotionStates_.erase(std::remove(movedMotionStates_.begin(), movedMotionStates_.end(), motionState), movedMotionStates_.end());
+        motionState->Detach();
+    }
+
+    bodies_.erase(ptr->getUserIndex());
+    ptr->setUserIndex(INVALID_BODY_HANDLE);
+    queryTreeDirty_ = true;
+    previousTransforms_.clear();
 }
 
 ZRaycastHitResult ZBulletPhysicsUniverse::Raycast(const glm::vec3& start, const glm::vec3& direction, float t)
@@ -111,6 +231,237 @@ ZRaycastHitResult ZBulletPhysicsUniverse::Raycast(const glm::vec3& start, const
     return hitResult;
 }
 
+void ZBulletPhysicsUniverse::Raycast(const std::vector<ZRayQuery>& queries, std::vector<ZPhysicsQueryHit>& hits, const ZPhysicsQueryOptions& options)
+{
+    ZPR_FUNCTION_ZONE()
+
+    struct ZRayPolicy : btDbvt::ICollide
+    {
+        btTransform from, to;
+        btCollisionWorld::ClosestRayResultCallback* callback;
+
+        void Process(const btDbvtNode* leaf) override
+        {
+            btCollisionObject* object = static_cast<btCollisionObject*>(leaf->data);
+            if (!callback->needsCollision(object->getBroadphaseHandle())) return;
+            btCollisionWorld::rayTestSingle(from, to, object, object->getCollisionShape(), object->getWorldTransform(), *callback);
+        }
+    };
+
+    RunQueries(queries, hits, options.parallel, [this, &options](const ZRayQuery& query, unsigned int index, std::vector<ZPhysicsQueryHit>& out) {
+        btVector3 start = ToBullet(query.start), end = ToBullet(query.end);
+        btCollisionWorld::ClosestRayResultCallback callback(start, end);
+        callback.m_collisionFilterMask = options.mask;
+
+        ZRayPolicy policy;
+        policy.from.setIdentity();
+        policy.from.setOrigin(start);
+        policy.to.setIdentity();
+        policy.to.setOrigin(end);
+        policy.callback = &callback;
+        btDbvt::rayTest(queryTree_.m_root, start, end, policy);
+
+        if (callback.hasHit()) {
+            out.push_back({ index, callback.m_collisionObject->getUserIndex(), FromBullet(callback.m_hitPointWorld), FromBullet(callback.m_hitNormalWorld), callback.m_closestHitFraction });
+        }
+    });
+}
+
+void ZBulletPhysicsUniverse::Sweep(const std::vector<ZSweepQuery>& queries, std::vector<ZPhysicsQueryHit>& hits, const ZPhysicsQueryOptions& options)
+{
+    ZPR_FUNCTION_ZONE()
+
+    struct ZSweepPolicy : btDbvt::ICollide
+    {
+        const btConvexShape* shape;
+        btTransform from, to;
+        btCollisionWorld::ClosestConvexResultCallback* callback;
+
+        void Process(const btDbvtNode* leaf) override
+        {
+            btCollisionObject* object = static_cast<btCollisionObject*>(leaf->data);
+            if (!callback->needsCollision(object->getBroadphaseHandle())) return;
+            btCollisionWorld::objectQuerySingle(shape, from, to, object, object->getCollisionShape(), object->getWorldTransform(), *callback, btScalar(0.));
+        }
+    };
+
+    RunQueries(queries, hits, options.parallel, [this, &options](const ZSweepQuery& query, unsigned int index, std::vector<ZPhysicsQueryHit>& out) {
+        ZBulletQueryShape storage;
+        const btConvexShape* shape = MakeQueryShape(query.shape, query.extents, storage);
+        if (!shape) return;
+
+        ZSweepPolicy policy;
+        policy.shape = shape;
+        policy.from = QueryTransform(query.start, query.orientation);
+        policy.to = QueryTransform(query.end, query.orientation);
+
+        btCollisionWorld::ClosestConvexResultCallback callback(policy.from.getOrigin(), policy.to.getOrigin());
+        callback.m_collisionFilterMask = options.mask;
+        policy.callback = &callback;
+
+        // Candidates are gathered with the bounds of the whole sweep rather than a fattened ray
+        btVector3 fromMin, fromMax, toMin, toMax;
+        shape->getAabb(policy.from, fromMin, fromMax);
+        shape->getAabb(policy.to, toMin, toMax);
+        fromMin.setMin(toMin);
+        fromMax.setMax(toMax);
+        queryTree_.collideTV(queryTree_.m_root, btDbvtVolume::FromMM(fromMin, fromMax), policy);
+
+        if (callback.hasHit()) {
+            out.push_back({ index, callback.m_hitCollisionObject->getUserIndex(), FromBullet(callback.m_hitPointWorld), FromBullet(callback.m_hitNormalWorld), callback.m_closestHitFraction });
+        }
+    });
+}
+
+void ZBulletPhysicsUniverse::Overlap(const std::vector<ZOverlapQuery>& queries, std::vector<ZPhysicsQueryHit>& hits, const ZPhysicsQueryOptions& options)
+{
+    ZPR_FUNCTION_ZONE()
+
+    struct ZOverlapPolicy : btDbvt::ICollide
+    {
+        const btConvexShape* shape;
+        btTransform transform;
+        int mask;
+        unsigned int index;
+        std::vector<ZPhysicsQueryHit>* out;
+
+        void Process(const btDbvtNode* leaf) override
+        {
+            btCollisionObject* object = static_cast<btCollisionObject*>(leaf->data);
+            if (!(object->getBroadphaseHandle()->m_collisionFilterGroup & mask)) return;
+
+            btPointCollector output;
+            if (ConvexOverlap(shape, transform, object->getCollisionShape(), object->getWorldTransform(), output)) {
+                out->push_back({ index, object->getUserIndex(), FromBullet(output.m_pointInWorld), FromBullet(output.m_normalOnBInWorld), 0.f });
+            }
+        }
+    };
+
+    RunQueries(queries, hits, options.parallel, [this, &options](const ZOverlapQuery& query, unsigned int index, std::vector<ZPhysicsQueryHit>& out) {
+        ZBulletQueryShape storage;
+        const btConvexShape* shape = MakeQueryShape(query.shape, query.extents, storage);
+        if (!shape) return;
+
+        ZOverlapPolicy policy;
+        policy.shape = shape;
+        policy.transform = QueryTransform(query.position, query.orientation);
+        policy.mask = options.mask;
+        policy.index = index;
+        policy.out = &out;
+
+        btVector3 aabbMin, aabbMax;
+        shape->getAabb(policy.transform, aabbMin, aabbMax);
+        queryTree_.collideTV(queryTree_.m_root, btDbvtVolume::FromMM(aabbMin, aabbMax), policy);
+    });
+}
+
+ZGameObject* ZBulletPhysicsUniverse::BodyObject(ZPhysicsBodyHandle handle) const
+{
+    auto it = bodies_.find(handle);
+    if (it == bodies_.end()) return nullptr;
+    return static_cast<ZGameObject*>(it->second->getUserPointer());
+}
+
+void ZBulletPhysicsUniverse::InterpolateMotionStates(float alpha)
+{
+    // Until a step has run since bodies were last added or removed, the motion states keep Bullet's own transforms
+    const btCollisionObjectArray& objects = dynamicsWorld_->getCollisionObjectArray();
+    if (previousTransforms_.size() != objects.size()) return;
+
+    // Blending only writes the motion states and leaves the world transforms the query tree is built from alone
+    bool queryTreeDirty = queryTreeDirty_;
+    for (int i = 0; i < objects.size(); i++)
+    {
+        // Kinematic bodies read their motion state back into the world, so only dynamic bodies are blended
+        // Sleeping bodies are skipped like Bullet does, so that they don't queue themselves for a sync
+        btRigidBody* body = btRigidBody::upcast(objects[i]);
+        if (!body || !body->getMotionState() || body->isStaticOrKinematicObject() || !body->isActive()) continue;
+
+        const btTransform& previous = previousTransforms_[i];
+        const btTransform& current = body->getWorldTransform();
+        btTransform blended;
+        blended.setOrigin(previous.getOrigin().lerp(current.getOrigin(), alpha));
+        blended.setRotation(previous.getRotation().slerp(current.getRotation(), alpha));
+        body->getMotionState()->setWorldTransform(blended);
+    }
+    queryTreeDirty_ = queryTreeDirty;
+}
+
+void ZBulletPhysicsUniverse::SyncMovedBodies()
+{
+    ZPR_FUNCTION_ZONE()
+
+    for (auto motionState : movedMotionStates_)
+    {
+        motionState->ClearMoved();
+
+        // Static and kinematic bodies are driven by their game objects, so their transforms don't flow back
+        btRigidBody* body = motionState->Body();
+        if (!body || body->isStaticOrKinematicObject()) continue;
+        ZGameObject* object = static_cast<ZGameObject*>(body->getUserPointer());
+        if (!object) continue;
+
+        btTransform transform;
+        motionState->getWorldTransform(transform);
+        ATTRIBUTE_ALIGNED16(glm::mat4) modelMatrix;
+        transform.getOpenGLMatrix(glm::value_ptr(modelMatrix));
+        object->SetModelMatrix(glm::scale(modelMatrix, object->Scale()));
+    }
+    movedMotionStates_.clear();
+}
+
+void ZBulletPhysicsUniverse::UpdateQueryTree()
+{
+    if (!queryTreeDirty_) return;
+
+    // Bounds come from the current world transforms rather than the broadphase proxies, which Bullet only
+    // refreshes during a step and would miss bodies moved since the last one
+    queryTree_.clear();
+    const btCollisionObjectArray& objects = dynamicsWorld_->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); i++) {
+        if (!objects[i]->getBroadphaseHandle() || !objects[i]->getCollisionShape()) continue;
+        btVector3 aabbMin, aabbMax;
+        objects[i]->getCollisionShape()->getAabb(objects[i]->getWorldTransform(), aabbMin, aabbMax);
+        queryTree_.insert(btDbvtVolume::FromMM(aabbMin, aabbMax), objects[i]);
+    }
+    queryTreeDirty_ = false;
+}
+
+template<class Query, class Function>
+void ZBulletPhysicsUniverse::RunQueries(const std::vector<Query>& queries, std::vector<ZPhysicsQueryHit>& hits, bool parallel, const Function& query)
+{
+    hits.clear();
+    UpdateQueryTree();
+    if (queries.empty() || queryTree_.empty()) return;
+
+    unsigned int count = static_cast<unsigned int>(queries.size());
+    auto jobSystem = ZServices::JobSystem();
+    if (!parallel || !jobSystem || count <= cQueryBatchSize)
+    {
+        for (unsigned int i = 0; i < count; i++) query(queries[i], i, hits);
+        return;
+    }
+
+    // Each job writes into its own hit list, and the lists are joined in batch order so hits stay sorted by query
+    unsigned int batchCount = (count + cQueryBatchSize - 1) / cQueryBatchSize;
+    std::vector<std::vector<ZPhysicsQueryHit>> batchHits(batchCount);
+
+    std::vector<ZJob> jobs;
+    for (unsigned int batch = 0; batch < batchCount; batch++)
+    {
+        unsigned int begin = batch * cQueryBatchSize;
+        unsigned int end = std::min(begin + cQueryBatchSize, count);
+        jobs.push_back([&queries, &query, &batchHits, batch, begin, end] {
+            for (unsigned int i = begin; i < end; i++) query(queries[i], i, batchHits[batch]);
+        });
+    }
+    jobSystem->Wait(jobSystem->Schedule(jobs));
+
+    for (unsigned int batch = 0; batch < batchCount; batch++) {
+        hits.insert(hits.end(), batchHits[batch].begin(), batchHits[batch].end());
+    }
+}
+
 void ZBulletPhysicsUniverse::DebugDraw(const std::shared_ptr<ZScene>& scene)
 {
     if (!scene) return;
@@ -125,7 +476,9 @@ void ZBulletPhysicsUniverse::TickCallback(btDynamicsWorld* world, btScalar timeS
     assert(physics != nullptr);
     if (physics == nullptr) return;
 
-    ZCollisionPairs collisionPairs;
+    physics->queryTreeDirty_ = true;
+
+    physics->contacts_.BeginTick();
 
     btDispatcher* dispatcher = world->getDispatcher();
     for (int idx = 0; idx < dispatcher->getNumManifolds(); idx++)
@@ -133,44 +486,45 @@ void ZBulletPhysicsUniverse::TickCallback(btDynamicsWorld* world, btScalar timeS
         btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(idx);
         if (!manifold) continue;
 
-        btRigidBody const* body1 = static_cast<btRigidBody const*>(manifold->getBody0());
-        btRigidBody const* body2 = static_cast<btRigidBody const*>(manifold->getBody1());
+        const btCollisionObject* body1 = manifold->getBody0();
+        const btCollisionObject* body2 = manifold->getBody1();
 
-        bool swapped = body1 > body2;
-
-        btRigidBody const* sortedBody1 = swapped ? body2 : body1;
-        btRigidBody const* sortedBody2 = swapped ? body1 : body2;
-        ZGameObject* body1GO = static_cast<ZGameObject*>(sortedBody1->getUserPointer());
-        ZGameObject* body2GO = static_cast<ZGameObject*>(sortedBody2->getUserPointer());
+        // Bodies are keyed by the handles given to them when they were added to the world
+        physics->contacts_.Add(
+            static_cast<uint32_t>(body1->getUserIndex()), static_cast<uint32_t>(body2->getUserIndex()),
+            std::make_pair(static_cast<ZGameObject*>(body1->getUserPointer()), static_cast<ZGameObject*>(body2->getUserPointer()))
+        );
+    }
 
-        ZCollisionPair pair = std::make_pair(body1GO, body2GO);
-        collisionPairs.insert(pair);
+    physics->contacts_.EndTick();
 
-        if (physics->previousTickCollisionPairs_.find(pair) != physics->previousTickCollisionPairs_.end())
-        {
-            std::shared_ptr<ZCollisionEvent> collisionEvent(new ZCollisionEvent(pair));
-            ZServices::EventAgent()->Queue(collisionEvent);
-        }
+    if (!physics->contacts_.Began().empty() || !physics->contacts_.Ended().empty())
+    {
+        std::shared_ptr<ZCollisionBatchEvent> collisionEvent(new ZCollisionBatchEvent(physics->contacts_.Began(), physics->contacts_.Ended()));
+        ZServices::EventAgent()->Queue(collisionEvent);
     }
+}
 
-    ZCollisionPairs removedCollisionPairs;
-
-    std::set_difference(physics->previousTickCollisionPairs_.begin(), physics->previousTickCollisionPairs_.end(),
-        collisionPairs.begin(), collisionPairs.end(),
-        std::inserter(removedCollisionPairs, removedCollisionPairs.begin()));
+void ZBulletPhysicsUniverse::PreTickCallback(btDynamicsWorld* world, btScalar)
+{
+    ZBulletPhysicsUniverse* physics = static_cast<ZBulletPhysicsUniverse*>(world->getWorldUserInfo());
+    assert(physics != nullptr);
+    if (physics == nullptr) return;
 
-    for (ZCollisionPairs::const_iterator it = removedCollisionPairs.begin(), end = removedCollisionPairs.end(); it != end; it++)
+    const btCollisionObjectArray& objects = world->getCollisionObjectArray();
+    physics->previousTransforms_.resize(objects.size());
+    for (int i = 0; i < objects.size(); i++)
     {
-        std::shared_ptr<ZCollisionEndEvent> collisionEndEvent(new ZCollisionEndEvent(*it));
-        ZServices::EventAgent()->Queue(collisionEndEvent);
+        physics->previousTransforms_[i] = objects[i]->getWorldTransform();
     }
-
-    physics->previousTickCollisionPairs_ = collisionPairs;
 }
 
 void ZBulletPhysicsUniverse::CleanUp()
 {
     ZPhysicsUniverse::CleanUp();
+
+    if (taskScheduler_ && btGetTaskScheduler() == taskScheduler_.get())
+        btSetTaskScheduler(btGetSequentialTaskScheduler());
 }
 
 void ZBulletPhysicsUniverse::drawLine(const btVector3& from, const btVector3& to, const btVector3& color)
@@ -28,6 +28,7 @@
 */
 
 #include "ZBulletRigidBody.hpp"
+#include "ZBulletMotionState.hpp"
 #include "btBulletDynamicsCommon.h"
 
 ZBulletRigidBody::ZBulletRigidBody(ZPhysicsBodyType type, float mass, const glm::vec3& origin, const glm::vec3& scale, const glm::quat& rotation) : ZBulletRigidBody()
@@ -42,7 +43,7 @@ ZBulletRigidBody::ZBulletRigidBody(ZPhysicsBodyType type, float mass, const glm:
     btVector3 localInertia(0, 0, 0);
     if (mass > 0.f) coll->calculateLocalInertia(mass, localInertia);
 
-    btDefaultMotionState* motionState = new btDefaultMotionState(transform);
+    ZBulletMotionState* motionState = new ZBulletMotionState(transform);
     btRigidBody::btRigidBodyConstructionInfo rbInfo(mass, motionState, coll, localInertia);
     btRigidBody* bodyPtr = new btRigidBody(rbInfo);
 
@@ -0,0 +1,99 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZBulletTaskScheduler.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZBulletTaskScheduler.hpp"
+#include "ZServices.hpp"
+
+ZBulletTaskScheduler::ZBulletTaskScheduler(unsigned int maxThreads)
+    : btITaskScheduler("ZJobSystem")
+{
+    // The calling thread helps out while it waits on a loop, so it counts as one of the threads
+    auto jobSystem = ZServices::JobSystem();
+    int available = jobSystem ? static_cast<int>(jobSystem->ThreadCount()) + 1 : 1;
+    maxThreads_ = std::min(available, static_cast<int>(BT_MAX_THREAD_COUNT));
+    setNumThreads(maxThreads > 0 ? static_cast<int>(maxThreads) : maxThreads_);
+}
+
+void ZBulletTaskScheduler::setNumThreads(int numThreads)
+{
+    numThreads_ = std::max(1, std::min(numThreads, maxThreads_));
+}
+
+void ZBulletTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body)
+{
+    int batchCount = BatchCount(iBegin, iEnd, grainSize);
+    if (batchCount <= 1) {
+        body.forLoop(iBegin, iEnd);
+        return;
+    }
+
+    int batchSize = (iEnd - iBegin + batchCount - 1) / batchCount;
+    std::vector<ZJob> jobs;
+    for (int begin = iBegin; begin < iEnd; begin += batchSize) {
+        int end = std::min(begin + batchSize, iEnd);
+        jobs.push_back([&body, begin, end] { body.forLoop(begin, end); });
+    }
+
+    auto jobSystem = ZServices::JobSystem();
+    jobSystem->Wait(jobSystem->Schedule(jobs));
+}
+
+btScalar ZBulletTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body)
+{
+    int batchCount = BatchCount(iBegin, iEnd, grainSize);
+    if (batchCount <= 1) {
+        return body.sumLoop(iBegin, iEnd);
+    }
+
+    // Partial sums are added up in batch order so that the result doesn't depend on which worker finishes first
+    int batchSize = (iEnd - iBegin + batchCount - 1) / batchCount;
+    partialSums_.assign(batchCount, btScalar(0));
+    std::vector<ZJob> jobs;
+    for (int batch = 0, begin = iBegin; begin < iEnd; batch++, begin += batchSize) {
+        int end = std::min(begin + batchSize, iEnd);
+        btScalar* sum = &partialSums_[batch];
+        jobs.push_back([&body, sum, begin, end] { *sum = body.sumLoop(begin, end); });
+    }
+
+    auto jobSystem = ZServices::JobSystem();
+    jobSystem->Wait(jobSystem->Schedule(jobs));
+
+    btScalar total = btScalar(0);
+    for (auto sum : partialSums_) total += sum;
+    return total;
+}
+
+int ZBulletTaskScheduler::BatchCount(int iBegin, int iEnd, int grainSize) const
+{
+    if (numThreads_ <= 1 || !ZServices::JobSystem()) return 1;
+
+    int range = iEnd - iBegin;
+    int grain = std::max(1, grainSize);
+    return std::max(1, std::min(numThreads_, (range + grain - 1) / grain));
+}
@@ -0,0 +1,139 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZContactTracker.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZContactTracker.hpp"
+
+void ZContactTracker::BeginTick()
+{
+    // Generation zero marks slots that have never been written, so the counter skips it when it wraps
+    if (++generation_ == 0) {
+        for (auto& table : tables_) {
+            for (auto& entry : table.entries) entry.generation = 0;
+            table.count = 0;
+        }
+        generation_ = 1;
+    }
+
+    current_ ^= 1;
+    ZContactTable& table = tables_[current_];
+    table.generation = generation_;
+    table.count = 0;
+
+    began_.clear();
+    ended_.clear();
+}
+
+void ZContactTracker::Add(uint32_t bodyA, uint32_t bodyB, const ZCollisionPair& pair)
+{
+    bool swapped = bodyA > bodyB;
+    uint64_t key = swapped ? (static_cast<uint64_t>(bodyB) << 32) | bodyA : (static_cast<uint64_t>(bodyA) << 32) | bodyB;
+
+    // Bodies often share several manifolds, in which case the pair is already in the table
+    bool inserted = false;
+    ZContactEntry* entry = Insert(tables_[current_], key, inserted);
+    if (!inserted) return;
+
+    entry->pair = swapped ? std::make_pair(pair.second, pair.first) : pair;
+    if (!Find(tables_[current_ ^ 1], key)) {
+        began_.push_back(entry->pair);
+    }
+}
+
+void ZContactTracker::EndTick()
+{
+    const ZContactTable& previous = tables_[current_ ^ 1];
+    if (previous.count == 0) return;
+
+    for (const auto& entry : previous.entries) {
+        if (entry.generation != previous.generation) continue;
+        if (!Find(tables_[current_], entry.key)) {
+            ended_.push_back(entry.pair);
+        }
+    }
+}
+
+uint64_t ZContactTracker::Hash(uint64_t key)
+{
+    // splitmix64 finalizer, which spreads the packed body ids across the low bits used for the slot
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    key ^= key >> 31;
+    return key;
+}
+
+const ZContactTracker::ZContactEntry* ZContactTracker::Find(const ZContactTable& table, uint64_t key)
+{
+    if (table.count == 0) return nullptr;
+
+    size_t mask = table.entries.size() - 1;
+    for (size_t slot = Hash(key) & mask;; slot = (slot + 1) & mask) {
+        const ZContactEntry& entry = table.entries[slot];
+        if (entry.generation != table.generation) return nullptr;
+        if (entry.key == key) return &entry;
+    }
+}
+
+ZContactTracker::ZContactEntry* ZContactTracker::Insert(ZContactTable& table, uint64_t key, bool& inserted)
+{
+    // Tables are kept at most half full so that probe sequences stay short and always end on a free slot
+    if ((table.count + 1) * 2 > table.entries.size()) Grow(table);
+
+    size_t mask = table.entries.size() - 1;
+    for (size_t slot = Hash(key) & mask;; slot = (slot + 1) & mask) {
+        ZContactEntry& entry = table.entries[slot];
+        if (entry.generation != table.generation) {
+            entry.key = key;
+            entry.generation = table.generation;
+            table.count++;
+            inserted = true;
+            return &entry;
+        }
+        if (entry.key == key) {
+            inserted = false;
+            return &entry;
+        }
+    }
+}
+
+void ZContactTracker::Grow(ZContactTable& table)
+{
+    std::vector<ZContactEntry> entries(std::max<size_t>(cInitialCapacity, table.entries.size() * 2));
+    entries.swap(table.entries);
+
+    unsigned int count = table.count;
+    table.count = 0;
+    for (const auto& entry : entries) {
+        if (entry.generation != table.generation) continue;
+        bool inserted = false;
+        Insert(table, entry.key, inserted)->pair = entry.pair;
+    }
+    assert(table.count == count);
+}
@@ -32,21 +32,31 @@
 
 void ZConcurrentWorker::Initialize()
 {
-    processThread_ = std::thread(&ZConcurrentWorker::ThreadStarter, shared_from_this());
-    if (!processThread_.joinable())
+    auto jobSystem = ZServices::JobSystem();
+    if (!jobSystem)
     {
-        LOG("Unable to create thread", ZSeverity::Error);
+        LOG("Unable to schedule worker, no job system available", ZSeverity::Error);
         Fail(); return;
     }
     ZProcess::Initialize();
+
+    auto worker = shared_from_this();
+    jobSystem->Schedule([worker] {
+        worker->Run();
+        worker->complete_ = true;
+    });
 }
 
-void ZConcurrentWorker::Start()
+void ZConcurrentWorker::Update(double deltaTime)
 {
-    ZServices::ProcessRunner()->AttachProcess(shared_from_this());
+    if (complete_)
+    {
+        Finish(); return;
+    }
+    ZProcess::Update(deltaTime);
 }
 
-void ZConcurrentWorker::ThreadStarter(std::shared_ptr<ZConcurrentWorker> process)
+void ZConcurrentWorker::Start()
 {
-    process->Run();
+    ZServices::ProcessRunner()->AttachProcess(shared_from_this());
 }
@@ -0,0 +1,237 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZJobSystem.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZJobSystem.hpp"
+
+// The job system and worker index of the current thread, so that jobs scheduled from within
+// a job land on the scheduling worker's own deque
+static thread_local ZJobSystem* currentJobSystem = nullptr;
+static thread_local unsigned int currentWorkerIndex = 0;
+
+ZJobSystem::ZJobSystem(unsigned int threadCount)
+    : requestedThreadCount_(threadCount)
+{ }
+
+ZJobSystem::~ZJobSystem()
+{
+    CleanUp();
+}
+
+void ZJobSystem::Initialize()
+{
+    if (running_) return;
+
+    unsigned int threadCount = requestedThreadCount_;
+    if (threadCount == 0) {
+        // Leave one hardware thread for the main loop
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    queues_.clear();
+    for (unsigned int i = 0; i < threadCount; i++) {
+        queues_.emplace_back(std::make_unique<ZJobQueue>());
+    }
+
+    running_ = true;
+    for (unsigned int i = 0; i < threadCount; i++) {
+        workers_.emplace_back(&ZJobSystem::WorkerLoop, this, i);
+    }
+}
+
+void ZJobSystem::CleanUp()
+{
+    if (!running_) return;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        running_ = false;
+    }
+    sleepCondition_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+    workers_.clear();
+
+    // Anything still queued has a counter someone may be waiting on, so run it here rather than drop it.
+    // New jobs are run inline from now on, but jobs that were queued just before shutdown still land here.
+    unsigned int index = static_cast<unsigned int>(queues_.size());
+    while (RunOne(index));
+}
+
+std::shared_ptr<ZJobCounter> ZJobSystem::Schedule(const ZJob& job, const std::shared_ptr<ZJobCounter>& dependency, std::shared_ptr<ZJobCounter> counter)
+{
+    if (!counter) counter = std::make_shared<ZJobCounter>();
+    counter->count_.fetch_add(1, std::memory_order_acq_rel);
+
+    Enqueue(ZJobEntry{ job, counter }, dependency);
+    return counter;
+}
+
+std::shared_ptr<ZJobCounter> ZJobSystem::Schedule(const std::vector<ZJob>& jobs, const std::shared_ptr<ZJobCounter>& dependency, std::shared_ptr<ZJobCounter> counter)
+{
+    if (!counter) counter = std::make_shared<ZJobCounter>();
+    // Account for the whole batch up front so the counter can't hit zero while we are still scheduling
+    counter->count_.fetch_add(static_cast<int>(jobs.size()), std::memory_order_acq_rel);
+
+    for (const auto& job : jobs) {
+        Enqueue(ZJobEntry{ job, counter }, dependency);
+    }
+    return counter;
+}
+
+void ZJobSystem::Wait(const std::shared_ptr<ZJobCounter>& counter)
+{
+    if (!counter) return;
+
+    // The waiting thread helps out with outstanding jobs, and only sleeps once there is nothing left to take.
+    // It wakes up again when new jobs are queued or when any batch finishes.
+    unsigned int index = currentJobSystem == this ? currentWorkerIndex : static_cast<unsigned int>(queues_.size());
+    while (!counter->Done()) {
+        if (RunOne(index)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        waitCondition_.wait(lock, [this, &counter] { return counter->Done() || pendingJobs_.load() > 0; });
+    }
+}
+
+void ZJobSystem::WorkerLoop(unsigned int index)
+{
+    currentJobSystem = this;
+    currentWorkerIndex = index;
+    ZPR_THREAD_NAME("Job Worker " + std::to_string(index))
+
+    while (running_) {
+        if (RunOne(index)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCondition_.wait(lock, [this] { return !running_ || pendingJobs_.load() > 0; });
+    }
+}
+
+void ZJobSystem::Enqueue(ZJobEntry&& entry)
+{
+    // Jobs scheduled before the workers are up or after they have shut down are run inline
+    if (!running_) {
+        entry.function();
+        Complete(entry.counter);
+        return;
+    }
+
+    unsigned int index = currentJobSystem == this ? currentWorkerIndex : nextQueue_.fetch_add(1) % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->jobs.push_back(std::move(entry));
+    }
+    pendingJobs_.fetch_add(1);
+
+    // Shutdown may have drained the queues between the check above and the push
+    if (!running_) {
+        while (RunOne(static_cast<unsigned int>(queues_.size())));
+        return;
+    }
+
+    // Taking the sleep lock makes sure a worker or waiter that is about to sleep sees the new job count
+    { std::lock_guard<std::mutex> lock(sleepMutex_); }
+    sleepCondition_.notify_one();
+    waitCondition_.notify_one();
+}
+
+void ZJobSystem::Enqueue(ZJobEntry&& entry, const std::shared_ptr<ZJobCounter>& dependency)
+{
+    if (dependency) {
+        std::lock_guard<std::mutex> lock(dependency->mutex_);
+        if (dependency->count_.load(std::memory_order_acquire) > 0) {
+            dependency->continuations_.push_back(std::move(entry));
+            return;
+        }
+    }
+    Enqueue(std::move(entry));
+}
+
+bool ZJobSystem::Pop(unsigned int index, ZJobEntry& outEntry)
+{
+    if (index >= queues_.size()) return false;
+
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    if (queues_[index]->jobs.empty()) return false;
+
+    outEntry = std::move(queues_[index]->jobs.back());
+    queues_[index]->jobs.pop_back();
+    return true;
+}
+
+bool ZJobSystem::Steal(unsigned int index, ZJobEntry& outEntry)
+{
+    auto queueCount = queues_.size();
+    for (size_t i = 1; i <= queueCount; i++) {
+        auto& queue = queues_[(index + i) % queueCount];
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (queue->jobs.empty()) continue;
+
+        outEntry = std::move(queue->jobs.front());
+        queue->jobs.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool ZJobSystem::RunOne(unsigned int index)
+{
+    ZJobEntry entry;
+    if (!Pop(index, entry) && !Steal(index, entry)) return false;
+
+    pendingJobs_.fetch_sub(1);
+    {
+        ZPR_ZONE("Job")
+        entry.function();
+    }
+    Complete(entry.counter);
+    return true;
+}
+
+void ZJobSystem::Complete(const std::shared_ptr<ZJobCounter>& counter)
+{
+    if (!counter || counter->count_.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    // Waiters can be blocked on any counter, so all of them have to check whether theirs is the one that finished
+    { std::lock_guard<std::mutex> lock(sleepMutex_); }
+    waitCondition_.notify_all();
+
+    // The last job in the batch releases every job that was waiting on it
+    std::vector<ZJobEntry> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter->mutex_);
+        continuations.swap(counter->continuations_);
+    }
+    for (auto& continuation : continuations) {
+        Enqueue(std::move(continuation));
+    }
+}
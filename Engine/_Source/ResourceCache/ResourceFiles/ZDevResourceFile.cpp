@@ -29,6 +29,7 @@
 
 #include "ZDevResourceFile.hpp"
 #include "ZServices.hpp"
+#include "ZMappedFile.hpp"
 #include <cppfs/FileIterator.h>
 
 using namespace cppfs;
@@ -61,17 +62,15 @@ unsigned int ZDevResourceFile::RawResource(const ZResource& resource, char* buff
     if (it == assetIndices_.end())
         return 0;
 
-    std::unique_ptr<std::istream> in = assets_[it->second].createInputStream(std::ios_base::in | std::ios_base::binary);
-    std::stringstream stream;
-    stream << in->rdbuf();
-    std::string contents = stream.str();
-    const char* data = contents.data();
+    // Map the file and copy it once, straight into the cache's buffer
+    ZMappedFile file;
+    if (!file.Open(assets_[it->second].path()))
+        return 0;
 
-    // Cannot use c_str to copy because it will truncate on first \0 character
-    // which might appear multiple times in binary data
-    memcpy(buffer, data, contents.size());
+    if (file.Size() > 0)
+        memcpy(buffer, file.Data(), file.Size());
 
-    return assets_[it->second].size();
+    return (unsigned int) file.Size();
 }
 
 unsigned int ZDevResourceFile::ResourceCount() const
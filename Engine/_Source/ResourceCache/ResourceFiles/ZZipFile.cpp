@@ -30,6 +30,28 @@
 #include "ZZipFile.hpp"
 #include "ZServices.hpp"
 
+// Zip format constants, see section 4.3 of the PKWARE APPNOTE
+static const uint32_t cEndOfCentralDirSignature = 0x06054b50;
+static const uint32_t cCentralDirHeaderSignature = 0x02014b50;
+static const uint32_t cLocalHeaderSignature = 0x04034b50;
+static const size_t cEndOfCentralDirSize = 22;
+static const size_t cCentralDirHeaderSize = 46;
+static const size_t cLocalHeaderSize = 30;
+static const size_t cMaxArchiveCommentSize = 0xFFFF;
+
+static uint16_t ReadU16(const char* data)
+{
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t ReadU32(const char* data)
+{
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+        (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
 bool ZZipFile::Open()
 {
     zipFile_ = zip_open(fileName_.c_str(), ZIP_DEFAULT_COMPRESSION_LEVEL, 'r');
@@ -40,60 +62,64 @@ bool ZZipFile::Open()
         return false;
     }
 
+    // Index the central directory once so that lookups don't have to search the archive on every load.
+    // If the archive can't be mapped or uses features the index doesn't understand (i.e. ZIP64) we still
+    // build the index through the zip library, and every read goes through it instead of the mapping.
+    if (!archive_.Open(fileName_) || !IndexCentralDirectory())
+    {
+        archive_.Close();
+        IndexEntries();
+    }
+
     return true;
 }
 
 unsigned int ZZipFile::RawResourceSize(const ZResource& resource)
 {
-    zip_entry_open(zipFile_, resource.name.c_str());
-    unsigned int size = zip_entry_size(zipFile_);
-    zip_entry_close(zipFile_);
-    return size;
+    const ZZipEntry* entry = FindEntry(resource.name);
+    return entry ? (unsigned int) entry->size : 0;
 }
 
 unsigned int ZZipFile::RawResource(const ZResource& resource, char* buffer)
 {
-    if (zipFile_)
+    if (!zipFile_) return 0;
+
+    auto it = entryIndices_.find(NormalizedName(resource.name));
+    if (it == entryIndices_.end()) return 0;
+
+    const ZZipEntry& entry = entries_[it->second];
+
+    if (entry.stored)
     {
-        zip_entry_open(zipFile_, resource.name.c_str());
-        size_t bytes = zip_entry_size(zipFile_);
-        zip_entry_noallocread(zipFile_, (void*) buffer, bytes);
-        zip_entry_close(zipFile_);
-        return (unsigned int) bytes;
+        if (const char* data = StoredEntryData(entry))
+        {
+            memcpy(buffer, data, entry.size);
+            return (unsigned int) entry.size;
+        }
     }
-    return 0;
+
+    // Compressed entries are inflated by the zip library directly into the destination buffer
+    if (zip_entry_openbyindex(zipFile_, it->second) != 0) return 0;
+    ssize_t bytes = zip_entry_noallocread(zipFile_, (void*) buffer, entry.size);
+    zip_entry_close(zipFile_);
+    return bytes < 0 ? 0 : (unsigned int) bytes;
 }
 
 unsigned int ZZipFile::ResourceCount() const
 {
-    return zipFile_ ? zip_total_entries(zipFile_) : 0;
+    return (unsigned int) entries_.size();
 }
 
 std::string ZZipFile::ResourceName(unsigned int num) const
 {
-    zip_entry_openbyindex(zipFile_, num);
-    std::string name = std::string(zip_entry_name(zipFile_));
-    zip_entry_close(zipFile_);
-    return name;
+    return num < entries_.size() ? entries_[num].name : "";
 }
 
 void ZZipFile::PrintResources() const
 {
-    if (zipFile_)
+    for (const ZZipEntry& entry : entries_)
     {
-        int i, n = zip_total_entries(zipFile_);
-        for (i = 0; i < n; ++i)
-        {
-            zip_entry_openbyindex(zipFile_, i);
-            {
-                const char* name = zip_entry_name(zipFile_);
-    //            int isdir = zip_entry_isdir(zipFile_);
-    //            unsigned long long size = zip_entry_size(zipFile_);
-    //            unsigned int crc32 = zip_entry_crc32(zipFile_);
-                LOG(name, ZSeverity::Error);
-            }
-            zip_entry_close(zipFile_);
-        }
+        LOG(entry.name, ZSeverity::Error);
     }
 }
 
@@ -101,4 +127,139 @@ void ZZipFile::Close()
 {
     if (zipFile_) zip_close(zipFile_);
     zipFile_ = nullptr;
+    archive_.Close();
+    entries_.clear();
+    entryIndices_.clear();
+}
+
+bool ZZipFile::IndexCentralDirectory()
+{
+    const char* data = archive_.Data();
+    size_t size = archive_.Size();
+    if (!data || size < cEndOfCentralDirSize) return false;
+
+    // The end of central directory record sits at the end of the archive, followed only by an optional comment
+    const char* eocd = nullptr;
+    size_t searchEnd = size > cEndOfCentralDirSize + cMaxArchiveCommentSize ? size - cEndOfCentralDirSize - cMaxArchiveCommentSize : 0;
+    for (size_t offset = size - cEndOfCentralDirSize + 1; offset-- > searchEnd;)
+    {
+        if (ReadU32(data + offset) == cEndOfCentralDirSignature)
+        {
+            eocd = data + offset;
+            break;
+        }
+    }
+    if (!eocd) return false;
+
+    uint16_t totalEntries = ReadU16(eocd + 10);
+    uint32_t directorySize = ReadU32(eocd + 12);
+    uint32_t directoryOffset = ReadU32(eocd + 16);
+
+    // Saturated fields mean the real values live in a ZIP64 record
+    if (totalEntries == 0xFFFF || directorySize == 0xFFFFFFFF || directoryOffset == 0xFFFFFFFF) return false;
+    if ((size_t) directoryOffset + directorySize > size) return false;
+
+    std::vector<ZZipEntry> entries;
+    entries.reserve(totalEntries);
+
+    const char* header = data + directoryOffset;
+    const char* directoryEnd = header + directorySize;
+    for (uint16_t i = 0; i < totalEntries; ++i)
+    {
+        if (header + cCentralDirHeaderSize > directoryEnd || ReadU32(header) != cCentralDirHeaderSignature) return false;
+
+        uint16_t flags = ReadU16(header + 8);
+        uint16_t method = ReadU16(header + 10);
+        uint16_t nameLength = ReadU16(header + 28);
+        uint16_t extraLength = ReadU16(header + 30);
+        uint16_t commentLength = ReadU16(header + 32);
+        if (header + cCentralDirHeaderSize + nameLength > directoryEnd) return false;
+
+        ZZipEntry entry;
+        entry.name = std::string(header + cCentralDirHeaderSize, nameLength);
+        entry.compressedSize = ReadU32(header + 20);
+        entry.size = ReadU32(header + 24);
+        entry.headerOffset = ReadU32(header + 42);
+        // Encrypted entries need the library even if they aren't compressed
+        entry.stored = method == 0 && !(flags & 0x1);
+        if (entry.size == 0xFFFFFFFF || entry.compressedSize == 0xFFFFFFFF || entry.headerOffset == 0xFFFFFFFF) return false;
+
+        entries.push_back(std::move(entry));
+        header += cCentralDirHeaderSize + nameLength + extraLength + commentLength;
+    }
+
+    entries_ = std::move(entries);
+    entryIndices_.clear();
+    entryIndices_.reserve(entries_.size());
+    for (unsigned int i = 0; i < entries_.size(); ++i)
+    {
+        entryIndices_.emplace(NormalizedName(entries_[i].name), i);
+    }
+    return true;
+}
+
+void ZZipFile::IndexEntries()
+{
+    entries_.clear();
+    entryIndices_.clear();
+
+    ssize_t total = zip_total_entries(zipFile_);
+    if (total <= 0) return;
+
+    entries_.reserve(total);
+    entryIndices_.reserve(total);
+    for (ssize_t i = 0; i < total; ++i)
+    {
+        ZZipEntry entry;
+        if (zip_entry_openbyindex(zipFile_, i) == 0)
+        {
+            entry.name = zip_entry_name(zipFile_);
+            entry.size = zip_entry_size(zipFile_);
+            zip_entry_close(zipFile_);
+        }
+        entryIndices_.emplace(NormalizedName(entry.name), (unsigned int) entries_.size());
+        entries_.push_back(std::move(entry));
+    }
+}
+
+const ZZipEntry* ZZipFile::FindEntry(const std::string& name) const
+{
+    auto it = entryIndices_.find(NormalizedName(name));
+    return it != entryIndices_.end() ? &entries_[it->second] : nullptr;
+}
+
+const char* ZZipFile::StoredEntryData(const ZZipEntry& entry) const
+{
+    const char* data = archive_.Data();
+    size_t size = archive_.Size();
+    if (!data || entry.headerOffset + cLocalHeaderSize > size) return nullptr;
+
+    // The local header repeats the name and may carry a different extra field than the central directory,
+    // so the data offset has to be read from it
+    const char* local = data + entry.headerOffset;
+    if (ReadU32(local) != cLocalHeaderSignature) return nullptr;
+
+    size_t dataOffset = entry.headerOffset + cLocalHeaderSize + ReadU16(local + 26) + ReadU16(local + 28);
+    if (dataOffset + entry.size > size) return nullptr;
+
+    return data + dataOffset;
+}
+
+std::string ZZipFile::NormalizedName(const std::string& name)
+{
+    // Matches the zip library's lookups, which are case insensitive and ignore leading path separators
+    std::string normalized = name;
+    for (char& c : normalized)
+    {
+        c = c == '\\' ? '/' : (char) tolower((unsigned char) c);
+    }
+
+    size_t start = 0;
+    while (start < normalized.size())
+    {
+        if (normalized[start] == '/') ++start;
+        else if (normalized.compare(start, 2, "./") == 0) start += 2;
+        else break;
+    }
+    return normalized.substr(start);
 }
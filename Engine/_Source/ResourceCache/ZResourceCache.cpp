@@ -36,18 +36,22 @@ ZResourceCache::ZResourceCache(const unsigned int sizeInMb)
 {
     cacheSize_ = sizeInMb * 1024 * 1024;
     allocated_ = 0;
+    allocator_ = std::make_shared<ZSlabAllocator>();
 }
 
 ZResourceCache::~ZResourceCache()
 {
-    while (!lru_.empty()) FreeOneResource();
-    lru_.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutexes_.resources);
+        while (lruTail_) FreeOneResource();
+    }
 
     for (ResourceFileMap::iterator it = resourceFiles_.begin(); it != resourceFiles_.end(); it++)
     {
         it->second->Close();
     }
     resourceFiles_.clear();
+    resourceFileMutexes_.clear();
 }
 
 void ZResourceCache::Initialize()
@@ -71,6 +75,7 @@ void ZResourceCache::RegisterResourceFile(std::shared_ptr<ZResourceFile> file)
     if (file->Open())
     {
         resourceFiles_[file->Name()] = file;
+        resourceFileMutexes_[file->Name()] = std::make_shared<std::mutex>();
     }
     else
     {
@@ -80,10 +85,33 @@ void ZResourceCache::RegisterResourceFile(std::shared_ptr<ZResourceFile> file)
 
 std::shared_ptr<ZResourceHandle> ZResourceCache::GetHandle(ZResource* resource)
 {
-    std::lock_guard<std::mutex> lock(mutexes_.all);
-    std::shared_ptr<ZResourceHandle> handle(Find(resource));
-    if (!handle) handle = Load(resource);
-    else Update(handle);
+    {
+        std::lock_guard<std::mutex> lock(mutexes_.resources);
+        std::shared_ptr<ZResourceHandle> handle(Find(resource));
+        if (handle)
+        {
+            ++hits_;
+            Update(handle);
+            return handle;
+        }
+    }
+
+    // Load outside of the table lock so that slow reads don't hold up lookups from other threads
+    ++misses_;
+    std::shared_ptr<ZResourceHandle> handle = Load(resource);
+    if (!handle) return handle;
+
+    std::lock_guard<std::mutex> lock(mutexes_.resources);
+    if (std::shared_ptr<ZResourceHandle> existing = Find(resource))
+    {
+        // Another thread loaded the same resource in the meantime, so we keep theirs and drop ours
+        FreeMemory(handle->Size());
+        Update(existing);
+        return existing;
+    }
+
+    resources_[resource->name] = handle;
+    LinkFront(handle.get());
     return handle;
 }
 
@@ -102,41 +130,56 @@ int ZResourceCache::Preload(const std::string& pattern, void(*progressCallback)(
 
 void ZResourceCache::Flush()
 {
-    lru_.clear();
+    std::lock_guard<std::mutex> lock(mutexes_.resources);
+    while (lruTail_) FreeOneResource();
+}
+
+ZResourceCacheStats ZResourceCache::Stats()
+{
+    ZResourceCacheStats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    stats.capacity = cacheSize_;
+    {
+        std::lock_guard<std::mutex> lock(mutexes_.resources);
+        stats.resourceCount = resources_.size();
+        stats.allocated = allocated_;
+    }
+    stats.memory = allocator_->Stats();
+    return stats;
 }
 
 std::shared_ptr<ZResourceHandle> ZResourceCache::Find(ZResource* resource)
 {
-    if (resources_.find(resource->name) != resources_.end())
-        return resources_[resource->name];
+    auto it = resources_.find(resource->name);
+    if (it != resources_.end())
+        return it->second;
     return std::shared_ptr<ZResourceHandle>();
 }
 
-const void ZResourceCache::Update(std::shared_ptr<ZResourceHandle> handle)
+void ZResourceCache::Update(const std::shared_ptr<ZResourceHandle>& handle)
 {
-    ResourceHandleList::iterator it;
-    for (it = lru_.begin(); it != lru_.end(); it++)
-    {
-        if ((*it) == handle) break;
-    }
-    if (it == lru_.end()) return;
-
-    std::shared_ptr<ZResourceHandle> updatedHandle(*it);
-    lru_.erase(it);
-    lru_.push_front(updatedHandle);
+    if (lruHead_ == handle.get()) return;
+    Unlink(handle.get());
+    LinkFront(handle.get());
 }
 
 std::shared_ptr<ZResourceHandle> ZResourceCache::Load(ZResource* resource)
 {
+    ZPR_ZONE("Resource Load")
     std::shared_ptr<ZResourceLoader> loader;
     std::shared_ptr<ZResourceHandle> handle;
 
-    for (ResourceLoaderList::iterator it = resourceLoaders_.begin(); it != resourceLoaders_.end(); it++)
     {
-        std::shared_ptr<ZResourceLoader> testLoader = *it;
-        if (MatchPattern(testLoader->Pattern(), resource->name))
+        std::lock_guard<std::mutex> lock(mutexes_.resourceLoaders);
+        for (ResourceLoaderList::iterator it = resourceLoaders_.begin(); it != resourceLoaders_.end(); it++)
         {
-            loader = testLoader; break;
+            std::shared_ptr<ZResourceLoader> testLoader = *it;
+            if (MatchPattern(testLoader->Pattern(), resource->name))
+            {
+                loader = testLoader; break;
+            }
         }
     }
 
@@ -147,14 +190,23 @@ std::shared_ptr<ZResourceHandle> ZResourceCache::Load(ZResource* resource)
     }
 
     // Gets the first resource file in the resource files list that contains the
-    // given resource (indicated by return size greater than 0)
+    // given resource (indicated by return size greater than 0). The file list is only
+    // locked while searching, the read itself only locks the file it comes from.
     unsigned int rawSize = 1;
-    ResourceFileMap::iterator it;
-
-    for (it = resourceFiles_.begin(); it != resourceFiles_.end(); it++)
+    std::shared_ptr<ZResourceFile> resourceFile;
+    std::shared_ptr<std::mutex> resourceFileMutex;
     {
-        rawSize += it->second->RawResourceSize(*resource);
-        if (rawSize > 1) break;
+        std::lock_guard<std::mutex> filesLock(mutexes_.resourceFiles);
+        for (ResourceFileMap::iterator it = resourceFiles_.begin(); it != resourceFiles_.end(); it++)
+        {
+            rawSize += it->second->RawResourceSize(*resource);
+            if (rawSize > 1)
+            {
+                resourceFile = it->second;
+                resourceFileMutex = resourceFileMutexes_[it->first];
+                break;
+            }
+        }
     }
 
     char* rawBuffer = loader->UseRawFile() ? Allocate(rawSize) : new char[rawSize];
@@ -164,8 +216,11 @@ std::shared_ptr<ZResourceHandle> ZResourceCache::Load(ZResource* resource)
         return nullptr;
     }
 
-    if (it != resourceFiles_.end())
-        it->second->RawResource(*resource, rawBuffer);
+    if (resourceFile)
+    {
+        std::lock_guard<std::mutex> fileLock(*resourceFileMutex);
+        resourceFile->RawResource(*resource, rawBuffer);
+    }
 
     rawBuffer[rawSize - 1] = '\0';
 
@@ -175,27 +230,30 @@ std::shared_ptr<ZResourceHandle> ZResourceCache::Load(ZResource* resource)
     if (loader->UseRawFile())
     {
         buffer = rawBuffer;
-        handle = std::shared_ptr<ZResourceHandle>(new ZResourceHandle(*resource, (void*) buffer, rawSize, this));
+        handle = std::shared_ptr<ZResourceHandle>(new ZResourceHandle(*resource, (void*) buffer, rawSize, this, allocator_));
     }
     else
     {
         size = loader->LoadedResourceSize(rawBuffer, rawSize);
         buffer = Allocate(size);
 
-        if (rawBuffer == nullptr || buffer == nullptr) return nullptr;
+        if (buffer == nullptr)
+        {
+            delete[] rawBuffer;
+            return nullptr;
+        }
 
-        handle = std::shared_ptr<ZResourceHandle>(new ZResourceHandle(*resource, (void*) buffer, size, this));
+        handle = std::shared_ptr<ZResourceHandle>(new ZResourceHandle(*resource, (void*) buffer, size, this, allocator_));
         bool success = loader->LoadResource(rawBuffer, rawSize, handle);
 
         delete[] rawBuffer;
 
-        if (!success) return nullptr;
-    }
-
-    if (handle)
-    {
-        lru_.push_front(handle);
-        resources_[resource->name] = handle;
+        if (!success)
+        {
+            std::lock_guard<std::mutex> lock(mutexes_.resources);
+            FreeMemory(size);
+            return nullptr;
+        }
     }
 
     return handle;
@@ -203,8 +261,14 @@ std::shared_ptr<ZResourceHandle> ZResourceCache::Load(ZResource* resource)
 
 void ZResourceCache::Free(std::shared_ptr<ZResourceHandle> handle)
 {
-    lru_.remove(handle);
+    std::lock_guard<std::mutex> lock(mutexes_.resources);
+    auto it = resources_.find(handle->resource_.name);
+    if (it == resources_.end() || it->second != handle) return;
+
+    Unlink(handle.get());
     FreeMemory(handle->Size());
+    handle->resourceCache_ = nullptr;
+    resources_.erase(it);
 }
 
 bool ZResourceCache::MatchPattern(const std::string& pattern, const std::string& str)
@@ -213,13 +277,33 @@ bool ZResourceCache::MatchPattern(const std::string& pattern, const std::string&
     return std::regex_match(str, rx);
 }
 
+void ZResourceCache::LinkFront(ZResourceHandle* handle)
+{
+    handle->lruPrevious_ = nullptr;
+    handle->lruNext_ = lruHead_;
+    if (lruHead_) lruHead_->lruPrevious_ = handle;
+    lruHead_ = handle;
+    if (!lruTail_) lruTail_ = handle;
+}
+
+void ZResourceCache::Unlink(ZResourceHandle* handle)
+{
+    if (handle->lruPrevious_) handle->lruPrevious_->lruNext_ = handle->lruNext_;
+    else if (lruHead_ == handle) lruHead_ = handle->lruNext_;
+
+    if (handle->lruNext_) handle->lruNext_->lruPrevious_ = handle->lruPrevious_;
+    else if (lruTail_ == handle) lruTail_ = handle->lruPrevious_;
+
+    handle->lruPrevious_ = handle->lruNext_ = nullptr;
+}
+
 bool ZResourceCache::MakeRoom(unsigned int size)
 {
     if (size > cacheSize_) return false;
 
     while (size > cacheSize_ - allocated_)
     {
-        if (lru_.empty()) return false;
+        if (!lruTail_) return false;
         FreeOneResource();
     }
 
@@ -228,27 +312,27 @@ bool ZResourceCache::MakeRoom(unsigned int size)
 
 char* ZResourceCache::Allocate(unsigned int size)
 {
-    if (!MakeRoom(size)) return nullptr;
-
-    char* mem = new char[size];
-    if (mem) allocated_ += size;
+    {
+        std::lock_guard<std::mutex> lock(mutexes_.resources);
+        if (!MakeRoom(size)) return nullptr;
+        allocated_ += size;
+    }
 
-    return mem;
+    return allocator_->Allocate(size);
 }
 
 void ZResourceCache::FreeOneResource()
 {
-    ResourceHandleList::iterator removed = lru_.end();
-    removed--;
-
-    std::shared_ptr<ZResourceHandle> handle = *removed;
+    ZResourceHandle* removed = lruTail_;
+    Unlink(removed);
+    ++evictions_;
 
-    lru_.pop_back();
+    FreeMemory(removed->Size());
+    removed->resourceCache_ = nullptr;
 
-    resources_.erase(handle->resource_.name);
-
-    FreeMemory(handle->Size());
-    handle->resourceCache_ = nullptr;
+    // Erasing the table entry may release the last reference to the handle, so it has to come last
+    std::string name = removed->resource_.name;
+    resources_.erase(name);
 }
 
 void ZResourceCache::FreeMemory(unsigned int size)
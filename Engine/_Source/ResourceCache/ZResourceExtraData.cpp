@@ -29,9 +29,18 @@
 
 #include "ZResourceExtraData.hpp"
 #include "ZImageImporter.hpp"
+#include "ZOFBinaryTree.hpp"
 
 ZSoundResourceExtraData::ZSoundResourceExtraData() : soundType_(ZSoundType::Unknown), lengthMilli_(0) {}
 
+std::shared_ptr<ZOFTree> ZZOFResourceExtraData::ObjectTree()
+{
+    std::lock_guard<std::mutex> lock(treeMutex_);
+    if (!objectTree_ && binaryTree_)
+        objectTree_ = binaryTree_->ToTree();
+    return objectTree_;
+}
+
 ZShaderResourceExtraData::ZShaderResourceExtraData() : type_(ZShaderType::Other) {}
 
 ZTextureResourceExtraData::ZTextureResourceExtraData() : hdr_(false), flipped_(true), width_(0), height_(0), channels_(0) {}
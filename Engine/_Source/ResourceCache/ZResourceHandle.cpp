@@ -29,14 +29,19 @@
 
 #include "ZResourceHandle.hpp"
 #include "ZResourceCache.hpp"
+#include "ZSlabAllocator.hpp"
 
-ZResourceHandle::ZResourceHandle(ZResource& resource, void* buffer, unsigned int size, ZResourceCache* resourceCache) : resource_(resource), size_(size)
+ZResourceHandle::ZResourceHandle(ZResource& resource, void* buffer, unsigned int size, ZResourceCache* resourceCache, const std::shared_ptr<ZSlabAllocator>& allocator) : resource_(resource), size_(size)
 {
     buffer_ = buffer;
     resourceCache_ = resourceCache;
+    allocator_ = allocator;
 }
 
 ZResourceHandle::~ZResourceHandle()
 {
-    delete[](char*)buffer_;
+    if (allocator_)
+        allocator_->Free((char*)buffer_, size_);
+    else
+        delete[](char*)buffer_;
 }
@@ -32,6 +32,7 @@
 #include "ZResourceLoadedEvent.hpp"
 #include "ZResourceExtraData.hpp"
 #include "ZOFParser.hpp"
+#include "ZOFBinaryTree.hpp"
 #include "ZModelImporter.hpp"
 #include "ZImageImporter.hpp"
 
@@ -72,9 +73,25 @@ void ZResourceLoadTask::Run()
     {
         if (handle)
         {
-            ZOFParser parser;
             std::shared_ptr<ZZOFResourceExtraData> extraData = std::make_shared<ZZOFResourceExtraData>();
-            extraData->objectTree_ = parser.Parse(std::string((const char*)handle->Buffer()));
+            const char* buffer = (const char*)handle->Buffer();
+            // Compiled .zofb files are read straight out of the resource buffer, which the handle keeps alive
+            // for as long as its extra data. The object tree is only built if a consumer asks for it.
+            if (ZOFBinaryTree::IsBinary(buffer, handle->Size()))
+            {
+                extraData->binaryTree_ = std::make_shared<ZOFBinaryTree>();
+                if (!extraData->binaryTree_->Load(buffer, handle->Size()))
+                {
+                    LOG("Could not load compiled ZOF file " + resource_.name, ZSeverity::Error);
+                    handle = nullptr;
+                    break;
+                }
+            }
+            else
+            {
+                ZOFParser parser;
+                extraData->objectTree_ = parser.Parse(std::string(buffer));
+            }
             handle->SetExtra(extraData);
         }
         break;
@@ -0,0 +1,80 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZFrameAllocator.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZFrameAllocator.hpp"
+
+ZFrameAllocator::~ZFrameAllocator()
+{
+    Reset();
+}
+
+size_t ZFrameAllocator::Capacity() const
+{
+    size_t capacity = 0;
+    for (const auto& block : blocks_) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+void* ZFrameAllocator::Allocate(size_t size, size_t alignment)
+{
+    while (currentBlock_ < blocks_.size()) {
+        Block& block = blocks_[currentBlock_];
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.memory.get());
+        uintptr_t aligned = (base + offset_ + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        if (aligned + size <= base + block.size) {
+            offset_ = aligned + size - base;
+            allocated_ += size;
+            return reinterpret_cast<void*>(aligned);
+        }
+        ++currentBlock_;
+        offset_ = 0;
+    }
+
+    // Out of space, so add a new block that is large enough for the request. Oversized
+    // requests get a block of their own which is reused on later frames like any other.
+    size_t blockSize = std::max(blockSize_, size + alignment);
+    blocks_.push_back({ std::unique_ptr<char[]>(new char[blockSize]), blockSize });
+    currentBlock_ = blocks_.size() - 1;
+    offset_ = 0;
+    return Allocate(size, alignment);
+}
+
+void ZFrameAllocator::Reset()
+{
+    for (auto it = destructors_.rbegin(); it != destructors_.rend(); ++it) {
+        it->destroy(it->object);
+    }
+    destructors_.clear();
+    currentBlock_ = 0;
+    offset_ = 0;
+    allocated_ = 0;
+    ++generation_;
+}
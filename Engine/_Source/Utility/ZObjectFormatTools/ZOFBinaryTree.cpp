@@ -0,0 +1,274 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZOFBinaryTree.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZOFBinaryTree.hpp"
+#include "ZStringHelpers.hpp"
+#include "ZServices.hpp"
+
+bool ZOFBinaryTree::Load(const char* data, size_t size)
+{
+    header_ = nullptr;
+    if (!IsBinary(data, size))
+    {
+        LOG("[ZOFBinary Error]: Buffer is not a compiled ZOF file", ZSeverity::Error);
+        return false;
+    }
+
+    // The tables are read in place, so they need to be 4 byte aligned
+    if (reinterpret_cast<uintptr_t>(data) % alignof(uint32_t) != 0)
+    {
+        storage_.assign(data, data + size);
+        data = storage_.data();
+    }
+
+    data_ = data;
+    header_ = reinterpret_cast<const Header*>(data_);
+    if (header_->version != Version || header_->size > size)
+    {
+        LOG("[ZOFBinary Error]: Unsupported version or truncated buffer", ZSeverity::Error);
+        header_ = nullptr;
+        return false;
+    }
+
+    strings_ = reinterpret_cast<const StringEntry*>(data_ + header_->stringOffset);
+    characters_ = data_ + header_->characterOffset;
+    nodes_ = reinterpret_cast<const Node*>(data_ + header_->nodeOffset);
+    properties_ = reinterpret_cast<const Property*>(data_ + header_->propertyOffset);
+    values_ = reinterpret_cast<const Value*>(data_ + header_->valueOffset);
+    numbers_ = reinterpret_cast<const float*>(data_ + header_->numberOffset);
+    stringReferences_ = reinterpret_cast<const uint32_t*>(data_ + header_->stringReferenceOffset);
+
+    if (!Validate())
+    {
+        LOG("[ZOFBinary Error]: Compiled ZOF buffer is corrupt", ZSeverity::Error);
+        header_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool ZOFBinaryTree::Load(std::vector<char>&& data)
+{
+    storage_ = std::move(data);
+    return Load(storage_.data(), storage_.size());
+}
+
+std::string_view ZOFBinaryTree::String(uint32_t index) const
+{
+    const StringEntry& entry = strings_[index];
+    return std::string_view(characters_ + entry.offset, entry.length);
+}
+
+const ZOFBinaryTree::Property* ZOFBinaryTree::FindProperty(const Node& node, std::string_view key) const
+{
+    for (uint32_t i = 0; i < node.propertyCount; i++)
+    {
+        const Property& property = NodeProperty(node, i);
+        if (String(property.key) == key) return &property;
+    }
+    return nullptr;
+}
+
+std::string_view ZOFBinaryTree::StringValue(const Value& value, uint32_t index) const
+{
+    if (value.type == ValueType::StringList)
+        return String(stringReferences_[value.first + index]);
+    return String(value.first);
+}
+
+std::shared_ptr<ZOFTree> ZOFBinaryTree::ToTree() const
+{
+    std::shared_ptr<ZOFTree> tree = std::make_shared<ZOFTree>();
+    if (!Valid()) return tree;
+
+    // Every interned string is decoded at most once, no matter how many nodes share it
+    std::vector<std::string> strings(header_->stringCount);
+    std::vector<bool> decoded(header_->stringCount, false);
+    auto decode = [&](uint32_t index) -> const std::string& {
+        if (!decoded[index])
+        {
+            strings[index] = std::string(String(index));
+            decoded[index] = true;
+        }
+        return strings[index];
+    };
+
+    // Walk the flat node array breadth first, mirroring the layout the compiler wrote
+    std::vector<std::pair<const Node*, std::shared_ptr<ZOFNode>>> pending = { { &Root(), tree } };
+    for (size_t n = 0; n < pending.size(); n++)
+    {
+        const Node& node = *pending[n].first;
+        std::shared_ptr<ZOFNode> treeNode = pending[n].second;
+
+        if (auto objectNode = std::dynamic_pointer_cast<ZOFObjectNode>(treeNode))
+        {
+            for (uint32_t p = 0; p < node.propertyCount; p++)
+            {
+                const Property& property = NodeProperty(node, p);
+                std::shared_ptr<ZOFPropertyNode> propNode = std::make_shared<ZOFPropertyNode>();
+                propNode->id = decode(property.key);
+                propNode->root = objectNode->root;
+                propNode->values.reserve(property.valueCount);
+
+                for (uint32_t v = 0; v < property.valueCount; v++)
+                {
+                    const Value& value = PropertyValue(property, v);
+                    std::shared_ptr<ZOFAbstractTerminal> terminal;
+                    switch (value.type)
+                    {
+                    case ValueType::Number:
+                    {
+                        auto number = std::make_shared<ZOFNumber>();
+                        number->value = Number(value);
+                        terminal = number;
+                        break;
+                    }
+                    case ValueType::String:
+                    {
+                        // Globals are left unexpanded by the compiler so compiled files stay portable
+                        auto str = std::make_shared<ZOFString>();
+                        const std::string& s = decode(value.first);
+                        str->value = s.find('$') != std::string::npos ? zenith::strings::FormatStringGlobals(s) : s;
+                        terminal = str;
+                        break;
+                    }
+                    case ValueType::NumberList:
+                    {
+                        auto list = std::make_shared<ZOFNumberList>();
+                        list->value.assign(numbers_ + value.first, numbers_ + value.first + value.count);
+                        terminal = list;
+                        break;
+                    }
+                    case ValueType::StringList:
+                    {
+                        auto list = std::make_shared<ZOFStringList>();
+                        list->value.reserve(value.count);
+                        for (uint32_t s = 0; s < value.count; s++)
+                            list->value.push_back(decode(stringReferences_[value.first + s]));
+                        terminal = list;
+                        break;
+                    }
+                    }
+                    terminal->root = propNode->root;
+                    propNode->values.push_back(terminal);
+                }
+                objectNode->properties[propNode->id] = propNode;
+            }
+        }
+
+        for (uint32_t c = 0; c < node.childCount; c++)
+        {
+            const Node& child = Child(node, c);
+            std::shared_ptr<ZOFObjectNode> objectNode = std::make_shared<ZOFObjectNode>();
+            objectNode->id = decode(child.id);
+            objectNode->root = treeNode;
+            treeNode->children[objectNode->id] = objectNode;
+            pending.push_back({ &child, objectNode });
+        }
+    }
+
+    return tree;
+}
+
+bool ZOFBinaryTree::IsBinary(const char* data, size_t size)
+{
+    return data && size >= sizeof(Header) && std::memcmp(data, "ZOFB", 4) == 0;
+}
+
+bool ZOFBinaryTree::Validate() const
+{
+    const Header& h = *header_;
+    auto sectionFits = [&h](uint32_t offset, uint32_t count, size_t elementSize) {
+        return offset % alignof(uint32_t) == 0 && offset <= h.size && static_cast<uint64_t>(count) * elementSize <= h.size - offset;
+    };
+
+    if (!sectionFits(h.stringOffset, h.stringCount, sizeof(StringEntry)) ||
+        !sectionFits(h.nodeOffset, h.nodeCount, sizeof(Node)) ||
+        !sectionFits(h.propertyOffset, h.propertyCount, sizeof(Property)) ||
+        !sectionFits(h.valueOffset, h.valueCount, sizeof(Value)) ||
+        !sectionFits(h.numberOffset, h.numberCount, sizeof(float)) ||
+        !sectionFits(h.stringReferenceOffset, h.stringReferenceCount, sizeof(uint32_t)) ||
+        h.characterOffset > h.size || h.characterCount > h.size - h.characterOffset ||
+        h.nodeCount == 0)
+        return false;
+
+    for (uint32_t i = 0; i < h.stringCount; i++)
+        if (strings_[i].offset > h.characterCount || strings_[i].length > h.characterCount - strings_[i].offset) return false;
+
+    // Nodes are laid out breadth first, so child ranges must follow each other in node order and every node
+    // but the root must be claimed by exactly one parent before it is reached. This rules out cycles as well
+    // as shared children, which would otherwise make ToTree expand the same nodes over and over.
+    uint32_t nextChild = 1;
+    for (uint32_t i = 0; i < h.nodeCount; i++)
+    {
+        const Node& node = nodes_[i];
+        if (node.id >= h.stringCount) return false;
+        if (i > 0 && i >= nextChild) return false;
+        if (node.childCount > 0)
+        {
+            if (node.firstChild != nextChild || node.childCount > h.nodeCount - node.firstChild) return false;
+            nextChild += node.childCount;
+        }
+        if (node.firstProperty > h.propertyCount || node.propertyCount > h.propertyCount - node.firstProperty) return false;
+    }
+    if (nextChild != h.nodeCount) return false;
+
+    for (uint32_t i = 0; i < h.propertyCount; i++)
+    {
+        const Property& property = properties_[i];
+        if (property.key >= h.stringCount) return false;
+        if (property.firstValue > h.valueCount || property.valueCount > h.valueCount - property.firstValue) return false;
+    }
+
+    for (uint32_t i = 0; i < h.valueCount; i++)
+    {
+        const Value& value = values_[i];
+        switch (value.type)
+        {
+        case ValueType::Number:
+            if (value.first >= h.numberCount) return false;
+            break;
+        case ValueType::String:
+            if (value.first >= h.stringCount) return false;
+            break;
+        case ValueType::NumberList:
+            if (value.first > h.numberCount || value.count > h.numberCount - value.first) return false;
+            break;
+        case ValueType::StringList:
+            if (value.first > h.stringReferenceCount || value.count > h.stringReferenceCount - value.first) return false;
+            for (uint32_t s = 0; s < value.count; s++)
+                if (stringReferences_[value.first + s] >= h.stringCount) return false;
+            break;
+        default:
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,209 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZOFCompiler.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZOFCompiler.hpp"
+#include "ZOFParser.hpp"
+#include "ZServices.hpp"
+#include <fstream>
+
+std::vector<char> ZOFCompiler::Compile(const std::string& zofSource)
+{
+    ZOFParser parser(false);
+    return Compile(parser.Parse(zofSource));
+}
+
+std::vector<char> ZOFCompiler::Compile(const std::shared_ptr<ZOFTree>& tree)
+{
+    Reset();
+
+    // Lay the nodes out breadth first so that the children of every node end up next to each other
+    std::vector<ZOFNode*> pending = { tree.get() };
+    nodes_.push_back({ Intern(tree->id), 0, 0, 0, 0 });
+    for (size_t n = 0; n < pending.size(); n++)
+    {
+        ZOFNode* node = pending[n];
+
+        if (auto objectNode = dynamic_cast<ZOFObjectNode*>(node))
+        {
+            nodes_[n].firstProperty = static_cast<uint32_t>(properties_.size());
+            nodes_[n].propertyCount = static_cast<uint32_t>(objectNode->properties.size());
+            for (auto it = objectNode->properties.begin(); it != objectNode->properties.end(); it++)
+                AddProperty(it->second);
+        }
+
+        nodes_[n].firstChild = static_cast<uint32_t>(nodes_.size());
+        nodes_[n].childCount = static_cast<uint32_t>(node->children.size());
+        for (auto it = node->children.begin(); it != node->children.end(); it++)
+        {
+            nodes_.push_back({ Intern(it->second->id), 0, 0, 0, 0 });
+            pending.push_back(it->second.get());
+        }
+    }
+
+    // Write out the tables, each one 4 byte aligned so the loader can read them in place
+    std::vector<char> buffer(sizeof(ZOFBinaryTree::Header), 0);
+    auto appendSection = [&buffer](const void* data, size_t size) {
+        buffer.resize((buffer.size() + 3) & ~static_cast<size_t>(3), 0);
+        uint32_t offset = static_cast<uint32_t>(buffer.size());
+        if (size > 0) buffer.insert(buffer.end(), static_cast<const char*>(data), static_cast<const char*>(data) + size);
+        return offset;
+    };
+
+    ZOFBinaryTree::Header header;
+    std::memcpy(header.magic, "ZOFB", 4);
+    header.version = ZOFBinaryTree::Version;
+    header.stringCount = static_cast<uint32_t>(strings_.size());
+    header.stringOffset = appendSection(strings_.data(), strings_.size() * sizeof(ZOFBinaryTree::StringEntry));
+    header.nodeCount = static_cast<uint32_t>(nodes_.size());
+    header.nodeOffset = appendSection(nodes_.data(), nodes_.size() * sizeof(ZOFBinaryTree::Node));
+    header.propertyCount = static_cast<uint32_t>(properties_.size());
+    header.propertyOffset = appendSection(properties_.data(), properties_.size() * sizeof(ZOFBinaryTree::Property));
+    header.valueCount = static_cast<uint32_t>(values_.size());
+    header.valueOffset = appendSection(values_.data(), values_.size() * sizeof(ZOFBinaryTree::Value));
+    header.numberCount = static_cast<uint32_t>(numbers_.size());
+    header.numberOffset = appendSection(numbers_.data(), numbers_.size() * sizeof(float));
+    header.stringReferenceCount = static_cast<uint32_t>(stringReferences_.size());
+    header.stringReferenceOffset = appendSection(stringReferences_.data(), stringReferences_.size() * sizeof(uint32_t));
+    header.characterCount = static_cast<uint32_t>(characters_.size());
+    header.characterOffset = appendSection(characters_.data(), characters_.size());
+    header.size = static_cast<uint32_t>(buffer.size());
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    Reset();
+    return buffer;
+}
+
+bool ZOFCompiler::CompileFile(const std::string& sourcePath, const std::string& outputPath)
+{
+    std::ifstream source(sourcePath, std::ios::in | std::ios::binary);
+    if (!source)
+    {
+        LOG("Could not open ZOF file " + sourcePath, ZSeverity::Error);
+        return false;
+    }
+    std::stringstream contents;
+    contents << source.rdbuf();
+
+    std::vector<char> compiled = Compile(contents.str());
+    if (!Verify(contents.str(), compiled))
+    {
+        LOG("Compiled ZOF file " + outputPath + " does not match its source " + sourcePath, ZSeverity::Error);
+        return false;
+    }
+
+    std::ofstream output(outputPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output)
+    {
+        LOG("Could not write compiled ZOF file " + outputPath, ZSeverity::Error);
+        return false;
+    }
+    output.write(compiled.data(), compiled.size());
+    return static_cast<bool>(output);
+}
+
+bool ZOFCompiler::Verify(const std::string& zofSource, const std::vector<char>& compiled)
+{
+    ZOFBinaryTree binaryTree;
+    if (!binaryTree.Load(compiled.data(), compiled.size())) return false;
+
+    // Both trees expand string globals, and ToString walks children and properties in key order, so matching
+    // strings mean matching trees
+    ZOFParser parser;
+    std::shared_ptr<ZOFTree> sourceTree = parser.Parse(zofSource);
+    return sourceTree && sourceTree->ToString() == binaryTree.ToTree()->ToString();
+}
+
+void ZOFCompiler::Reset()
+{
+    internedStrings_.clear();
+    strings_.clear();
+    characters_.clear();
+    nodes_.clear();
+    properties_.clear();
+    values_.clear();
+    numbers_.clear();
+    stringReferences_.clear();
+}
+
+uint32_t ZOFCompiler::Intern(const std::string& str)
+{
+    auto it = internedStrings_.find(str);
+    if (it != internedStrings_.end()) return it->second;
+
+    uint32_t index = static_cast<uint32_t>(strings_.size());
+    strings_.push_back({ static_cast<uint32_t>(characters_.size()), static_cast<uint32_t>(str.size()) });
+    characters_ += str;
+    characters_ += '\0';
+    internedStrings_[str] = index;
+    return index;
+}
+
+void ZOFCompiler::AddProperty(const std::shared_ptr<ZOFPropertyNode>& property)
+{
+    ZOFBinaryTree::Property binaryProperty;
+    binaryProperty.key = Intern(property->id);
+    binaryProperty.firstValue = static_cast<uint32_t>(values_.size());
+    binaryProperty.valueCount = 0;
+
+    for (const auto& terminal : property->values)
+    {
+        ZOFBinaryTree::Value value{ ZOFBinaryTree::ValueType::Number, 0, 1 };
+        if (auto number = std::dynamic_pointer_cast<ZOFNumber>(terminal))
+        {
+            value.first = static_cast<uint32_t>(numbers_.size());
+            numbers_.push_back(number->value);
+        }
+        else if (auto str = std::dynamic_pointer_cast<ZOFString>(terminal))
+        {
+            value.type = ZOFBinaryTree::ValueType::String;
+            value.first = Intern(str->value);
+        }
+        else if (auto numberList = std::dynamic_pointer_cast<ZOFNumberList>(terminal))
+        {
+            value.type = ZOFBinaryTree::ValueType::NumberList;
+            value.first = static_cast<uint32_t>(numbers_.size());
+            value.count = static_cast<uint32_t>(numberList->value.size());
+            numbers_.insert(numbers_.end(), numberList->value.begin(), numberList->value.end());
+        }
+        else if (auto stringList = std::dynamic_pointer_cast<ZOFStringList>(terminal))
+        {
+            value.type = ZOFBinaryTree::ValueType::StringList;
+            value.first = static_cast<uint32_t>(stringReferences_.size());
+            value.count = static_cast<uint32_t>(stringList->value.size());
+            for (const auto& s : stringList->value)
+                stringReferences_.push_back(Intern(s));
+        }
+        else continue;
+
+        values_.push_back(value);
+        ++binaryProperty.valueCount;
+    }
+
+    properties_.push_back(binaryProperty);
+}
@@ -0,0 +1,129 @@
+/*
+
+     ______     ______     __   __     __     ______   __  __
+    /\___  \   /\  ___\   /\ "-.\ \   /\ \   /\__  _\ /\ \_\ \
+    \/_/  /__  \ \  __\   \ \ \-.  \  \ \ \  \/_/\ \/ \ \  __ \
+        /\_____\  \ \_____\  \ \_\" \_\  \ \_\    \ \_\  \ \_\ \_\
+        \/_____/   \/_____/   \/_/ \/_/   \/_/     \/_/   \/_/\/_/
+
+        ZSlabAllocator.cpp
+
+        Created by Adrian Sanchez on 10/18/2026.
+        Copyright © 2019 Pervasive Sense. All rights reserved.
+
+    This file is part of Zenith.
+
+    Zenith is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Zenith is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Zenith.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ZSlabAllocator.hpp"
+
+ZSlabAllocator::ZSlabAllocator(size_t slabSize)
+{
+    slabSize_ = std::max(slabSize, static_cast<size_t>(1) << maxBlockShift_);
+    for (size_t i = 0; i < sizeClassCount_; i++) {
+        sizeClasses_[i].blockSize = static_cast<size_t>(1) << (minBlockShift_ + i);
+    }
+}
+
+ZSlabAllocator::~ZSlabAllocator()
+{
+    for (auto& sizeClass : sizeClasses_) {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        sizeClass.freeBlocks.clear();
+        sizeClass.slabs.clear();
+    }
+}
+
+char* ZSlabAllocator::Allocate(size_t size)
+{
+    int index = SizeClassIndex(size);
+    if (index < 0) {
+        largeBytes_ += size;
+        ++largeCount_;
+        return new char[size];
+    }
+
+    SizeClass& sizeClass = sizeClasses_[index];
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    if (sizeClass.freeBlocks.empty()) {
+        // Carve a new slab into blocks. Blocks are pushed in reverse so that they are handed out in address order.
+        char* slab = new char[slabSize_];
+        sizeClass.slabs.emplace_back(slab);
+        size_t blockCount = slabSize_ / sizeClass.blockSize;
+        for (size_t i = blockCount; i > 0; i--) {
+            sizeClass.freeBlocks.push_back(slab + (i - 1) * sizeClass.blockSize);
+        }
+    }
+
+    char* block = sizeClass.freeBlocks.back();
+    sizeClass.freeBlocks.pop_back();
+    ++sizeClass.usedBlocks;
+    sizeClass.requestedBytes += size;
+    return block;
+}
+
+void ZSlabAllocator::Free(char* memory, size_t size)
+{
+    if (!memory) return;
+
+    int index = SizeClassIndex(size);
+    if (index < 0) {
+        largeBytes_ -= size;
+        --largeCount_;
+        delete[] memory;
+        return;
+    }
+
+    SizeClass& sizeClass = sizeClasses_[index];
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    sizeClass.freeBlocks.push_back(memory);
+    --sizeClass.usedBlocks;
+    sizeClass.requestedBytes -= size;
+
+    // Hand extra slabs back to the heap once a size class is completely idle, but keep the first one and its
+    // blocks around so that a class that is cycled through repeatedly doesn't reallocate it every time
+    if (sizeClass.usedBlocks == 0 && sizeClass.slabs.size() > 1) {
+        char* kept = sizeClass.slabs.front().get();
+        sizeClass.slabs.resize(1);
+        sizeClass.freeBlocks.erase(std::remove_if(sizeClass.freeBlocks.begin(), sizeClass.freeBlocks.end(),
+            [kept, this](char* block) { return block < kept || block >= kept + slabSize_; }), sizeClass.freeBlocks.end());
+    }
+}
+
+ZSlabAllocatorStats ZSlabAllocator::Stats() const
+{
+    ZSlabAllocatorStats stats;
+    for (const auto& sizeClass : sizeClasses_) {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        stats.requestedBytes += sizeClass.requestedBytes;
+        stats.blockBytes += sizeClass.usedBlocks * sizeClass.blockSize;
+        stats.slabBytes += sizeClass.slabs.size() * slabSize_;
+        stats.allocations += sizeClass.usedBlocks;
+    }
+    stats.largeBytes = largeBytes_;
+    stats.requestedBytes += stats.largeBytes;
+    stats.blockBytes += stats.largeBytes;
+    stats.allocations += largeCount_;
+    return stats;
+}
+
+int ZSlabAllocator::SizeClassIndex(size_t size) const
+{
+    if (size > (static_cast<size_t>(1) << maxBlockShift_)) return -1;
+
+    size_t shift = minBlockShift_;
+    while ((static_cast<size_t>(1) << shift) < size) ++shift;
+    return static_cast<int>(shift - minBlockShift_);
+}
@@ -0,0 +1,96 @@
+#include "ZServices.hpp"
+#include "ZBVH.hpp"
+#include <random>
+
+// Compares the recursive and parallel BVH builds on random scenes of increasing size. Both trees are queried
+// with the same rays, and the benchmark fails if they disagree on what was hit.
+int main(int argc, const char* argv[]) {
+    ZServices::Provide(std::make_shared<ZJobSystem>());
+
+    int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 5;
+
+    for (int primitiveCount : { 10000, 100000, 1000000 }) {
+        std::mt19937 rng(primitiveCount);
+        std::uniform_real_distribution<float> position(-1000.f, 1000.f), extent(0.1f, 3.f);
+
+        std::vector<ZBVHPrimitive> primitives;
+        primitives.reserve(primitiveCount);
+        for (int i = 0; i < primitiveCount; ++i) {
+            glm::vec3 center(position(rng), position(rng), position(rng));
+            primitives.emplace_back("Object" + std::to_string(i), ZAABBox(center - extent(rng), center + extent(rng)));
+        }
+
+        std::vector<ZRay> rays;
+        for (int i = 0; i < 4096; ++i) {
+            rays.emplace_back(glm::vec3(position(rng), position(rng), -2000.f), glm::vec3(0.f, 0.f, 1.f));
+        }
+
+        // Axis aligned rays that start exactly on a face plane of a primitive. The packet query has to agree
+        // with the single ray query on these, where a zero direction component meets a zero slab distance.
+        std::vector<ZRay> axisRays;
+        std::uniform_int_distribution<int> pick(0, primitiveCount - 1), axis(0, 2);
+        for (int i = 0; i < 4096; i += 4) {
+            int a = axis(rng), b = (a + 1) % 3;
+            glm::vec3 direction(0.f);
+            direction[a] = (i / 4) % 2 ? 1.f : -1.f;
+            for (int j = 0; j < 4; ++j) {
+                const ZAABBox& bounds = primitives[pick(rng)].bounds;
+                glm::vec3 origin = 0.5f * (bounds.minimum + bounds.maximum);
+                origin[b] = (j & 1) ? bounds.maximum[b] : bounds.minimum[b];
+                origin[a] = -2000.f * direction[a];
+                axisRays.emplace_back(origin, direction);
+            }
+        }
+
+        std::vector<ZBVHHit> hits[2];
+        double buildTimes[2];
+        float costs[2];
+        ZBVHBuildMode modes[2] = { ZBVHBuildMode::Recursive, ZBVHBuildMode::Parallel };
+        for (int m = 0; m < 2; ++m) {
+            ZBVH bvh(4, ZBVHSplitMethod::SAH, modes[m]);
+            bvh.SetRefitEnabled(false);
+
+            // The first build warms up the arena and the job system and isn't timed
+            double total = 0.0;
+            for (int i = 0; i <= iterations; ++i) {
+                for (const auto& primitive : primitives) bvh.AddPrimitive(primitive);
+                auto start = std::chrono::high_resolution_clock::now();
+                bvh.Build();
+                auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+                if (i > 0) total += elapsed;
+            }
+            buildTimes[m] = total / iterations;
+            costs[m] = bvh.Cost();
+
+            std::vector<ZBVHHit> axisHits;
+            bvh.IntersectMany(axisRays, axisHits);
+            for (size_t i = 0; i < axisRays.size(); ++i) {
+                ZBVHHit single;
+                bvh.Intersect(axisRays[i], single);
+                if (single.distance != axisHits[i].distance) {
+                    std::cout << "Packet and single ray queries disagree for axis aligned ray " << i << std::endl;
+                    return 1;
+                }
+            }
+
+            bvh.IntersectMany(rays, hits[m]);
+            for (auto& hit : hits[m]) {
+                if (hit.primitive >= 0) hit.primitive = std::stoi(bvh.PrimitiveID(hit.primitive).substr(6));
+            }
+        }
+
+        for (size_t i = 0; i < rays.size(); ++i) {
+            if (hits[0][i].primitive != hits[1][i].primitive) {
+                std::cout << "Parallel build disagrees with the recursive build for ray " << i << std::endl;
+                return 1;
+            }
+        }
+
+        std::cout << primitiveCount << " primitives: recursive " << buildTimes[0] << " ms, parallel " << buildTimes[1]
+            << " ms (" << buildTimes[0] / buildTimes[1] << "x, " << ZServices::JobSystem()->ThreadCount() << " workers), SAH cost recursive "
+            << costs[0] << ", parallel " << costs[1] << std::endl;
+    }
+
+    ZServices::JobSystem()->CleanUp();
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include "ZServices.hpp"
+#include "ZLightGrid.hpp"
+#include <random>
+
+// Distance from a point to a planar convex quad with corners in winding order
+static float QuadDistance(const glm::vec3& point, const glm::vec3 (&quad)[4]) {
+    glm::vec3 normal = glm::normalize(glm::cross(quad[1] - quad[0], quad[3] - quad[0]));
+    float planeDistance = glm::dot(point - quad[0], normal);
+    glm::vec3 projected = point - planeDistance * normal;
+
+    bool inside = true;
+    float edgeDistance = std::numeric_limits<float>::max();
+    for (int i = 0; i < 4; ++i) {
+        glm::vec3 a = quad[i], b = quad[(i + 1) % 4];
+        if (glm::dot(glm::cross(b - a, projected - a), normal) < 0.f) inside = false;
+        float t = glm::clamp(glm::dot(point - a, b - a) / glm::dot(b - a, b - a), 0.f, 1.f);
+        edgeDistance = glm::min(edgeDistance, glm::length(point - (a + t * (b - a))));
+    }
+    return inside ? glm::abs(planeDistance) : edgeDistance;
+}
+
+// Distance from a view space point to the froxel spanning the given NDC rectangle between two view depths
+static float ClusterDistance(const glm::vec3& point, const glm::mat4& projection, const glm::vec2& ndcMin, const glm::vec2& ndcMax, float nearDepth, float farDepth) {
+    float depth = -point.z;
+    if (depth >= nearDepth && depth <= farDepth) {
+        glm::vec2 ndc = glm::vec2(point.x * projection[0][0], point.y * projection[1][1]) / depth;
+        if (glm::all(glm::greaterThanEqual(ndc, ndcMin)) && glm::all(glm::lessThanEqual(ndc, ndcMax))) return 0.f;
+    }
+
+    glm::vec3 corners[8];
+    for (int i = 0; i < 8; ++i) {
+        float d = (i & 4) ? farDepth : nearDepth;
+        glm::vec2 ndc((i & 1) ? ndcMax.x : ndcMin.x, (i & 2) ? ndcMax.y : ndcMin.y);
+        corners[i] = glm::vec3(ndc.x * d / projection[0][0], ndc.y * d / projection[1][1], -d);
+    }
+
+    const int faces[6][4] = { { 0, 1, 3, 2 }, { 4, 6, 7, 5 }, { 0, 4, 5, 1 }, { 2, 3, 7, 6 }, { 0, 2, 6, 4 }, { 1, 5, 7, 3 } };
+    float distance = std::numeric_limits<float>::max();
+    for (const auto& face : faces) {
+        const glm::vec3 quad[4] = { corners[face[0]], corners[face[1]], corners[face[2]], corners[face[3]] };
+        distance = glm::min(distance, QuadDistance(point, quad));
+    }
+    return distance;
+}
+
+// Times the CPU side of the clustered light assignment and checks it against a brute force test of every light's
+// bounding sphere against every froxel. The benchmark fails if a froxel the sphere reaches is missing the light.
+int main(int argc, const char* argv[]) {
+    int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20;
+    int lightCount = argc > 2 ? std::max(1, std::atoi(argv[2])) : 500;
+
+    const float near = 0.1f, far = 1000.f;
+    glm::mat4 projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, near, far);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.f, 20.f, 50.f), glm::vec3(0.f, 0.f, -150.f), glm::vec3(0.f, 1.f, 0.f));
+
+    std::mt19937 rng(lightCount);
+    std::uniform_real_distribution<float> x(-200.f, 200.f), y(-50.f, 80.f), z(-450.f, 60.f), radius(2.f, 40.f);
+
+    std::vector<Light> lights(lightCount);
+    for (auto& light : lights) {
+        light.lightType = static_cast<unsigned int>(ZLightType::Point);
+        light.position = glm::vec4(x(rng), y(rng), z(rng), 1.f);
+        // Quadratic falloff that drops below the visible threshold at roughly the sampled radius
+        float r = radius(rng);
+        light.constantAttenuation = 1.f;
+        light.quadraticAttenuation = 256.f * light.color.r / (r * r);
+    }
+
+    ZLightGrid grid;
+    double total = 0.0;
+    for (int i = 0; i <= iterations; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        grid.Cluster(view, projection, near, far, lights);
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        if (i > 0) total += elapsed;
+    }
+
+    const std::vector<Light>& gridLights = grid.Lights();
+    const std::vector<glm::uvec2>& clusters = grid.Clusters();
+    const std::vector<uint32_t>& indices = grid.Indices();
+
+    size_t missing = 0, extra = 0, required = 0;
+    std::vector<char> assigned(gridLights.size());
+    for (unsigned int s = 0; s < ZLightGrid::slices; ++s) {
+        float nearDepth = near * glm::pow(far / near, static_cast<float>(s) / ZLightGrid::slices);
+        float farDepth = near * glm::pow(far / near, static_cast<float>(s + 1) / ZLightGrid::slices);
+        for (unsigned int ty = 0; ty < ZLightGrid::tilesY; ++ty) {
+            for (unsigned int tx = 0; tx < ZLightGrid::tilesX; ++tx) {
+                glm::vec2 ndcMin(-1.f + 2.f * tx / ZLightGrid::tilesX, -1.f + 2.f * ty / ZLightGrid::tilesY);
+                glm::vec2 ndcMax(-1.f + 2.f * (tx + 1) / ZLightGrid::tilesX, -1.f + 2.f * (ty + 1) / ZLightGrid::tilesY);
+                const glm::uvec2& cluster = clusters[tx + ZLightGrid::tilesX * (ty + ZLightGrid::tilesY * s)];
+
+                std::fill(assigned.begin(), assigned.end(), 0);
+                for (uint32_t i = cluster.x; i < cluster.x + cluster.y; ++i) assigned[indices[i]] = 1;
+
+                for (size_t l = 0; l < gridLights.size(); ++l) {
+                    float range = ZLightGrid::Range(gridLights[l]);
+                    float distance = ClusterDistance(glm::vec3(view * gridLights[l].position), projection, ndcMin, ndcMax, nearDepth, farDepth);
+                    // Spheres that only graze a froxel within float precision may go either way
+                    bool reaches = distance < range * 0.999f;
+                    required += reaches;
+                    if (reaches && !assigned[l]) {
+                        if (++missing <= 10) {
+                            std::cout << "Light " << l << " reaches cluster (" << tx << ", " << ty << ", " << s << ") but was not assigned to it" << std::endl;
+                        }
+                    }
+                    else if (!reaches && assigned[l] && distance > range * 1.001f) ++extra;
+                }
+            }
+        }
+    }
+
+    std::cout << gridLights.size() << " lights: " << total / iterations << " ms per build, " << indices.size() << " assignments for "
+        << required << " touched clusters (" << (required ? static_cast<double>(extra) / required : 0.0) * 100.0 << "% conservative overlap)" << std::endl;
+
+    if (missing > 0) {
+        std::cout << missing << " cluster assignments missing" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "ZServices.hpp"
+#include "ZOFCompiler.hpp"
+#include "ZOFParser.hpp"
+#include <fstream>
+#include <sstream>
+
+static bool ReadFile(const std::string& path, std::string& outContents) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file) return false;
+    std::stringstream contents;
+    contents << file.rdbuf();
+    outContents = contents.str();
+    return true;
+}
+
+// Compiles each text ZOF file to binary, reads the binary back from disk and checks that it loads into the same tree
+// the text parser produces. Truncated copies of the binary, and copies where two nodes share a child range, have to
+// be rejected by the loader. Runs over the engine and editor assets when no files are given.
+int main(int argc, const char* argv[]) {
+    std::vector<std::string> sources;
+    for (int i = 1; i < argc; ++i) sources.emplace_back(argv[i]);
+    if (sources.empty()) {
+        sources = {
+            ENGINE_ROOT "/_Assets/demo_scene.zof",
+            ENGINE_ROOT "/_Editor/_Assets/conf.zof",
+            ENGINE_ROOT "/_Editor/_Assets/object_templates.zof"
+        };
+    }
+
+    int failures = 0;
+    for (const auto& source : sources) {
+        std::string text, binary;
+        std::string compiledPath = source.substr(source.find_last_of("/\\") + 1) + "b";
+
+        ZOFCompiler compiler;
+        if (!ReadFile(source, text) || !compiler.CompileFile(source, compiledPath) || !ReadFile(compiledPath, binary)) {
+            std::cout << "FAIL " << source << ": could not compile" << std::endl;
+            ++failures;
+            continue;
+        }
+
+        std::shared_ptr<ZOFTree> textTree = ZOFParser().Parse(text);
+        ZOFBinaryTree binaryTree;
+        if (!textTree || !binaryTree.Load(binary.data(), binary.size())) {
+            std::cout << "FAIL " << source << ": could not load" << std::endl;
+            ++failures;
+            continue;
+        }
+
+        if (textTree->ToString() != binaryTree.ToTree()->ToString()) {
+            std::cout << "FAIL " << source << ": binary tree differs from the text tree" << std::endl;
+            ++failures;
+            continue;
+        }
+
+        ZOFBinaryTree truncatedTree;
+        if (truncatedTree.Load(binary.data(), binary.size() / 2)) {
+            std::cout << "FAIL " << source << ": truncated binary was accepted" << std::endl;
+            ++failures;
+            continue;
+        }
+
+        // Pointing the last node back at the root's children makes two parents share a child range
+        std::string sharedChildren = binary;
+        auto header = reinterpret_cast<ZOFBinaryTree::Header*>(sharedChildren.data());
+        auto nodes = reinterpret_cast<ZOFBinaryTree::Node*>(sharedChildren.data() + header->nodeOffset);
+        if (header->nodeCount > 1 && nodes[0].childCount > 0) {
+            nodes[header->nodeCount - 1].firstChild = nodes[0].firstChild;
+            nodes[header->nodeCount - 1].childCount = nodes[0].childCount;
+            ZOFBinaryTree sharedTree;
+            if (sharedTree.Load(sharedChildren.data(), sharedChildren.size())) {
+                std::cout << "FAIL " << source << ": binary with shared children was accepted" << std::endl;
+                ++failures;
+                continue;
+            }
+        }
+
+        std::cout << "OK   " << source << " (" << text.size() << " bytes text, " << binary.size() << " bytes binary)" << std::endl;
+    }
+
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,23 @@
+#include "ZServices.hpp"
+#include "ZOFCompiler.hpp"
+
+// Compiles a text ZOF file into the binary .zofb format, e.g. zofc _Assets/demo_scene.zof _Assets/demo_scene.zofb.
+// Every compiled file is loaded back and checked against the text parser's tree before it is written.
+int main(int argc, const char* argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: zofc <input.zof> [output.zofb]" << std::endl;
+        return 1;
+    }
+
+    std::string input(argv[1]);
+    std::string output = argc > 2 ? std::string(argv[2]) : input + "b";
+
+    ZOFCompiler compiler;
+    if (!compiler.CompileFile(input, output)) {
+        std::cout << "Failed to compile " << input << std::endl;
+        return 1;
+    }
+
+    std::cout << "Compiled " << input << " to " << output << std::endl;
+    return 0;
+}